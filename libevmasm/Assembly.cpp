@@ -713,31 +713,36 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 	}
 
 	std::map<u256, u256> tagReplacements;
+	auto const itemCount = [&]() { return m_items.size(); };
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
 		count = 0;
 
 		if (_settings.runInliner)
-			Inliner{
-				m_items,
-				_tagsReferencedFromOutside,
-				_settings.expectedExecutionsPerDeployment,
-				isCreation(),
-				_settings.evmVersion
-			}.optimise();
+			util::profileStep(_settings.profile, "Inliner", itemCount, [&]() {
+				Inliner{
+					m_items,
+					_tagsReferencedFromOutside,
+					_settings.expectedExecutionsPerDeployment,
+					isCreation(),
+					_settings.evmVersion
+				}.optimise();
+			});
 
 		if (_settings.runJumpdestRemover)
 		{
 			JumpdestRemover jumpdestOpt{m_items};
-			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
+			if (util::profileStep(_settings.profile, "JumpdestRemover", itemCount, [&]() {
+				return jumpdestOpt.optimise(_tagsReferencedFromOutside);
+			}))
 				count++;
 		}
 
 		if (_settings.runPeephole)
 		{
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
+			while (util::profileStep(_settings.profile, "PeepholeOptimiser", itemCount, [&]() { return peepOpt.optimise(); }))
 			{
 				count++;
 				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
@@ -748,7 +753,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		if (_settings.runDeduplicate)
 		{
 			BlockDeduplicator deduplicator{m_items};
-			if (deduplicator.deduplicate())
+			if (util::profileStep(_settings.profile, "BlockDeduplicator", itemCount, [&]() { return deduplicator.deduplicate(); }))
 			{
 				for (auto const& replacement: deduplicator.replacedTags())
 				{
@@ -771,64 +776,66 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		}
 
 		if (_settings.runCSE)
-		{
-			// Control flow graph optimization has been here before but is disabled because it
-			// assumes we only jump to tags that are pushed. This is not the case anymore with
-			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
-			bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
-				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
-			});
-
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
-			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
+			util::profileStep(_settings.profile, "CommonSubexpressionEliminator", itemCount, [&]() {
+				// Control flow graph optimization has been here before but is disabled because it
+				// assumes we only jump to tags that are pushed. This is not the case anymore with
+				// function types that can be stored in storage.
+				AssemblyItems optimisedItems;
+
+				bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
+					return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
+				});
+
+				auto iter = m_items.begin();
+				while (iter != m_items.end())
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					KnownState emptyState;
+					CommonSubexpressionEliminator eliminator{emptyState};
+					auto orig = iter;
+					iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
+					bool shouldReplace = false;
+					AssemblyItems optimisedChunk;
+					try
+					{
+						optimisedChunk = eliminator.getOptimizedItems();
+						shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
+					}
+					catch (StackTooDeepException const&)
+					{
+						// This might happen if the opcode reconstruction is not as efficient
+						// as the hand-crafted code.
+					}
+					catch (ItemNotAvailableException const&)
+					{
+						// This might happen if e.g. associativity and commutativity rules
+						// reorganise the expression tree, but not all leaves are available.
+					}
+
+					if (shouldReplace)
+					{
+						count++;
+						optimisedItems += optimisedChunk;
+					}
+					else
+						copy(orig, iter, back_inserter(optimisedItems));
 				}
-
-				if (shouldReplace)
+				if (optimisedItems.size() < m_items.size())
 				{
+					m_items = std::move(optimisedItems);
 					count++;
-					optimisedItems += optimisedChunk;
 				}
-				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
-			if (optimisedItems.size() < m_items.size())
-			{
-				m_items = std::move(optimisedItems);
-				count++;
-			}
-		}
+			});
 	}
 
 	if (_settings.runConstantOptimiser)
-		ConstantOptimisationMethod::optimiseConstants(
-			isCreation(),
-			isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
-			_settings.evmVersion,
-			*this
-		);
+		util::profileStep(_settings.profile, "ConstantOptimiser", itemCount, [&]() {
+			ConstantOptimisationMethod::optimiseConstants(
+				isCreation(),
+				isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
+				_settings.evmVersion,
+				*this
+			);
+		});
 
 	m_tagReplacements = std::move(tagReplacements);
 	return *m_tagReplacements;
@@ -960,7 +967,7 @@ LinkerObject const& Assembly::assemble() const
 		{
 			assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
 			auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
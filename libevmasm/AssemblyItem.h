@@ -29,6 +29,8 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <iostream>
 #include <sstream>
@@ -79,12 +81,12 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}},
+		m_verbatimBytecode{std::make_shared<VerbatimBytecodeData const>(_arguments, _returnVariables, std::move(_verbatimData))},
 		m_debugData{langutil::DebugData::create()}
 	{}
 
@@ -105,8 +107,25 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_smallData = 0;
+			m_largeData = std::make_shared<u256 const>(_data);
+		}
+	}
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -130,8 +149,10 @@ public:
 			return instruction() == _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+		else if (!m_largeData || !_other.m_largeData)
+			return !m_largeData && !_other.m_largeData && m_smallData == _other.m_smallData;
 		else
-			return data() == _other.data();
+			return *m_largeData == *_other.m_largeData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -143,8 +164,11 @@ public:
 			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
+		// Values that do not fit into the inline data are larger than all those that do.
+		else if (!m_largeData || !_other.m_largeData)
+			return !m_largeData && (_other.m_largeData || m_smallData < _other.m_smallData);
 		else
-			return data() < _other.data();
+			return *m_largeData < *_other.m_largeData;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -201,8 +225,8 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const { m_pushedValue = _value; }
+	std::optional<size_t> pushedValue() const { return m_pushedValue; }
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
@@ -211,19 +235,25 @@ public:
 	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
 
 private:
+	using VerbatimBytecodeData = std::tuple<size_t, size_t, bytes>;
+
 	size_t opcodeCount() const noexcept;
 
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	JumpType m_jumpType = JumpType::Ordinary;
+	/// The data if m_type != Operation. Data that fits into 64 bits is stored inline,
+	/// so that most items can be created and copied without allocating memory.
+	/// Larger values, e.g. hashes, are stored in m_largeData and shared between copies.
+	uint64_t m_smallData = 0;
+	std::shared_ptr<u256 const> m_largeData;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
 	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	std::shared_ptr<VerbatimBytecodeData const> m_verbatimBytecode;
 	langutil::DebugData::ConstPtr m_debugData;
-	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable std::optional<size_t> m_pushedValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
 	mutable std::optional<size_t> m_immutableOccurrences;
 };
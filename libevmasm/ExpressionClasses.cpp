@@ -54,8 +54,8 @@ bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression con
 			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
 	}
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) ==
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+		return item->data() == _other.item->data() &&
+			std::tie(arguments, sequenceNumber) == std::tie(_other.arguments, _other.sequenceNumber);
 }
 
 size_t ExpressionClasses::Expression::ExpressionHash::operator()(Expression const& _expression) const
@@ -154,29 +154,31 @@ bool ExpressionClasses::knownToBeDifferent(ExpressionClasses::Id _a, ExpressionC
 bool ExpressionClasses::knownToBeDifferentBy32(ExpressionClasses::Id _a, ExpressionClasses::Id _b)
 {
 	// Try to simplify "_a - _b" and return true iff the value is at least 32 away from zero.
-	u256 const* v = knownConstant(find(Instruction::SUB, {_a, _b}));
+	std::optional<u256> v = knownConstant(find(Instruction::SUB, {_a, _b}));
 	// forbidden interval is ["-31", 31]
 	return v && *v + 31 > u256(62);
 }
 
 bool ExpressionClasses::knownZero(Id _c)
 {
-	return Pattern(u256(0)).matches(representative(_c), *this);
+	Pattern::MatchGroups matchGroups;
+	return Pattern(u256(0)).matches(representative(_c), *this, matchGroups);
 }
 
 bool ExpressionClasses::knownNonZero(Id _c)
 {
-	return Pattern(u256(0)).matches(representative(find(Instruction::ISZERO, {_c})), *this);
+	Pattern::MatchGroups matchGroups;
+	return Pattern(u256(0)).matches(representative(find(Instruction::ISZERO, {_c})), *this, matchGroups);
 }
 
-u256 const* ExpressionClasses::knownConstant(Id _c)
+std::optional<u256> ExpressionClasses::knownConstant(Id _c)
 {
-	std::map<unsigned, Expression const*> matchGroups;
+	Pattern::MatchGroups matchGroups;
 	Pattern constant(Push);
-	constant.setMatchGroup(1, matchGroups);
-	if (!constant.matches(representative(_c), *this))
-		return nullptr;
-	return &constant.d();
+	constant.setMatchGroup(1);
+	if (!constant.matches(representative(_c), *this, matchGroups))
+		return std::nullopt;
+	return constant.d(matchGroups);
 }
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
@@ -204,7 +206,8 @@ std::string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules are not modified by matching, so all threads share one instance.
+	static Rules const rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -223,11 +226,15 @@ ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 			for (Id arg: _expr.arguments)
 				std::cout << fullDAGToString(arg) << ", ";
 			std::cout << ")" << std::endl;
-			std::cout << "with rule " << match->pattern.toString() << std::endl;
-			std::cout << "to " << match->action().toString() << std::endl;
+			std::cout << "with rule " << match->rule->pattern.toString() << std::endl;
+			std::cout << "to " << match->rule->action(match->matchGroups).toString() << std::endl;
 		}
 
-		return rebuildExpression(ExpressionTemplate(match->action(), _expr.item->debugData()));
+		return rebuildExpression(ExpressionTemplate(
+			match->rule->action(match->matchGroups),
+			match->matchGroups,
+			_expr.item->debugData()
+		));
 	}
 
 	return std::numeric_limits<unsigned>::max();
@@ -25,6 +25,9 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+#include <array>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
@@ -51,6 +54,12 @@ struct FunctionParameterCount<R(Args...)>
 template <class Method>
 struct SimplePeepholeOptimizerMethod
 {
+	/// Number of items the rule looks at.
+	static constexpr size_t windowSize()
+	{
+		return FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+	}
+
 	template <size_t... Indices>
 	static bool applyRule(
 		AssemblyItems::const_iterator _in,
@@ -62,7 +71,7 @@ struct SimplePeepholeOptimizerMethod
 	}
 	static bool apply(OptimiserState& _state)
 	{
-		static constexpr size_t WindowSize = FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+		static constexpr size_t WindowSize = windowSize();
 		if (
 			_state.i + WindowSize <= _state.items.size() &&
 			applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out, std::make_index_sequence<WindowSize>{})
@@ -76,20 +85,16 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity>
+struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
-	static bool applySimple(
-		AssemblyItem const& _item,
-		std::back_insert_iterator<AssemblyItems> _out
-	)
+	static bool matchesHead(AssemblyItem const& _push)
 	{
-		*_out = _item;
-		return true;
+		auto t = _push.type();
+		return
+			SemanticInformation::isDupInstruction(_push) ||
+			t == Push || t == PushTag || t == PushSub ||
+			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
 	}
-};
-
-struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
-{
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _pop,
@@ -107,6 +112,13 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 {
+	static bool matchesHead(AssemblyItem const& _op)
+	{
+		return
+			_op.type() == Operation &&
+			instructionInfo(_op.instruction(), langutil::EVMVersion()).ret == 1 &&
+			!instructionInfo(_op.instruction(), langutil::EVMVersion()).sideEffects;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -129,6 +141,12 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 
 struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 {
+	static bool matchesHead(AssemblyItem const& _op)
+	{
+		return
+			(_op.type() == Operation && !instructionInfo(_op.instruction(), langutil::EVMVersion()).sideEffects) ||
+			_op.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _stop,
@@ -158,6 +176,7 @@ struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 
 struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 {
+	static bool matchesHead(AssemblyItem const& _op) { return OpStop::matchesHead(_op); }
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _push,
@@ -187,6 +206,7 @@ struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 {
+	static bool matchesHead(AssemblyItem const& _s1) { return SemanticInformation::isSwapInstruction(_s1); }
 	static size_t applySimple(
 		AssemblyItem const& _s1,
 		AssemblyItem const& _s2,
@@ -199,6 +219,7 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 {
+	static bool matchesHead(AssemblyItem const& _push1) { return _push1.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _push1,
 		AssemblyItem const& _push2,
@@ -218,6 +239,7 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 {
+	static bool matchesHead(AssemblyItem const& _swap) { return _swap == Instruction::SWAP1; }
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -240,6 +262,7 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 {
+	static bool matchesHead(AssemblyItem const& _swap) { return _swap == Instruction::SWAP1; }
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -270,6 +293,7 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 {
+	static bool matchesHead(AssemblyItem const& _dupN) { return SemanticInformation::isDupInstruction(_dupN); }
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -293,6 +317,7 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 {
+	static bool matchesHead(AssemblyItem const& _iszero1) { return _iszero1 == Instruction::ISZERO; }
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -319,6 +344,7 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 
 struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 {
+	static bool matchesHead(AssemblyItem const& _eq) { return _eq == Instruction::EQ; }
 	static size_t applySimple(
 		AssemblyItem const& _eq,
 		AssemblyItem const& _iszero,
@@ -347,6 +373,7 @@ struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 // push_tag_1 jumpi push_tag_2 jump tag_1: -> iszero push_tag_2 jumpi tag_1:
 struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 {
+	static bool matchesHead(AssemblyItem const& _pushTag1) { return _pushTag1.type() == PushTag; }
 	static size_t applySimple(
 		AssemblyItem const& _pushTag1,
 		AssemblyItem const& _jumpi,
@@ -378,6 +405,7 @@ struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 {
+	static bool matchesHead(AssemblyItem const& _pushTag) { return _pushTag.type() == PushTag; }
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -404,6 +432,7 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 {
+	static bool matchesHead(AssemblyItem const& _pushTag) { return _pushTag.type() == PushTag || _pushTag.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -439,6 +468,7 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 {
+	static bool matchesHead(AssemblyItem const& _push) { return _push.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -457,20 +487,27 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	/// Whether the rule matches only depends on the first two items.
+	static constexpr size_t windowSize() { return 2; }
+
+	static bool matchesHead(AssemblyItem const& _item)
+	{
+		return
+			_item == Instruction::JUMP ||
+			_item == Instruction::RETURN ||
+			_item == Instruction::STOP ||
+			_item == Instruction::INVALID ||
+			_item == Instruction::SELFDESTRUCT ||
+			_item == Instruction::REVERT;
+	}
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
 		auto end = _state.items.end();
 		if (it == end)
 			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
+		if (!matchesHead(it[0]))
 			return false;
 
 		ptrdiff_t i = 1;
@@ -487,45 +524,150 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// The rules in the order in which they are tried at every position.
+template <typename... Methods>
+struct MethodList
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+	using Apply = bool(*)(OptimiserState&);
+	/// Number of kinds of window heads: one per instruction and one per other item type.
+	static constexpr size_t headKinds = 256 + VerbatimBytecode + 1;
+
+	static constexpr size_t windowSize() { return std::max({Methods::windowSize()...}); }
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+	static size_t headKind(AssemblyItem const& _item)
+	{
+		if (_item.type() == Operation)
+			return static_cast<uint8_t>(_item.instruction());
+		return 256 + static_cast<size_t>(_item.type());
+	}
+
+	/// @returns the rules that can match at a position with the given item, in order.
+	static std::vector<Apply> const& methodsFor(AssemblyItem const& _head)
+	{
+		static std::array<std::vector<Apply>, headKinds> const methods = []() {
+			std::array<std::vector<Apply>, headKinds> methods;
+			for (size_t kind = 0; kind < headKinds; ++kind)
+			{
+				AssemblyItem head =
+					kind < 256 ?
+					AssemblyItem(static_cast<Instruction>(kind)) :
+					AssemblyItem(static_cast<AssemblyItemType>(kind - 256));
+				((Methods::matchesHead(head) ? methods[kind].push_back(&Methods::apply) : void()), ...);
+			}
+			return methods;
+		}();
+		return methods[headKind(_head)];
+	}
+};
+
+using PeepholeMethods = MethodList<
+	PushPop, OpPop, OpStop, OpReturnRevert, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+	DupSwap, IsZeroIsZeroJumpI, EqIsZeroJumpI, DoubleJump, JumpToNext, UnreachableCode,
+	TagConjunctions, TruthyAnd
+>;
+
+/// Replacement of the items in the half-open range [begin, end) by a rule.
+struct Change
+{
+	size_t begin;
+	size_t end;
+	AssemblyItems items;
+};
+
+size_t numberOfPops(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return static_cast<size_t>(std::count(_begin, _end, Instruction::POP));
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+size_t approximateBytesRequired(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
+	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
+	size_t size = 0;
+	for (auto it = _begin; it != _end; ++it)
+		size += it->bytesRequired(3, Precision::Approximate);
+	return size;
 }
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
-	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems)};
+	// Positions are visited as in a full pass, but the rules are only tried where the
+	// previous pass changed something within the window of the rules. Everywhere else,
+	// they see the same items as in the previous pass, in which none of them matched.
+	std::vector<Change> changes;
+	AssemblyItems replacement;
+	OptimiserState state {m_items, 0, back_inserter(replacement)};
+	auto positionsToVisit = m_positionsToVisit.begin();
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
+	{
+		while (positionsToVisit != m_positionsToVisit.end() && positionsToVisit->second <= state.i)
+			++positionsToVisit;
+		if (positionsToVisit == m_positionsToVisit.end())
+			break;
+		if (positionsToVisit->first > state.i)
+		{
+			state.i = std::min(positionsToVisit->first, m_items.size());
+			continue;
+		}
+
+		size_t begin = state.i;
+		auto const& methods = PeepholeMethods::methodsFor(m_items[state.i]);
+		if (std::any_of(methods.begin(), methods.end(), [&](auto _apply) { return _apply(state); }))
+		{
+			changes.push_back({begin, state.i, std::move(replacement)});
+			replacement.clear();
+		}
+		else
+			++state.i;
+	}
+
+	size_t removedItems = 0;
+	size_t addedItems = 0;
+	size_t removedBytes = 0;
+	size_t addedBytes = 0;
+	size_t removedPops = 0;
+	size_t addedPops = 0;
+	for (Change const& change: changes)
+	{
+		auto begin = m_items.begin() + static_cast<ptrdiff_t>(change.begin);
+		auto end = m_items.begin() + static_cast<ptrdiff_t>(change.end);
+		removedItems += change.end - change.begin;
+		addedItems += change.items.size();
+		removedBytes += approximateBytesRequired(begin, end);
+		addedBytes += approximateBytesRequired(change.items.begin(), change.items.end());
+		removedPops += numberOfPops(begin, end);
+		addedPops += numberOfPops(change.items.begin(), change.items.end());
+	}
+
+	if (addedItems < removedItems || (
+		addedItems == removedItems && (
+			addedBytes < removedBytes ||
+			addedPops > removedPops
 		)
 	))
 	{
-		m_items = std::move(m_optimisedItems);
+		size_t constexpr windowSize = PeepholeMethods::windowSize();
+		AssemblyItems optimisedItems;
+		optimisedItems.reserve(m_items.size() - removedItems + addedItems);
+		m_positionsToVisit.clear();
+		size_t position = 0;
+		for (Change& change: changes)
+		{
+			std::move(
+				m_items.begin() + static_cast<ptrdiff_t>(position),
+				m_items.begin() + static_cast<ptrdiff_t>(change.begin),
+				back_inserter(optimisedItems)
+			);
+			// Rules have to be tried at all positions from which their window reaches the new items
+			// or, if items were only removed, spans the removed ones.
+			size_t begin = optimisedItems.size();
+			std::move(change.items.begin(), change.items.end(), back_inserter(optimisedItems));
+			m_positionsToVisit.emplace_back(begin + 1 > windowSize ? begin + 1 - windowSize : 0, optimisedItems.size());
+			position = change.end;
+		}
+		std::move(m_items.begin() + static_cast<ptrdiff_t>(position), m_items.end(), back_inserter(optimisedItems));
+		m_items = std::move(optimisedItems);
 		return true;
 	}
 	else
@@ -24,6 +24,8 @@
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <limits>
+#include <utility>
 
 namespace solidity::evmasm
 {
@@ -44,11 +46,18 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs one pass over the items and replaces them by the result of the pass
+	/// if that is an improvement.
+	/// Positions at which the rules see the same items as in the last successful pass are
+	/// skipped, so the items must not be modified in other ways between calls.
+	/// @returns true if the items were replaced.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
+	/// Sorted half-open ranges of positions in m_items at which the rules have to be tried.
+	/// Rules did not match anywhere else in the last successful pass and will not match there again.
+	std::vector<std::pair<size_t, size_t>> m_positionsToVisit{{0, std::numeric_limits<size_t>::max()}};
 };
 
 }
@@ -80,50 +80,51 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	return std::vector<SimplificationRule<Pattern>>{
 		// arithmetic on constants
-		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
-		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
-		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
-		{Builtins::NOT(A), [=]{ return ~A.d(); }},
-		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
-		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
-		{Builtins::SLT(A, B), [=]() -> Word { return u2s(A.d()) < u2s(B.d()) ? 1 : 0; }},
-		{Builtins::SGT(A, B), [=]() -> Word { return u2s(A.d()) > u2s(B.d()) ? 1 : 0; }},
-		{Builtins::EQ(A, B), [=]() -> Word { return A.d() == B.d() ? 1 : 0; }},
-		{Builtins::ISZERO(A), [=]() -> Word { return A.d() == 0 ? 1 : 0; }},
-		{Builtins::AND(A, B), [=]{ return A.d() & B.d(); }},
-		{Builtins::OR(A, B), [=]{ return A.d() | B.d(); }},
-		{Builtins::XOR(A, B), [=]{ return A.d() ^ B.d(); }},
-		{Builtins::BYTE(A, B), [=]{
+		{Builtins::ADD(A, B), [=](MatchGroups const& _m) { return A.d(_m) + B.d(_m); }},
+		{Builtins::MUL(A, B), [=](MatchGroups const& _m) { return A.d(_m) * B.d(_m); }},
+		{Builtins::SUB(A, B), [=](MatchGroups const& _m) { return A.d(_m) - B.d(_m); }},
+		{Builtins::DIV(A, B), [=](MatchGroups const& _m) { return B.d(_m) == 0 ? 0 : divWorkaround(A.d(_m), B.d(_m)); }},
+		{Builtins::SDIV(A, B), [=](MatchGroups const& _m) { return B.d(_m) == 0 ? 0 : s2u(divWorkaround(u2s(A.d(_m)), u2s(B.d(_m)))); }},
+		{Builtins::MOD(A, B), [=](MatchGroups const& _m) { return B.d(_m) == 0 ? 0 : modWorkaround(A.d(_m), B.d(_m)); }},
+		{Builtins::SMOD(A, B), [=](MatchGroups const& _m) { return B.d(_m) == 0 ? 0 : s2u(modWorkaround(u2s(A.d(_m)), u2s(B.d(_m)))); }},
+		{Builtins::EXP(A, B), [=](MatchGroups const& _m) { return Word(boost::multiprecision::powm(bigint(A.d(_m)), bigint(B.d(_m)), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::NOT(A), [=](MatchGroups const& _m) { return ~A.d(_m); }},
+		{Builtins::LT(A, B), [=](MatchGroups const& _m) -> Word { return A.d(_m) < B.d(_m) ? 1 : 0; }},
+		{Builtins::GT(A, B), [=](MatchGroups const& _m) -> Word { return A.d(_m) > B.d(_m) ? 1 : 0; }},
+		{Builtins::SLT(A, B), [=](MatchGroups const& _m) -> Word { return u2s(A.d(_m)) < u2s(B.d(_m)) ? 1 : 0; }},
+		{Builtins::SGT(A, B), [=](MatchGroups const& _m) -> Word { return u2s(A.d(_m)) > u2s(B.d(_m)) ? 1 : 0; }},
+		{Builtins::EQ(A, B), [=](MatchGroups const& _m) -> Word { return A.d(_m) == B.d(_m) ? 1 : 0; }},
+		{Builtins::ISZERO(A), [=](MatchGroups const& _m) -> Word { return A.d(_m) == 0 ? 1 : 0; }},
+		{Builtins::AND(A, B), [=](MatchGroups const& _m) { return A.d(_m) & B.d(_m); }},
+		{Builtins::OR(A, B), [=](MatchGroups const& _m) { return A.d(_m) | B.d(_m); }},
+		{Builtins::XOR(A, B), [=](MatchGroups const& _m) { return A.d(_m) ^ B.d(_m); }},
+		{Builtins::BYTE(A, B), [=](MatchGroups const& _m) {
 			return
-				A.d() >= Pattern::WordSize / 8 ?
+				A.d(_m) >= Pattern::WordSize / 8 ?
 				0 :
-				(B.d() >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d()))) & 0xff;
+				(B.d(_m) >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d(_m)))) & 0xff;
 		}},
-		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) + bigint(B.d())) % C.d()); }},
-		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) * bigint(B.d())) % C.d()); }},
-		{Builtins::SIGNEXTEND(A, B), [=]() -> Word {
-			if (A.d() >= Pattern::WordSize / 8 - 1)
-				return B.d();
-			unsigned testBit = unsigned(A.d()) * 8 + 7;
+		{Builtins::ADDMOD(A, B, C), [=](MatchGroups const& _m) { return C.d(_m) == 0 ? 0 : Word((bigint(A.d(_m)) + bigint(B.d(_m))) % C.d(_m)); }},
+		{Builtins::MULMOD(A, B, C), [=](MatchGroups const& _m) { return C.d(_m) == 0 ? 0 : Word((bigint(A.d(_m)) * bigint(B.d(_m))) % C.d(_m)); }},
+		{Builtins::SIGNEXTEND(A, B), [=](MatchGroups const& _m) -> Word {
+			if (A.d(_m) >= Pattern::WordSize / 8 - 1)
+				return B.d(_m);
+			unsigned testBit = unsigned(A.d(_m)) * 8 + 7;
 			Word mask = (Word(1) << testBit) - 1;
-			return boost::multiprecision::bit_test(B.d(), testBit) ? B.d() | ~mask : B.d() & mask;
+			return boost::multiprecision::bit_test(B.d(_m), testBit) ? B.d(_m) | ~mask : B.d(_m) & mask;
 		}},
-		{Builtins::SHL(A, B), [=]{
-			if (A.d() >= Pattern::WordSize)
+		{Builtins::SHL(A, B), [=](MatchGroups const& _m) {
+			if (A.d(_m) >= Pattern::WordSize)
 				return Word(0);
-			return shlWorkaround(B.d(), unsigned(A.d()));
+			return shlWorkaround(B.d(_m), unsigned(A.d(_m)));
 		}},
-		{Builtins::SHR(A, B), [=]{
-			if (A.d() >= Pattern::WordSize)
+		{Builtins::SHR(A, B), [=](MatchGroups const& _m) {
+			if (A.d(_m) >= Pattern::WordSize)
 				return Word(0);
-			return B.d() >> unsigned(A.d());
+			return B.d(_m) >> unsigned(A.d(_m));
 		}}
 	};
 }
@@ -140,50 +141,51 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart2(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	return std::vector<SimplificationRule<Pattern>> {
 		// invariants involving known constants
-		{Builtins::ADD(X, 0), [=]{ return X; }},
-		{Builtins::ADD(0, X), [=]{ return X; }},
-		{Builtins::SUB(X, 0), [=]{ return X; }},
-		{Builtins::SUB(~Word(0), X), [=]() -> Pattern { return Builtins::NOT(X); }},
-		{Builtins::MUL(X, 0), [=]{ return Word(0); }},
-		{Builtins::MUL(0, X), [=]{ return Word(0); }},
-		{Builtins::MUL(X, 1), [=]{ return X; }},
-		{Builtins::MUL(1, X), [=]{ return X; }},
-		{Builtins::MUL(X, Word(-1)), [=]() -> Pattern { return Builtins::SUB(0, X); }},
-		{Builtins::MUL(Word(-1), X), [=]() -> Pattern { return Builtins::SUB(0, X); }},
-		{Builtins::DIV(X, 0), [=]{ return Word(0); }},
-		{Builtins::DIV(0, X), [=]{ return Word(0); }},
-		{Builtins::DIV(X, 1), [=]{ return X; }},
-		{Builtins::SDIV(X, 0), [=]{ return Word(0); }},
-		{Builtins::SDIV(0, X), [=]{ return Word(0); }},
-		{Builtins::SDIV(X, 1), [=]{ return X; }},
-		{Builtins::AND(X, ~Word(0)), [=]{ return X; }},
-		{Builtins::AND(~Word(0), X), [=]{ return X; }},
-		{Builtins::AND(X, 0), [=]{ return Word(0); }},
-		{Builtins::AND(0, X), [=]{ return Word(0); }},
-		{Builtins::OR(X, 0), [=]{ return X; }},
-		{Builtins::OR(0, X), [=]{ return X; }},
-		{Builtins::OR(X, ~Word(0)), [=]{ return ~Word(0); }},
-		{Builtins::OR(~Word(0), X), [=]{ return ~Word(0); }},
-		{Builtins::XOR(X, 0), [=]{ return X; }},
-		{Builtins::XOR(0, X), [=]{ return X; }},
-		{Builtins::MOD(X, 0), [=]{ return Word(0); }},
-		{Builtins::MOD(0, X), [=]{ return Word(0); }},
-		{Builtins::EQ(X, 0), [=]() -> Pattern { return Builtins::ISZERO(X); },},
-		{Builtins::EQ(0, X), [=]() -> Pattern { return Builtins::ISZERO(X); },},
-		{Builtins::SHL(0, X), [=]{ return X; }},
-		{Builtins::SHR(0, X), [=]{ return X; }},
-		{Builtins::SHL(X, 0), [=]{ return Word(0); }},
-		{Builtins::SHR(X, 0), [=]{ return Word(0); }},
-		{Builtins::GT(X, 0), [=]() -> Pattern { return Builtins::ISZERO(Builtins::ISZERO(X)); }},
-		{Builtins::LT(0, X), [=]() -> Pattern { return Builtins::ISZERO(Builtins::ISZERO(X)); }},
-		{Builtins::GT(X, ~Word(0)), [=]{ return Word(0); }},
-		{Builtins::LT(~Word(0), X), [=]{ return Word(0); }},
-		{Builtins::GT(0, X), [=]{ return Word(0); }},
-		{Builtins::LT(X, 0), [=]{ return Word(0); }},
-		{Builtins::AND(Builtins::BYTE(X, Y), Word(0xff)), [=]() -> Pattern { return Builtins::BYTE(X, Y); }},
-		{Builtins::BYTE(Word(Pattern::WordSize / 8 - 1), X), [=]() -> Pattern { return Builtins::AND(X, Word(0xff)); }},
+		{Builtins::ADD(X, 0), [=](MatchGroups const&) { return X; }},
+		{Builtins::ADD(0, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::SUB(X, 0), [=](MatchGroups const&) { return X; }},
+		{Builtins::SUB(~Word(0), X), [=](MatchGroups const&) -> Pattern { return Builtins::NOT(X); }},
+		{Builtins::MUL(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::MUL(0, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::MUL(X, 1), [=](MatchGroups const&) { return X; }},
+		{Builtins::MUL(1, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::MUL(X, Word(-1)), [=](MatchGroups const&) -> Pattern { return Builtins::SUB(0, X); }},
+		{Builtins::MUL(Word(-1), X), [=](MatchGroups const&) -> Pattern { return Builtins::SUB(0, X); }},
+		{Builtins::DIV(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::DIV(0, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::DIV(X, 1), [=](MatchGroups const&) { return X; }},
+		{Builtins::SDIV(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::SDIV(0, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::SDIV(X, 1), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(X, ~Word(0)), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(~Word(0), X), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::AND(0, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::OR(X, 0), [=](MatchGroups const&) { return X; }},
+		{Builtins::OR(0, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::OR(X, ~Word(0)), [=](MatchGroups const&) { return ~Word(0); }},
+		{Builtins::OR(~Word(0), X), [=](MatchGroups const&) { return ~Word(0); }},
+		{Builtins::XOR(X, 0), [=](MatchGroups const&) { return X; }},
+		{Builtins::XOR(0, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::MOD(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::MOD(0, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::EQ(X, 0), [=](MatchGroups const&) -> Pattern { return Builtins::ISZERO(X); },},
+		{Builtins::EQ(0, X), [=](MatchGroups const&) -> Pattern { return Builtins::ISZERO(X); },},
+		{Builtins::SHL(0, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::SHR(0, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::SHL(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::SHR(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::GT(X, 0), [=](MatchGroups const&) -> Pattern { return Builtins::ISZERO(Builtins::ISZERO(X)); }},
+		{Builtins::LT(0, X), [=](MatchGroups const&) -> Pattern { return Builtins::ISZERO(Builtins::ISZERO(X)); }},
+		{Builtins::GT(X, ~Word(0)), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::LT(~Word(0), X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::GT(0, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::LT(X, 0), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::AND(Builtins::BYTE(X, Y), Word(0xff)), [=](MatchGroups const&) -> Pattern { return Builtins::BYTE(X, Y); }},
+		{Builtins::BYTE(Word(Pattern::WordSize / 8 - 1), X), [=](MatchGroups const&) -> Pattern { return Builtins::AND(X, Word(0xff)); }},
 	};
 }
 
@@ -198,18 +200,19 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart3(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	return std::vector<SimplificationRule<Pattern>> {
 		// operations involving an expression and itself
-		{Builtins::AND(X, X), [=]{ return X; }},
-		{Builtins::OR(X, X), [=]{ return X; }},
-		{Builtins::XOR(X, X), [=]{ return Word(0); }},
-		{Builtins::SUB(X, X), [=]{ return Word(0); }},
-		{Builtins::EQ(X, X), [=]{ return Word(1); }},
-		{Builtins::LT(X, X), [=]{ return Word(0); }},
-		{Builtins::SLT(X, X), [=]{ return Word(0); }},
-		{Builtins::GT(X, X), [=]{ return Word(0); }},
-		{Builtins::SGT(X, X), [=]{ return Word(0); }},
-		{Builtins::MOD(X, X), [=]{ return Word(0); }}
+		{Builtins::AND(X, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::OR(X, X), [=](MatchGroups const&) { return X; }},
+		{Builtins::XOR(X, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::SUB(X, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::EQ(X, X), [=](MatchGroups const&) { return Word(1); }},
+		{Builtins::LT(X, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::SLT(X, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::GT(X, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::SGT(X, X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::MOD(X, X), [=](MatchGroups const&) { return Word(0); }}
 	};
 }
 
@@ -224,25 +227,26 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart4(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	return std::vector<SimplificationRule<Pattern>> {
 		// logical instruction combinations
-		{Builtins::NOT(Builtins::NOT(X)), [=]{ return X; }},
-		{Builtins::XOR(X, Builtins::XOR(X, Y)), [=]{ return Y; }},
-		{Builtins::XOR(X, Builtins::XOR(Y, X)), [=]{ return Y; }},
-		{Builtins::XOR(Builtins::XOR(X, Y), X), [=]{ return Y; }},
-		{Builtins::XOR(Builtins::XOR(Y, X), X), [=]{ return Y; }},
-		{Builtins::OR(X, Builtins::AND(X, Y)), [=]{ return X; }},
-		{Builtins::OR(X, Builtins::AND(Y, X)), [=]{ return X; }},
-		{Builtins::OR(Builtins::AND(X, Y), X), [=]{ return X; }},
-		{Builtins::OR(Builtins::AND(Y, X), X), [=]{ return X; }},
-		{Builtins::AND(X, Builtins::OR(X, Y)), [=]{ return X; }},
-		{Builtins::AND(X, Builtins::OR(Y, X)), [=]{ return X; }},
-		{Builtins::AND(Builtins::OR(X, Y), X), [=]{ return X; }},
-		{Builtins::AND(Builtins::OR(Y, X), X), [=]{ return X; }},
-		{Builtins::AND(X, Builtins::NOT(X)), [=]{ return Word(0); }},
-		{Builtins::AND(Builtins::NOT(X), X), [=]{ return Word(0); }},
-		{Builtins::OR(X, Builtins::NOT(X)), [=]{ return ~Word(0); }},
-		{Builtins::OR(Builtins::NOT(X), X), [=]{ return ~Word(0); }},
+		{Builtins::NOT(Builtins::NOT(X)), [=](MatchGroups const&) { return X; }},
+		{Builtins::XOR(X, Builtins::XOR(X, Y)), [=](MatchGroups const&) { return Y; }},
+		{Builtins::XOR(X, Builtins::XOR(Y, X)), [=](MatchGroups const&) { return Y; }},
+		{Builtins::XOR(Builtins::XOR(X, Y), X), [=](MatchGroups const&) { return Y; }},
+		{Builtins::XOR(Builtins::XOR(Y, X), X), [=](MatchGroups const&) { return Y; }},
+		{Builtins::OR(X, Builtins::AND(X, Y)), [=](MatchGroups const&) { return X; }},
+		{Builtins::OR(X, Builtins::AND(Y, X)), [=](MatchGroups const&) { return X; }},
+		{Builtins::OR(Builtins::AND(X, Y), X), [=](MatchGroups const&) { return X; }},
+		{Builtins::OR(Builtins::AND(Y, X), X), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(X, Builtins::OR(X, Y)), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(X, Builtins::OR(Y, X)), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(Builtins::OR(X, Y), X), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(Builtins::OR(Y, X), X), [=](MatchGroups const&) { return X; }},
+		{Builtins::AND(X, Builtins::NOT(X)), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::AND(Builtins::NOT(X), X), [=](MatchGroups const&) { return Word(0); }},
+		{Builtins::OR(X, Builtins::NOT(X)), [=](MatchGroups const&) { return ~Word(0); }},
+		{Builtins::OR(Builtins::NOT(X), X), [=](MatchGroups const&) { return ~Word(0); }},
 	};
 }
 
@@ -256,19 +260,20 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart4_5(
 )
 {
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	return std::vector<SimplificationRule<Pattern>>{
 		// idempotent operations
-		{Builtins::AND(Builtins::AND(X, Y), Y), [=]{ return Builtins::AND(X, Y); }},
-		{Builtins::AND(Y, Builtins::AND(X, Y)), [=]{ return Builtins::AND(X, Y); }},
-		{Builtins::AND(Builtins::AND(Y, X), Y), [=]{ return Builtins::AND(Y, X); }},
-		{Builtins::AND(Y, Builtins::AND(Y, X)), [=]{ return Builtins::AND(Y, X); }},
-		{Builtins::OR(Builtins::OR(X, Y), Y), [=]{ return Builtins::OR(X, Y); }},
-		{Builtins::OR(Y, Builtins::OR(X, Y)), [=]{ return Builtins::OR(X, Y); }},
-		{Builtins::OR(Builtins::OR(Y, X), Y), [=]{ return Builtins::OR(Y, X); }},
-		{Builtins::OR(Y, Builtins::OR(Y, X)), [=]{ return Builtins::OR(Y, X); }},
-		{Builtins::SIGNEXTEND(X, Builtins::SIGNEXTEND(X, Y)), [=]() { return Builtins::SIGNEXTEND(X, Y); }},
-		{Builtins::SIGNEXTEND(A, Builtins::SIGNEXTEND(B, X)), [=]() {
-			return Builtins::SIGNEXTEND(A.d() < B.d() ? A.d() : B.d(), X);
+		{Builtins::AND(Builtins::AND(X, Y), Y), [=](MatchGroups const&) { return Builtins::AND(X, Y); }},
+		{Builtins::AND(Y, Builtins::AND(X, Y)), [=](MatchGroups const&) { return Builtins::AND(X, Y); }},
+		{Builtins::AND(Builtins::AND(Y, X), Y), [=](MatchGroups const&) { return Builtins::AND(Y, X); }},
+		{Builtins::AND(Y, Builtins::AND(Y, X)), [=](MatchGroups const&) { return Builtins::AND(Y, X); }},
+		{Builtins::OR(Builtins::OR(X, Y), Y), [=](MatchGroups const&) { return Builtins::OR(X, Y); }},
+		{Builtins::OR(Y, Builtins::OR(X, Y)), [=](MatchGroups const&) { return Builtins::OR(X, Y); }},
+		{Builtins::OR(Builtins::OR(Y, X), Y), [=](MatchGroups const&) { return Builtins::OR(Y, X); }},
+		{Builtins::OR(Y, Builtins::OR(Y, X)), [=](MatchGroups const&) { return Builtins::OR(Y, X); }},
+		{Builtins::SIGNEXTEND(X, Builtins::SIGNEXTEND(X, Y)), [=](MatchGroups const&) { return Builtins::SIGNEXTEND(X, Y); }},
+		{Builtins::SIGNEXTEND(A, Builtins::SIGNEXTEND(B, X)), [=](MatchGroups const& _m) {
+			return Builtins::SIGNEXTEND(A.d(_m) < B.d(_m) ? A.d(_m) : B.d(_m), X);
 		}},
 	};
 }
@@ -285,6 +290,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart5(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 
 	std::vector<SimplificationRule<Pattern>> rules;
 
@@ -294,18 +300,18 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart5(
 		// Replace MOD(MUL(X, Y), A) with MULMOD(X, Y, A) iff A=2**N
 		rules.push_back({
 			Builtins::MOD(Builtins::MUL(X, Y), A),
-			[=]() -> Pattern { return Builtins::MULMOD(X, Y, A); },
-			[=] {
-				return A.d() > 0 && ((A.d() & (A.d() - 1)) == 0);
+			[=](MatchGroups const&) -> Pattern { return Builtins::MULMOD(X, Y, A); },
+			[=](MatchGroups const& _m) {
+				return A.d(_m) > 0 && ((A.d(_m) & (A.d(_m) - 1)) == 0);
 			}
 		});
 
 		// Replace MOD(ADD(X, Y), A) with ADDMOD(X, Y, A) iff A=2**N
 		rules.push_back({
 			Builtins::MOD(Builtins::ADD(X, Y), A),
-			[=]() -> Pattern { return Builtins::ADDMOD(X, Y, A); },
-			[=] {
-				return A.d() > 0 && ((A.d() & (A.d() - 1)) == 0);
+			[=](MatchGroups const&) -> Pattern { return Builtins::ADDMOD(X, Y, A); },
+			[=](MatchGroups const& _m) {
+				return A.d(_m) > 0 && ((A.d(_m) & (A.d(_m) - 1)) == 0);
 			}
 		});
 	}
@@ -316,53 +322,53 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart5(
 		Word value = Word(1) << i;
 		rules.push_back({
 			Builtins::MOD(X, value),
-			[=]() -> Pattern { return Builtins::AND(X, value - 1); }
+			[=](MatchGroups const&) -> Pattern { return Builtins::AND(X, value - 1); }
 		});
 	}
 
 	// Replace SHL >=256, X with 0
 	rules.push_back({
 		Builtins::SHL(A, X),
-		[=]() -> Pattern { return Word(0); },
-		[=]() { return A.d() >= Pattern::WordSize; }
+		[=](MatchGroups const&) -> Pattern { return Word(0); },
+		[=](MatchGroups const& _m) { return A.d(_m) >= Pattern::WordSize; }
 	});
 
 	// Replace SHR >=256, X with 0
 	rules.push_back({
 		Builtins::SHR(A, X),
-		[=]() -> Pattern { return Word(0); },
-		[=]() { return A.d() >= Pattern::WordSize; }
+		[=](MatchGroups const&) -> Pattern { return Word(0); },
+		[=](MatchGroups const& _m) { return A.d(_m) >= Pattern::WordSize; }
 	});
 
 	// Replace BYTE(A, X), A >= 32 with 0
 	rules.push_back({
 		Builtins::BYTE(A, X),
-		[=]() -> Pattern { return Word(0); },
-		[=]() { return A.d() >= Pattern::WordSize / 8; }
+		[=](MatchGroups const&) -> Pattern { return Word(0); },
+		[=](MatchGroups const& _m) { return A.d(_m) >= Pattern::WordSize / 8; }
 	});
 
 	// Replace SIGNEXTEND(A, X), A >= 31 with ID
 	rules.push_back({
 		Builtins::SIGNEXTEND(A, X),
-		[=]() -> Pattern { return X; },
-		[=]() { return A.d() >= Pattern::WordSize / 8 - 1; }
+		[=](MatchGroups const&) -> Pattern { return X; },
+		[=](MatchGroups const& _m) { return A.d(_m) >= Pattern::WordSize / 8 - 1; }
 	});
 	rules.push_back({
 		Builtins::AND(A, Builtins::SIGNEXTEND(B, X)),
-		[=]() -> Pattern { return Builtins::AND(A, X); },
-		[=]() {
+		[=](MatchGroups const&) -> Pattern { return Builtins::AND(A, X); },
+		[=](MatchGroups const& _m) {
 			return
-				B.d() < Pattern::WordSize / 8 - 1 &&
-				(A.d() & ((u256(1) << static_cast<size_t>((B.d() + 1) * 8)) - 1)) == A.d();
+				B.d(_m) < Pattern::WordSize / 8 - 1 &&
+				(A.d(_m) & ((u256(1) << static_cast<size_t>((B.d(_m) + 1) * 8)) - 1)) == A.d(_m);
 		}
 	});
 	rules.push_back({
 		Builtins::AND(Builtins::SIGNEXTEND(B, X), A),
-		[=]() -> Pattern { return Builtins::AND(A, X); },
-		[=]() {
+		[=](MatchGroups const&) -> Pattern { return Builtins::AND(A, X); },
+		[=](MatchGroups const& _m) {
 			return
-				B.d() < Pattern::WordSize / 8 - 1 &&
-				(A.d() & ((u256(1) << static_cast<size_t>((B.d() + 1) * 8)) - 1)) == A.d();
+				B.d(_m) < Pattern::WordSize / 8 - 1 &&
+				(A.d(_m) & ((u256(1) << static_cast<size_t>((B.d(_m) + 1) * 8)) - 1)) == A.d(_m);
 		}
 	});
 
@@ -377,11 +383,11 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart5(
 		Word const mask = (Word(1) << 160) - 1;
 		rules.push_back({
 			Builtins::AND(Pattern{instr}, mask),
-			[=]() -> Pattern { return {instr}; }
+			[=](MatchGroups const&) -> Pattern { return {instr}; }
 		});
 		rules.push_back({
 			Builtins::AND(mask, Pattern{instr}),
-			[=]() -> Pattern { return {instr}; }
+			[=](MatchGroups const&) -> Pattern { return {instr}; }
 		});
 	}
 
@@ -398,6 +404,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart6(
 )
 {
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 
 	std::vector<SimplificationRule<Pattern>> rules;
 	// Double negation of opcodes with boolean result
@@ -412,23 +419,23 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart6(
 		typename Builtins::PatternGeneratorInstance op{instr};
 		rules.push_back({
 			Builtins::ISZERO(Builtins::ISZERO(op(X, Y))),
-			[=]() -> Pattern { return op(X, Y); }
+			[=](MatchGroups const&) -> Pattern { return op(X, Y); }
 		});
 	}
 
 	rules.push_back({
 		Builtins::ISZERO(Builtins::ISZERO(Builtins::ISZERO(X))),
-		[=]() -> Pattern { return Builtins::ISZERO(X); }
+		[=](MatchGroups const&) -> Pattern { return Builtins::ISZERO(X); }
 	});
 
 	rules.push_back({
 		Builtins::ISZERO(Builtins::XOR(X, Y)),
-		[=]() -> Pattern { return Builtins::EQ(X, Y); }
+		[=](MatchGroups const&) -> Pattern { return Builtins::EQ(X, Y); }
 	});
 
 	rules.push_back({
 		Builtins::ISZERO(Builtins::SUB(X, Y)),
-		[=]() -> Pattern { return Builtins::EQ(X, Y); }
+		[=](MatchGroups const&) -> Pattern { return Builtins::EQ(X, Y); }
 	});
 
 	return rules;
@@ -446,6 +453,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 
 	std::vector<SimplificationRule<Pattern>> rules;
 	// Associative operations
@@ -467,19 +475,19 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 			rules += std::vector<SimplificationRule<Pattern>>{{
 				// (X+A)+B -> X+(A+B)
 				op(opXA, B),
-				[=]() -> Pattern { return op(X, fun(A.d(), B.d())); }
+				[=](MatchGroups const& _m) -> Pattern { return op(X, fun(A.d(_m), B.d(_m))); }
 			}, {
 				// (X+A)+Y -> (X+Y)+A
 				op(opXA, Y),
-				[=]() -> Pattern { return op(op(X, Y), A); }
+				[=](MatchGroups const&) -> Pattern { return op(op(X, Y), A); }
 			}, {
 				// B+(X+A) -> X+(A+B)
 				op(B, opXA),
-				[=]() -> Pattern { return op(X, fun(A.d(), B.d())); }
+				[=](MatchGroups const& _m) -> Pattern { return op(X, fun(A.d(_m), B.d(_m))); }
 			}, {
 				// Y+(X+A) -> (Y+X)+A
 				op(Y, opXA),
-				[=]() -> Pattern { return op(op(Y, X), A); }
+				[=](MatchGroups const&) -> Pattern { return op(op(Y, X), A); }
 			}};
 		}
 	}
@@ -488,8 +496,8 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 	rules.push_back({
 		// SHL(B, SHL(A, X)) -> SHL(min(A+B, 256), X)
 		Builtins::SHL(B, Builtins::SHL(A, X)),
-		[=]() -> Pattern {
-			bigint sum = bigint(A.d()) + B.d();
+		[=](MatchGroups const& _m) -> Pattern {
+			bigint sum = bigint(A.d(_m)) + B.d(_m);
 			if (sum >= Pattern::WordSize)
 				return Builtins::AND(X, Word(0));
 			else
@@ -501,8 +509,8 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 	rules.push_back({
 		// SHR(B, SHR(A, X)) -> SHR(min(A+B, 256), X)
 		Builtins::SHR(B, Builtins::SHR(A, X)),
-		[=]() -> Pattern {
-			bigint sum = bigint(A.d()) + B.d();
+		[=](MatchGroups const& _m) -> Pattern {
+			bigint sum = bigint(A.d(_m)) + B.d(_m);
 			if (sum >= Pattern::WordSize)
 				return Builtins::AND(X, Word(0));
 			else
@@ -514,58 +522,58 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 	rules.push_back({
 		// SHR(B, SHL(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHR(B, Builtins::SHL(A, X)),
-		[=]() -> Pattern {
-			Word mask = shlWorkaround(~Word(0), unsigned(A.d())) >> unsigned(B.d());
+		[=](MatchGroups const& _m) -> Pattern {
+			Word mask = shlWorkaround(~Word(0), unsigned(A.d(_m))) >> unsigned(B.d(_m));
 
-			if (A.d() > B.d())
-				return Builtins::AND(Builtins::SHL(A.d() - B.d(), X), mask);
-			else if (B.d() > A.d())
-				return Builtins::AND(Builtins::SHR(B.d() - A.d(), X), mask);
+			if (A.d(_m) > B.d(_m))
+				return Builtins::AND(Builtins::SHL(A.d(_m) - B.d(_m), X), mask);
+			else if (B.d(_m) > A.d(_m))
+				return Builtins::AND(Builtins::SHR(B.d(_m) - A.d(_m), X), mask);
 			else
 				return Builtins::AND(X, mask);
 		},
-		[=] { return A.d() < Pattern::WordSize && B.d() < Pattern::WordSize; }
+		[=](MatchGroups const& _m) { return A.d(_m) < Pattern::WordSize && B.d(_m) < Pattern::WordSize; }
 	});
 
 	// Combine SHR-SHL by constant
 	rules.push_back({
 		// SHL(B, SHR(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHL(B, Builtins::SHR(A, X)),
-		[=]() -> Pattern {
-			Word mask = shlWorkaround((~Word(0)) >> unsigned(A.d()), unsigned(B.d()));
+		[=](MatchGroups const& _m) -> Pattern {
+			Word mask = shlWorkaround((~Word(0)) >> unsigned(A.d(_m)), unsigned(B.d(_m)));
 
-			if (A.d() > B.d())
-				return Builtins::AND(Builtins::SHR(A.d() - B.d(), X), mask);
-			else if (B.d() > A.d())
-				return Builtins::AND(Builtins::SHL(B.d() - A.d(), X), mask);
+			if (A.d(_m) > B.d(_m))
+				return Builtins::AND(Builtins::SHR(A.d(_m) - B.d(_m), X), mask);
+			else if (B.d(_m) > A.d(_m))
+				return Builtins::AND(Builtins::SHL(B.d(_m) - A.d(_m), X), mask);
 			else
 				return Builtins::AND(X, mask);
 		},
-		[=] { return A.d() < Pattern::WordSize && B.d() < Pattern::WordSize; }
+		[=](MatchGroups const& _m) { return A.d(_m) < Pattern::WordSize && B.d(_m) < Pattern::WordSize; }
 	});
 
 	// Move AND with constant across SHL and SHR by constant
 	for (auto instr: {Instruction::SHL, Instruction::SHR})
 	{
 		typename Builtins::PatternGeneratorInstance shiftOp{instr};
-		auto replacement = [=]() -> Pattern {
+		auto replacement = [=](MatchGroups const& _m) -> Pattern {
 			Word mask =
 				instr == Instruction::SHL ?
-				shlWorkaround(A.d(), unsigned(B.d())) :
-				A.d() >> unsigned(B.d());
-			return Builtins::AND(shiftOp(B.d(), X), std::move(mask));
+				shlWorkaround(A.d(_m), unsigned(B.d(_m))) :
+				A.d(_m) >> unsigned(B.d(_m));
+			return Builtins::AND(shiftOp(B.d(_m), X), std::move(mask));
 		};
 		rules.push_back({
 			// SH[L/R](B, AND(X, A)) -> AND(SH[L/R](B, X), [ A << B / A >> B ])
 			shiftOp(B, Builtins::AND(X, A)),
 			replacement,
-			[=] { return B.d() < Pattern::WordSize; }
+			[=](MatchGroups const& _m) { return B.d(_m) < Pattern::WordSize; }
 		});
 		rules.push_back({
 			// SH[L/R](B, AND(A, X)) -> AND(SH[L/R](B, X), [ A << B / A >> B ])
 			shiftOp(B, Builtins::AND(A, X)),
 			replacement,
-			[=] { return B.d() < Pattern::WordSize; }
+			[=](MatchGroups const& _m) { return B.d(_m) < Pattern::WordSize; }
 		});
 	}
 
@@ -578,25 +586,25 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 			// We might swap X and Y but this is not an issue anymore.
 			rules.push_back({
 				Builtins::AND(second, B),
-				[=]() -> Pattern { return Builtins::OR(Builtins::AND(X, A.d() & B.d()), Builtins::AND(Y, B)); }
+				[=](MatchGroups const& _m) -> Pattern { return Builtins::OR(Builtins::AND(X, A.d(_m) & B.d(_m)), Builtins::AND(Y, B)); }
 			});
 			rules.push_back({
 				Builtins::AND(B, second),
-				[=]() -> Pattern { return Builtins::OR(Builtins::AND(X, A.d() & B.d()), Builtins::AND(Y, B)); }
+				[=](MatchGroups const& _m) -> Pattern { return Builtins::OR(Builtins::AND(X, A.d(_m) & B.d(_m)), Builtins::AND(Y, B)); }
 			});
 		}
 
 	rules.push_back({
 		// MUL(X, SHL(Y, 1)) -> SHL(Y, X)
 		Builtins::MUL(X, Builtins::SHL(Y, Word(1))),
-		[=]() -> Pattern {
+		[=](MatchGroups const&) -> Pattern {
 			return Builtins::SHL(Y, X);
 		}
 	});
 	rules.push_back({
 		// MUL(SHL(X, 1), Y) -> SHL(X, Y)
 		Builtins::MUL(Builtins::SHL(X, Word(1)), Y),
-		[=]() -> Pattern {
+		[=](MatchGroups const&) -> Pattern {
 			return Builtins::SHL(X, Y);
 		}
 	});
@@ -604,73 +612,73 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 	rules.push_back({
 		// DIV(X, SHL(Y, 1)) -> SHR(Y, X)
 		Builtins::DIV(X, Builtins::SHL(Y, Word(1))),
-		[=]() -> Pattern {
+		[=](MatchGroups const&) -> Pattern {
 			return Builtins::SHR(Y, X);
 		}
 	});
 
-	std::function<bool()> feasibilityFunction = [=]() {
-		if (B.d() > Pattern::WordSize)
+	std::function<bool(MatchGroups const&)> feasibilityFunction = [=](MatchGroups const& _m) {
+		if (B.d(_m) > Pattern::WordSize)
 			return false;
-		unsigned bAsUint = static_cast<unsigned>(B.d());
-		return (A.d() & ((~Word(0)) >> bAsUint)) == ((~Word(0)) >> bAsUint);
+		unsigned bAsUint = static_cast<unsigned>(B.d(_m));
+		return (A.d(_m) & ((~Word(0)) >> bAsUint)) == ((~Word(0)) >> bAsUint);
 	};
 
 	rules.push_back({
 		// AND(A, SHR(B, X)) -> A & ((2^256-1) >> B) == ((2^256-1) >> B)
 		Builtins::AND(A, Builtins::SHR(B, X)),
-		[=]() -> Pattern { return Builtins::SHR(B, X); },
+		[=](MatchGroups const&) -> Pattern { return Builtins::SHR(B, X); },
 		feasibilityFunction
 	});
 
 	rules.push_back({
 		// AND(SHR(B, X), A) -> ((2^256-1) >> B) & A == ((2^256-1) >> B)
 		Builtins::AND(Builtins::SHR(B, X), A),
-		[=]() -> Pattern { return Builtins::SHR(B, X); },
+		[=](MatchGroups const&) -> Pattern { return Builtins::SHR(B, X); },
 		feasibilityFunction
 	});
 
 	rules.push_back({
 		// AND(SHL(Z, X), SHL(Z, Y)) -> SHL(Z, AND(X, Y))
 		Builtins::AND(Builtins::SHL(Z, X), Builtins::SHL(Z, Y)),
-		[=]() -> Pattern { return Builtins::SHL(Z, Builtins::AND(X, Y)); }
+		[=](MatchGroups const&) -> Pattern { return Builtins::SHL(Z, Builtins::AND(X, Y)); }
 	});
 
 	rules.push_back({
 		Builtins::BYTE(A, Builtins::SHL(B, X)),
-		[=]() -> Pattern { return Builtins::BYTE(A.d() + B.d() / 8, X); },
-		[=] { return B.d() % 8 == 0 && A.d() <= 32 && B.d() <= 256; }
+		[=](MatchGroups const& _m) -> Pattern { return Builtins::BYTE(A.d(_m) + B.d(_m) / 8, X); },
+		[=](MatchGroups const& _m) { return B.d(_m) % 8 == 0 && A.d(_m) <= 32 && B.d(_m) <= 256; }
 	});
 
 	rules.push_back({
 		Builtins::BYTE(A, Builtins::SHR(B, X)),
-		[=]() -> Pattern { return Word(0); },
-		[=] { return A.d() < B.d() / 8; }
+		[=](MatchGroups const&) -> Pattern { return Word(0); },
+		[=](MatchGroups const& _m) { return A.d(_m) < B.d(_m) / 8; }
 	});
 
 	rules.push_back({
 		Builtins::BYTE(A, Builtins::SHR(B, X)),
-		[=]() -> Pattern { return Builtins::BYTE(A.d() - B.d() / 8, X); },
-		[=] {
-			return B.d() % 8 == 0 && A.d() < Pattern::WordSize / 8 && B.d() <= Pattern::WordSize && A.d() >= B.d() / 8;
+		[=](MatchGroups const& _m) -> Pattern { return Builtins::BYTE(A.d(_m) - B.d(_m) / 8, X); },
+		[=](MatchGroups const& _m) {
+			return B.d(_m) % 8 == 0 && A.d(_m) < Pattern::WordSize / 8 && B.d(_m) <= Pattern::WordSize && A.d(_m) >= B.d(_m) / 8;
 		}
 	});
 
 	rules.push_back({
 		Builtins::SHL(A, Builtins::SIGNEXTEND(B, X)),
-		[=]() -> Pattern { return Builtins::SIGNEXTEND((A.d() >> 3) + B.d(), Builtins::SHL(A, X)); },
-		[=] { return (A.d() & 7) == 0 && A.d() <= Pattern::WordSize && B.d() <= Pattern::WordSize / 8; }
+		[=](MatchGroups const& _m) -> Pattern { return Builtins::SIGNEXTEND((A.d(_m) >> 3) + B.d(_m), Builtins::SHL(A, X)); },
+		[=](MatchGroups const& _m) { return (A.d(_m) & 7) == 0 && A.d(_m) <= Pattern::WordSize && B.d(_m) <= Pattern::WordSize / 8; }
 	});
 
 	rules.push_back({
 		Builtins::SIGNEXTEND(A, Builtins::SHR(B, X)),
-		[=]() -> Pattern { return Builtins::SAR(B, X); },
-		[=] {
+		[=](MatchGroups const&) -> Pattern { return Builtins::SAR(B, X); },
+		[=](MatchGroups const& _m) {
 			return
-				B.d() % 8 == 0 &&
-				B.d() <= Pattern::WordSize &&
-				A.d() <= Pattern::WordSize &&
-				(Pattern::WordSize - B.d()) / 8 == A.d() + 1;
+				B.d(_m) % 8 == 0 &&
+				B.d(_m) <= Pattern::WordSize &&
+				A.d(_m) <= Pattern::WordSize &&
+				(Pattern::WordSize - B.d(_m)) / 8 == A.d(_m) + 1;
 		}
 	});
 
@@ -687,6 +695,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart8(
 )
 {
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	std::vector<SimplificationRule<Pattern>> rules;
 
 	// move constants across subtractions
@@ -694,39 +703,39 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart8(
 		{
 			// X - A -> X + (-A)
 			Builtins::SUB(X, A),
-			[=]() -> Pattern { return Builtins::ADD(X, 0 - A.d()); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::ADD(X, 0 - A.d(_m)); }
 		}, {
 			// (X + A) - Y -> (X - Y) + A
 			Builtins::SUB(Builtins::ADD(X, A), Y),
-			[=]() -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), A); }
+			[=](MatchGroups const&) -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), A); }
 		}, {
 			// (A + X) - Y -> (X - Y) + A
 			Builtins::SUB(Builtins::ADD(A, X), Y),
-			[=]() -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), A); }
+			[=](MatchGroups const&) -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), A); }
 		}, {
 			// X - (Y + A) -> (X - Y) + (-A)
 			Builtins::SUB(X, Builtins::ADD(Y, A)),
-			[=]() -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), 0 - A.d()); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), 0 - A.d(_m)); }
 		}, {
 			// X - (A + Y) -> (X - Y) + (-A)
 			Builtins::SUB(X, Builtins::ADD(A, Y)),
-			[=]() -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), 0 - A.d()); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), 0 - A.d(_m)); }
 		}, {
 			// (X - A) - Y -> (X - Y) - A
 			Builtins::SUB(Builtins::SUB(X, A), Y),
-			[=]() -> Pattern { return Builtins::SUB(Builtins::SUB(X, Y), A); }
+			[=](MatchGroups const&) -> Pattern { return Builtins::SUB(Builtins::SUB(X, Y), A); }
 		}, {
 			// (A - X) - Y -> A - (X + Y)
 			Builtins::SUB(Builtins::SUB(A, X), Y),
-			[=]() -> Pattern { return Builtins::SUB(A, Builtins::ADD(X, Y)); }
+			[=](MatchGroups const&) -> Pattern { return Builtins::SUB(A, Builtins::ADD(X, Y)); }
 		}, {
 			// X - (Y - A) -> (X - Y) + A
 			Builtins::SUB(X, Builtins::SUB(Y, A)),
-			[=]() -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), A.d()); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::ADD(Builtins::SUB(X, Y), A.d(_m)); }
 		}, {
 			// X - (A - Y) -> (X + Y) + (-A)
 			Builtins::SUB(X, Builtins::SUB(A, Y)),
-			[=]() -> Pattern { return Builtins::ADD(Builtins::ADD(X, Y), 0 - A.d()); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::ADD(Builtins::ADD(X, Y), 0 - A.d(_m)); }
 		}
 	};
 	return rules;
@@ -745,49 +754,49 @@ std::vector<SimplificationRule<Pattern>> evmRuleList(
 )
 {
 	using Builtins = typename Pattern::Builtins;
+	using MatchGroups = typename Pattern::MatchGroups;
 	using Word = typename Pattern::Word;
 	std::vector<SimplificationRule<Pattern>> rules;
 
 	if (_evmVersion.hasSelfBalance())
 		rules.push_back({
 			Builtins::BALANCE(Instruction::ADDRESS),
-			[]() -> Pattern { return Instruction::SELFBALANCE; }
+			[](MatchGroups const&) -> Pattern { return Instruction::SELFBALANCE; }
 		});
 
 	rules.emplace_back(
 		Builtins::EXP(0, X),
-		[=]() -> Pattern { return Builtins::ISZERO(X); }
+		[=](MatchGroups const&) -> Pattern { return Builtins::ISZERO(X); }
 	);
 	rules.emplace_back(
 		Builtins::EXP(1, X),
-		[=]() -> Pattern { return Word(1); }
+		[=](MatchGroups const&) -> Pattern { return Word(1); }
 	);
 	if (_evmVersion.hasBitwiseShifting())
 	{
 		rules.emplace_back(
 			Builtins::EXP(2, X),
-			[=]() -> Pattern { return Builtins::SHL(X, 1); }
+			[=](MatchGroups const&) -> Pattern { return Builtins::SHL(X, 1); }
 		);
 		rules.emplace_back(
 			Builtins::MUL(A, X),
-			[=]() -> Pattern { return Builtins::SHL(u256(*binaryLogarithm(A.d())), X); },
-			[=] { return binaryLogarithm(A.d()).has_value(); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::SHL(u256(*binaryLogarithm(A.d(_m))), X); },
+			[=](MatchGroups const& _m) { return binaryLogarithm(A.d(_m)).has_value(); }
 		);
 		rules.emplace_back(
 			Builtins::MUL(X, A),
-			[=]() -> Pattern { return Builtins::SHL(u256(*binaryLogarithm(A.d())), X); },
-			[=] { return binaryLogarithm(A.d()).has_value(); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::SHL(u256(*binaryLogarithm(A.d(_m))), X); },
+			[=](MatchGroups const& _m) { return binaryLogarithm(A.d(_m)).has_value(); }
 		);
 		rules.emplace_back(
 			Builtins::DIV(X, A),
-			[=]() -> Pattern { return Builtins::SHR(u256(*binaryLogarithm(A.d())), X); },
-			[=] { return binaryLogarithm(A.d()).has_value(); }
+			[=](MatchGroups const& _m) -> Pattern { return Builtins::SHR(u256(*binaryLogarithm(A.d(_m))), X); },
+			[=](MatchGroups const& _m) { return binaryLogarithm(A.d(_m)).has_value(); }
 		);
 	}
 	rules.emplace_back(
 		Builtins::EXP(Word(-1), X),
-		[=]() -> Pattern
-		{
+		[=](MatchGroups const&) -> Pattern {
 			return Builtins::SUB(
 				Builtins::ISZERO(Builtins::AND(X, Word(1))),
 				Builtins::AND(X, Word(1))
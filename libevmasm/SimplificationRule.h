@@ -32,14 +32,18 @@ namespace solidity::evmasm
  * Rule that contains a pattern, an action that can be applied
  * after the pattern has matched and optional condition to check if the
  * action should be applied.
+ * The action and the condition are called with the expressions the match groups
+ * of the pattern were bound to.
  */
 template <class Pattern>
 struct SimplificationRule
 {
+	using MatchGroups = typename Pattern::MatchGroups;
+
 	SimplificationRule(
 		Pattern _pattern,
-		std::function<Pattern()> _action,
-		std::function<bool()> _feasible = {}
+		std::function<Pattern(MatchGroups const&)> _action,
+		std::function<bool(MatchGroups const&)> _feasible = {}
 	):
 		pattern(std::move(_pattern)),
 		action(std::move(_action)),
@@ -47,8 +51,8 @@ struct SimplificationRule
 	{}
 
 	Pattern pattern;
-	std::function<Pattern()> action;
-	std::function<bool()> feasible;
+	std::function<Pattern(MatchGroups const&)> action;
+	std::function<bool(MatchGroups const&)> feasible;
 };
 
 template <typename Pattern>
@@ -36,23 +36,20 @@ using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 
-SimplificationRule<Pattern> const* Rules::findFirstMatch(
+std::optional<Rules::Match> Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
-)
+) const
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
 	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
 	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
-
-		resetMatchGroups();
+		Pattern::MatchGroups matchGroups;
+		if (rule.pattern.matches(_expr, _classes, matchGroups))
+			if (!rule.feasible || rule.feasible(matchGroups))
+				return Match{&rule, std::move(matchGroups)};
 	}
-	return nullptr;
+	return std::nullopt;
 }
 
 bool Rules::isInitialized() const
@@ -83,13 +80,13 @@ Rules::Rules()
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(std::nullopt, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
@@ -102,26 +99,20 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups)
-{
-	m_matchGroup = _group;
-	m_matchGroups = &_matchGroups;
-}
-
-bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes) const
+bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes, MatchGroups& _matchGroups) const
 {
 	if (!matchesBaseItem(_expr.item))
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		if (!_matchGroups.count(m_matchGroup))
+			_matchGroups[m_matchGroup] = &_expr;
+		else if (_matchGroups[m_matchGroup]->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
 	for (size_t i = 0; i < m_arguments.size(); ++i)
-		if (!m_arguments[i].matches(_classes.representative(_expr.arguments[i]), _classes))
+		if (!m_arguments[i].matches(_classes.representative(_expr.arguments[i]), _classes, _matchGroups))
 			return false;
 	return true;
 }
@@ -185,12 +176,12 @@ bool Pattern::matchesBaseItem(AssemblyItem const* _item) const
 	return true;
 }
 
-Pattern::Expression const& Pattern::matchGroupValue() const
+Pattern::Expression const& Pattern::matchGroupValue(MatchGroups const& _matchGroups) const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	auto it = _matchGroups.find(m_matchGroup);
+	assertThrow(it != _matchGroups.end() && it->second, OptimizerException, "");
+	return *it->second;
 }
 
 u256 const& Pattern::data() const
@@ -199,12 +190,16 @@ u256 const& Pattern::data() const
 	return *m_data;
 }
 
-ExpressionTemplate::ExpressionTemplate(Pattern const& _pattern, langutil::DebugData::ConstPtr const& _debugData)
+ExpressionTemplate::ExpressionTemplate(
+	Pattern const& _pattern,
+	Pattern::MatchGroups const& _matchGroups,
+	langutil::DebugData::ConstPtr const& _debugData
+)
 {
 	if (_pattern.matchGroup())
 	{
 		hasId = true;
-		id = _pattern.id();
+		id = _pattern.id(_matchGroups);
 	}
 	else
 	{
@@ -212,7 +207,7 @@ ExpressionTemplate::ExpressionTemplate(Pattern const& _pattern, langutil::DebugD
 		item = _pattern.toAssemblyItem(_debugData);
 	}
 	for (auto const& arg: _pattern.arguments())
-		arguments.emplace_back(arg, _debugData);
+		arguments.emplace_back(arg, _matchGroups, _debugData);
 }
 
 std::string ExpressionTemplate::toString() const
@@ -30,6 +30,8 @@
 #include <libsolutil/CommonData.h>
 
 #include <functional>
+#include <map>
+#include <optional>
 #include <vector>
 
 namespace solidity::langutil
@@ -56,12 +58,19 @@ public:
 
 	Rules();
 
-	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
-	SimplificationRule<Pattern> const* findFirstMatch(
+	/// Rule that matched an expression, together with the expressions bound to its match groups.
+	struct Match
+	{
+		SimplificationRule<Pattern> const* rule = nullptr;
+		std::map<unsigned, Expression const*> matchGroups;
+	};
+
+	/// @returns the first matching rule and the expressions bound to its match groups, or nullopt
+	/// if no rule matches.
+	std::optional<Match> findFirstMatch(
 		Expression const& _expr,
 		ExpressionClasses const& _classes
-	);
+	) const;
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
 	/// by the constructor, but we had some issues with static initialization.
@@ -71,9 +80,6 @@ private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
-
-	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
@@ -81,14 +87,16 @@ private:
 
 /**
  * Pattern to match against an expression.
- * Also stores matched expressions to retrieve them later, for constructing new expressions using
- * ExpressionTemplate.
+ * Matching binds the expressions matched by the match groups, which are used to retrieve them
+ * later, for constructing new expressions using ExpressionTemplate.
  */
 class Pattern
 {
 public:
 	using Expression = ExpressionClasses::Expression;
 	using Id = ExpressionClasses::Id;
+	/// Expressions bound to the match groups of a pattern by matching it, indexed by match group.
+	using MatchGroups = std::map<unsigned, Expression const*>;
 
 	using Builtins = evmasm::EVMBuiltins<Pattern>;
 	static constexpr size_t WordSize = 256;
@@ -107,17 +115,19 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group) { m_matchGroup = _group; }
 	unsigned matchGroup() const { return m_matchGroup; }
-	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
+	/// @returns true if the pattern matches @a _expr and, in that case, binds the expressions
+	/// matched by its match groups in @a _matchGroups.
+	bool matches(Expression const& _expr, ExpressionClasses const& _classes, MatchGroups& _matchGroups) const;
 
 	AssemblyItem toAssemblyItem(langutil::DebugData::ConstPtr _debugData) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
 	/// @returns the id of the matched expression if this pattern is part of a match group.
-	Id id() const { return matchGroupValue().id; }
+	Id id(MatchGroups const& _matchGroups) const { return matchGroupValue(_matchGroups).id; }
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 const& d() const { return matchGroupValue().item->data(); }
+	u256 d(MatchGroups const& _matchGroups) const { return matchGroupValue(_matchGroups).item->data(); }
 
 	std::string toString() const;
 
@@ -130,7 +140,7 @@ public:
 
 private:
 	bool matchesBaseItem(AssemblyItem const* _item) const;
-	Expression const& matchGroupValue() const;
+	Expression const& matchGroupValue(MatchGroups const& _matchGroups) const;
 	u256 const& data() const;
 
 	AssemblyItemType m_type;
@@ -139,7 +149,6 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
 /**
@@ -149,7 +158,12 @@ struct ExpressionTemplate
 {
 	using Expression = ExpressionClasses::Expression;
 	using Id = ExpressionClasses::Id;
-	explicit ExpressionTemplate(Pattern const& _pattern, langutil::DebugData::ConstPtr const& _debugData);
+	/// @param _matchGroups the expressions bound to the match groups of @a _pattern.
+	ExpressionTemplate(
+		Pattern const& _pattern,
+		Pattern::MatchGroups const& _matchGroups,
+		langutil::DebugData::ConstPtr const& _debugData
+	);
 	std::string toString() const;
 	bool hasId = false;
 	/// Id of the matched expression, if available.
@@ -37,6 +37,22 @@ ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 	return *this;
 }
 
+bool ErrorReporter::appendWithinLimits(ErrorReporter const& _errorReporter)
+{
+	if (
+		m_errorCount + _errorReporter.m_errorCount > c_maxErrorsAllowed ||
+		m_warningCount + _errorReporter.m_warningCount >= c_maxWarningsAllowed ||
+		m_infoCount + _errorReporter.m_infoCount >= c_maxInfosAllowed
+	)
+		return false;
+
+	m_errorList += _errorReporter.m_errorList;
+	m_errorCount += _errorReporter.m_errorCount;
+	m_warningCount += _errorReporter.m_warningCount;
+	m_infoCount += _errorReporter.m_infoCount;
+	return true;
+}
+
 void ErrorReporter::warning(ErrorId _error, std::string const& _description)
 {
 	error(_error, Error::Type::Warning, SourceLocation(), _description);
@@ -53,6 +53,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Reports the errors of @a _errorReporter as if they had been reported to this reporter.
+	/// Does nothing and @returns false if that would reach the maximum number of errors,
+	/// warnings or infos, since the reported errors would then be different.
+	bool appendWithinLimits(ErrorReporter const& _errorReporter);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -65,17 +65,17 @@ void CHCSmtLib2Interface::reset()
 
 void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 {
-	smtAssert(_expr.sort);
-	smtAssert(_expr.sort->kind == Kind::Function);
-	if (!m_variables.count(_expr.name))
+	smtAssert(_expr.sort());
+	smtAssert(_expr.sort()->kind == Kind::Function);
+	if (!m_variables.count(_expr.name()))
 	{
-		auto fSort = std::dynamic_pointer_cast<FunctionSort>(_expr.sort);
+		auto fSort = std::dynamic_pointer_cast<FunctionSort>(_expr.sort());
 		std::string domain = toSmtLibSort(fSort->domain);
 		// Relations are predicates which have implicit codomain Bool.
-		m_variables.insert(_expr.name);
+		m_variables.insert(_expr.name());
 		write(
 			"(declare-fun |" +
-			_expr.name +
+			_expr.name() +
 			"| " +
 			domain +
 			" Bool)"
@@ -95,7 +95,19 @@ void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*
 std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
 {
 	std::string query = dumpQuery(_block);
-	std::string response = querySolver(query);
+	if (m_smtCallback)
+		setupSmtCallback();
+	return queryResult(query, solveQuery(query));
+}
+
+std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::queryResult(
+	std::string const& _query,
+	std::optional<std::string> const& _response
+)
+{
+	if (!_response)
+		m_unhandledQueries.push_back(_query);
+	std::string response = _response.value_or("unknown\n");
 
 	CheckResult result;
 	// TODO proper parsing
@@ -178,22 +190,20 @@ void CHCSmtLib2Interface::write(std::string _data)
 	m_accumulatedOutput += std::move(_data) + "\n";
 }
 
-std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
+std::optional<std::string> CHCSmtLib2Interface::solveQuery(std::string const& _query) const
 {
-	util::h256 inputHash = util::keccak256(_input);
+	util::h256 inputHash = util::keccak256(_query);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
 
 	if (m_smtCallback)
 	{
-		setupSmtCallback();
-		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _query);
 		if (result.success)
 			return result.responseOrErrorMessage;
 	}
 
-	m_unhandledQueries.push_back(_input);
-	return "unknown\n";
+	return std::nullopt;
 }
 
 std::string CHCSmtLib2Interface::dumpQuery(Expression const& _expr)
@@ -203,7 +213,7 @@ std::string CHCSmtLib2Interface::dumpQuery(Expression const& _expr)
 	s
 		<< createHeaderAndDeclarations()
 		<< m_accumulatedOutput << std::endl
-		<< createQueryAssertion(_expr.name) << std::endl
+		<< createQueryAssertion(_expr.name()) << std::endl
 		<< "(check-sat)" << std::endl;
 
 	return s.str();
@@ -392,7 +402,7 @@ public:
 						{
 							std::set<std::string>
 								boolOperators{"and", "or", "not", "=", "<", ">", "<=", ">=", "=>"};
-							sort = contains(boolOperators, op) ? SortProvider::boolSort : arguments.back().sort;
+							sort = contains(boolOperators, op) ? SortProvider::boolSort : arguments.back().sort();
 							return smtutil::Expression(op, std::move(arguments), std::move(sort));
 						}
 						smtAssert(false, "Unhandled case in expression conversion");
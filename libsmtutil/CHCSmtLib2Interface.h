@@ -52,6 +52,22 @@ public:
 
 	std::string dumpQuery(Expression const& _expr);
 
+	/// Configures the solver invoked by the callback. Has to be called before solveQuery.
+	virtual void setupSmtCallback() {}
+
+	/// Solves @a _query, which was created by dumpQuery, using the given responses or the callback.
+	/// Does not modify the interface, so that independent queries can be solved concurrently.
+	/// @returns the response of the solver or nullopt if the query could not be handled.
+	std::optional<std::string> solveQuery(std::string const& _query) const;
+
+	/// Translates @a _response, the response of the solver to the query @a _query created by
+	/// dumpQuery, into the solving result and an invariant.
+	/// An unhandled query is recorded and results in UNKNOWN.
+	std::tuple<CheckResult, Expression, CexGraph> queryResult(
+		std::string const& _query,
+		std::optional<std::string> const& _response
+	);
+
 	std::vector<std::string> unhandledQueries() const { return m_unhandledQueries; }
 
 	SMTLib2Interface* smtlib2Interface() const { return m_smtlib2.get(); }
@@ -72,15 +88,9 @@ protected:
 	std::string createQueryAssertion(std::string name);
 	std::string createHeaderAndDeclarations();
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
-
 	/// Translates CHC solver response with a model to our representation of invariants. Returns None on error.
 	std::optional<smtutil::Expression> invariantsFromSolverResponse(std::string const& response) const;
 
-	/// Hook to setup external solver call
-	virtual void setupSmtCallback() {}
-
 	/// Used to access toSmtLibSort, SExpr, and handle variables.
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
 
@@ -26,6 +26,7 @@
 #include <range/v3/algorithm/find_if.hpp>
 
 #include <array>
+#include <functional>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -116,10 +117,45 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 std::pair<CheckResult, std::vector<std::string>> SMTLib2Interface::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
-	std::string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	m_interrupted = false;
+	if (m_session && !m_session->failed())
+	{
+		// The helper variables of the query are declared in their own frame, which is removed again.
+		std::string commands =
+			sessionUpdateCommands() +
+			"(push 1)\n" +
+			checkSatAndGetValuesCommand(_expressionsToEvaluate) +
+			"(pop 1)\n";
+		if (std::optional<std::string> response = m_session->run(commands))
+			return checkResult(commands, response, _expressionsToEvaluate);
+		// An interrupted solver still completes the commands, otherwise it starts from scratch.
+		if (!m_session->running())
+			m_sessionFrames.clear();
+		// A solver that was interrupted or did not respond in time is treated like a timeout.
+		// Otherwise the solver is not available and the query is sent to the callback.
+		if (!m_session->failed())
+			return {CheckResult::UNKNOWN, {}};
+	}
+
+	std::string query = dumpQuery(_expressionsToEvaluate);
+	if (m_smtCallback)
+		setupSmtCallback();
+	std::optional<std::string> response = solveQuery(query);
+	// The response of an interrupted solver is incomplete and must not be recorded as unhandled query.
+	if (m_interrupted)
+		return {CheckResult::UNKNOWN, {}};
+	return checkResult(query, response, _expressionsToEvaluate);
+}
+
+std::pair<CheckResult, std::vector<std::string>> SMTLib2Interface::checkResult(
+	std::string const& _query,
+	std::optional<std::string> const& _response,
+	std::vector<Expression> const& _expressionsToEvaluate
+)
+{
+	if (!_response)
+		m_unhandledQueries.push_back(_query);
+	std::string response = _response.value_or("unknown\n");
 
 	CheckResult result;
 	// TODO proper parsing
@@ -140,14 +176,30 @@ std::pair<CheckResult, std::vector<std::string>> SMTLib2Interface::check(std::ve
 
 std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
-	if (_expr.arguments.empty())
-		return _expr.name;
+	if (m_letBindings)
+		return toSExprWithLetBindings(_expr);
+	return toSExpr(_expr, {});
+}
+
+std::string SMTLib2Interface::toSExpr(Expression const& _expr, LetNames const& _names)
+{
+	auto argumentToSExpr = [&](Expression const& _argument) {
+		if (auto it = _names.find(_argument); it != _names.end())
+			return it->second;
+		// Names bound outside of a quantifier could capture its variables.
+		if (_argument.name() == "forall" || _argument.name() == "exists")
+			return toSExpr(_argument, {});
+		return toSExpr(_argument, _names);
+	};
+
+	if (_expr.arguments().empty())
+		return _expr.name();
 
 	std::string sexpr = "(";
-	if (_expr.name == "int2bv")
+	if (_expr.name() == "int2bv")
 	{
-		size_t size = std::stoul(_expr.arguments[1].name);
-		auto arg = toSExpr(_expr.arguments.front());
+		size_t size = std::stoul(_expr.arguments()[1].name());
+		auto arg = argumentToSExpr(_expr.arguments().front());
 		auto int2bv = "(_ int2bv " + std::to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
 		sexpr += std::string("ite ") +
@@ -155,18 +207,18 @@ std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 			"(" + int2bv + " " + arg + ") " +
 			"(bvneg (" + int2bv + " (- " + arg + ")))";
 	}
-	else if (_expr.name == "bv2int")
+	else if (_expr.name() == "bv2int")
 	{
-		auto intSort = std::dynamic_pointer_cast<IntSort>(_expr.sort);
+		auto intSort = std::dynamic_pointer_cast<IntSort>(_expr.sort());
 		smtAssert(intSort, "");
 
-		auto arg = toSExpr(_expr.arguments.front());
+		auto arg = argumentToSExpr(_expr.arguments().front());
 		auto nat = "(bv2nat " + arg + ")";
 
 		if (!intSort->isSigned)
 			return nat;
 
-		auto bvSort = std::dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
+		auto bvSort = std::dynamic_pointer_cast<BitVectorSort>(_expr.arguments().front().sort());
 		smtAssert(bvSort, "");
 		auto size = std::to_string(bvSort->size);
 		auto pos = std::to_string(bvSort->size - 1);
@@ -177,42 +229,97 @@ std::string SMTLib2Interface::toSExpr(Expression const& _expr)
 			nat + " " +
 			"(- (bv2nat (bvneg " + arg + ")))";
 	}
-	else if (_expr.name == "const_array")
+	else if (_expr.name() == "const_array")
 	{
-		smtAssert(_expr.arguments.size() == 2, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments.at(0).sort);
+		smtAssert(_expr.arguments().size() == 2, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments().at(0).sort());
 		smtAssert(sortSort, "");
 		auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
 		sexpr += "(as const " + toSmtLibSort(arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		sexpr += argumentToSExpr(_expr.arguments().at(1));
 	}
-	else if (_expr.name == "tuple_get")
+	else if (_expr.name() == "tuple_get")
 	{
-		smtAssert(_expr.arguments.size() == 2, "");
-		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
-		size_t index = std::stoul(_expr.arguments.at(1).name);
+		smtAssert(_expr.arguments().size() == 2, "");
+		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.arguments().at(0).sort());
+		size_t index = std::stoul(_expr.arguments().at(1).name());
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
+		sexpr += "|" + tupleSort->members.at(index) + "| " + argumentToSExpr(_expr.arguments().at(0));
 	}
-	else if (_expr.name == "tuple_constructor")
+	else if (_expr.name() == "tuple_constructor")
 	{
-		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.sort);
+		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(_expr.sort());
 		smtAssert(tupleSort, "");
 		sexpr += "|" + tupleSort->name + "|";
-		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		for (auto const& arg: _expr.arguments())
+			sexpr += " " + argumentToSExpr(arg);
 	}
 	else
 	{
-		sexpr += _expr.name;
-		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		sexpr += _expr.name();
+		for (auto const& arg: _expr.arguments())
+			sexpr += " " + argumentToSExpr(arg);
 	}
 	sexpr += ")";
 	return sexpr;
 }
 
+std::string SMTLib2Interface::toSExprWithLetBindings(Expression const& _expr)
+{
+	// Counts the uses of every subterm and computes its height, visiting the arguments
+	// of every subterm only once. The subterms of quantifiers are not shared.
+	struct Info
+	{
+		size_t uses = 0;
+		size_t height = 0;
+	};
+	std::unordered_map<Expression, Info, ExpressionHash, ExpressionIdentical> infos;
+	// The subterms in the order in which they are printed, so that the bindings are deterministic.
+	std::vector<Expression> subterms;
+	std::function<size_t(Expression const&)> visit = [&](Expression const& _subterm) -> size_t {
+		Info& info = infos[_subterm];
+		if (info.uses++ > 0)
+			return info.height;
+		size_t height = 0;
+		if (_subterm.name() != "forall" && _subterm.name() != "exists")
+			for (auto const& argument: _subterm.arguments())
+				height = std::max(height, visit(argument) + 1);
+		subterms.push_back(_subterm);
+		// The reference might have been invalidated by the recursive calls.
+		return infos[_subterm].height = height;
+	};
+	visit(_expr);
+
+	// Shared subterms of the same height cannot contain each other and are bound by the same let.
+	// Leaves are not bound since their names are not longer than the names of the bindings.
+	std::map<size_t, std::vector<Expression>> sharedByHeight;
+	for (auto const& subterm: subterms)
+		if (Info const& info = infos.at(subterm); info.uses > 1 && !subterm.arguments().empty())
+			sharedByHeight[info.height].push_back(subterm);
+	if (sharedByHeight.empty())
+		return toSExpr(_expr, {});
+
+	LetNames names;
+	std::vector<std::string> bindings;
+	for (auto const& [height, shared]: sharedByHeight)
+	{
+		std::string binding;
+		for (auto const& subterm: shared)
+		{
+			std::string name = "|let " + std::to_string(names.size()) + "|";
+			binding += "(" + name + " " + toSExpr(subterm, names) + ")";
+			names.emplace(subterm, std::move(name));
+		}
+		bindings.emplace_back(std::move(binding));
+	}
+
+	std::string sexpr = toSExpr(_expr, names);
+	for (auto binding = bindings.rbegin(); binding != bindings.rend(); ++binding)
+		sexpr = "(let (" + *binding + ") " + sexpr + ")";
+	return sexpr;
+}
+
 std::string SMTLib2Interface::toSmtLibSort(solidity::smtutil::SortPointer _sort)
 {
 	if (!m_sortNames.count(_sort))
@@ -274,6 +381,48 @@ void SMTLib2Interface::write(std::string _data)
 	m_accumulatedOutput.back() += std::move(_data) + "\n";
 }
 
+void SMTLib2Interface::interrupt()
+{
+	m_interrupted = true;
+	if (m_session)
+		m_session->interrupt();
+}
+
+std::string SMTLib2Interface::sessionUpdateCommands()
+{
+	std::vector<std::string> const& frames = m_accumulatedOutput;
+	size_t unchanged = 0;
+	while (
+		unchanged < m_sessionFrames.size() &&
+		unchanged < frames.size() &&
+		m_sessionFrames[unchanged] == frames[unchanged]
+	)
+		++unchanged;
+	// Commands are only ever appended to the top frame, so the first changed frame can be
+	// extended once the frames above it have been removed.
+	bool const extend =
+		unchanged < m_sessionFrames.size() &&
+		unchanged < frames.size() &&
+		boost::starts_with(frames[unchanged], m_sessionFrames[unchanged]);
+	size_t const kept = extend ? unchanged + 1 : unchanged;
+
+	std::string commands;
+	if (kept == 0 && !m_sessionFrames.empty())
+		commands += "(reset)\n";
+	else if (kept > 0 && m_sessionFrames.size() > kept)
+		commands += "(pop " + std::to_string(m_sessionFrames.size() - kept) + ")\n";
+	if (extend)
+		commands += frames[unchanged].substr(m_sessionFrames[unchanged].size());
+	for (size_t i = kept; i < frames.size(); ++i)
+	{
+		if (i > 0)
+			commands += "(push 1)\n";
+		commands += frames[i];
+	}
+	m_sessionFrames = frames;
+	return commands;
+}
+
 std::string SMTLib2Interface::checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate)
 {
 	std::string command;
@@ -285,8 +434,8 @@ std::string SMTLib2Interface::checkSatAndGetValuesCommand(std::vector<Expression
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 		{
 			auto const& e = _expressionsToEvaluate.at(i);
-			smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + std::to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+			smtAssert(e.sort()->kind == Kind::Int || e.sort()->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+			command += "(declare-const |EVALEXPR_" + std::to_string(i) + "| " + (e.sort()->kind == Kind::Int ? "Int" : "Bool") + ")\n";
 			command += "(assert (= |EVALEXPR_" + std::to_string(i) + "| " + toSExpr(e) + "))\n";
 		}
 		command += "(check-sat)\n";
@@ -315,20 +464,18 @@ std::vector<std::string> SMTLib2Interface::parseValues(std::string::const_iterat
 	return values;
 }
 
-std::string SMTLib2Interface::querySolver(std::string const& _input)
+std::optional<std::string> SMTLib2Interface::solveQuery(std::string const& _query) const
 {
-	h256 inputHash = keccak256(_input);
+	h256 inputHash = keccak256(_query);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
 	if (m_smtCallback)
 	{
-		setupSmtCallback();
-		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _query);
 		if (result.success)
 			return result.responseOrErrorMessage;
 	}
-	m_unhandledQueries.push_back(_input);
-	return "unknown\n";
+	return std::nullopt;
 }
 
 std::string SMTLib2Interface::dumpQuery(std::vector<Expression> const& _expressionsToEvaluate)
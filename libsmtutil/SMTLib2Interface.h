@@ -25,15 +25,45 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 
+#include <atomic>
 #include <cstdio>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+/**
+ * Connection to an SMT solver that keeps its assertion stack between queries,
+ * so that SMT-LIB2 commands can be sent incrementally.
+ */
+class SMTLib2Session
+{
+public:
+	virtual ~SMTLib2Session() = default;
+
+	/// Sends @a _commands to the solver.
+	/// @returns the output of the solver for the commands, or nullopt if it did not respond in time,
+	/// crashed or was interrupted. Unless running() is true afterwards, the solver has lost its state
+	/// and the next call starts with an empty assertion stack.
+	virtual std::optional<std::string> run(std::string const& _commands) = 0;
+
+	/// Makes a call to run() on another thread return nullopt as soon as possible.
+	virtual void interrupt() = 0;
+
+	/// @returns true if the solver is not available, in which case run() always fails.
+	virtual bool failed() const = 0;
+
+	/// @returns true if the solver is running and keeps the assertion stack built by all commands
+	/// sent so far, including those of interrupted calls to run().
+	virtual bool running() const = 0;
+};
+
 class SMTLib2Interface: public SolverInterface
 {
 public:
@@ -56,11 +86,18 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	/// Makes a running check() discard the response of the solver and return UNKNOWN.
+	/// Subclasses that know how to stop the solver invoked by the callback do so in addition.
+	void interrupt() override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
+	/// Makes toSExpr bind subterms that occur more than once to a name using let, so that they
+	/// are printed only once. Not done by default since it changes the queries, which are also
+	/// the keys of SMT-LIB2 responses given in advance.
+	void enableLetBindings() { m_letBindings = true; }
 	std::string toSmtLibSort(SortPointer _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
@@ -71,21 +108,43 @@ public:
 
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
-protected:
+	/// Configures the solver invoked by the callback. Has to be called before solveQuery.
 	virtual void setupSmtCallback() {}
 
+	/// Solves @a _query, which was created by dumpQuery, using the given responses or the callback.
+	/// Does not modify the interface, so that independent queries can be solved concurrently.
+	/// @returns the response of the solver or nullopt if the query could not be handled.
+	std::optional<std::string> solveQuery(std::string const& _query) const;
+
+	/// Translates @a _response, the response of the solver to the query @a _query created by
+	/// dumpQuery(@a _expressionsToEvaluate), into the result of the check.
+	/// An unhandled query is recorded and results in UNKNOWN.
+	std::pair<CheckResult, std::vector<std::string>> checkResult(
+		std::string const& _query,
+		std::optional<std::string> const& _response,
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
+
+protected:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
 	void write(std::string _data);
 
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
+	/// @returns the commands that turn the assertion stack known to the solver of m_session
+	/// into m_accumulatedOutput, re-sending only the frames that changed.
+	std::string sessionUpdateCommands();
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
-
 	std::string toSmtLibSortInternal(SortPointer _sort);
 
+	using LetNames = std::unordered_map<Expression, std::string, ExpressionHash, ExpressionIdentical>;
+	/// @returns the s-expression of @a _expr, in which the arguments that have a name in @a _names
+	/// are replaced by that name.
+	std::string toSExpr(Expression const& _expr, LetNames const& _names);
+	/// @returns the s-expression of @a _expr with let bindings for all subterms that occur more than once.
+	std::string toSExprWithLetBindings(Expression const& _expr);
+
 	std::vector<std::string> m_accumulatedOutput;
 	std::map<std::string, SortPointer> m_variables;
 
@@ -103,6 +162,14 @@ protected:
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+	/// Set by interrupt(), reset when a new check starts.
+	std::atomic<bool> m_interrupted{false};
+	bool m_letBindings = false;
+
+	/// If set and not failed, queries are sent incrementally to this solver instead of the callback.
+	std::unique_ptr<SMTLib2Session> m_session;
+	/// The assertion stack as known to the solver of m_session.
+	std::vector<std::string> m_sessionFrames;
 };
 
 }
@@ -20,16 +20,32 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/Common.h>
+#include <libsolutil/Parallel.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 using namespace solidity::smtutil;
 
+namespace
+{
+
+/// How often solvers that are not needed anymore are interrupted again until they return.
+std::chrono::milliseconds const interruptRepetitionInterval{10};
+
+}
+
 SMTPortfolio::SMTPortfolio(
 	std::vector<std::unique_ptr<SolverInterface>> _solvers,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	bool _verifyAgreement
 ):
-	SolverInterface(_queryTimeout), m_solvers(std::move(_solvers))
+	SolverInterface(_queryTimeout), m_solvers(std::move(_solvers)), m_verifyAgreement(_verifyAgreement)
 {}
 
 
@@ -93,33 +109,177 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * Unless the portfolio is asked to verify that the solvers agree, the solvers are queried
+ * concurrently and the remaining solvers are interrupted as soon as their results are not needed:
+ * - UNSAT, and SAT if no values are requested, are used as soon as the first solver answers.
+ *   In that case 2) does not apply.
+ * - SAT with values waits for the solvers that come before the answering solver in the portfolio,
+ *   so that the model always comes from the first solver that answers SAT. If one of these solvers
+ *   answers UNSAT instead, the result is CONFLICTING.
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
-	CheckResult lastResult = CheckResult::ERROR;
-	std::vector<std::string> finalValues;
+	if (!m_verifyAgreement && m_solvers.size() > 1)
+		return race(_expressionsToEvaluate);
+
+	std::pair<CheckResult, std::vector<std::string>> combined{CheckResult::ERROR, {}};
 	for (auto const& s: m_solvers)
-	{
-		CheckResult result;
-		std::vector<std::string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		if (!combineResults(combined, s->check(_expressionsToEvaluate)))
+			break;
+	return combined;
+}
+
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::race(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	// Solvers that communicate via SMT-LIB2 queries share the configuration of the callback,
+	// so they take turns on one thread. Every other solver gets its own thread.
+	std::vector<std::vector<size_t>> lanes;
+	std::vector<size_t> smtlib2Lane;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		if (dynamic_cast<SMTLib2Interface*>(m_solvers[i].get()))
+			smtlib2Lane.push_back(i);
+		else
+			lanes.push_back({i});
+	if (!smtlib2Lane.empty())
+		lanes.emplace_back(std::move(smtlib2Lane));
+
+	std::mutex mutex;
+	std::condition_variable stateChanged;
+	std::vector<std::optional<std::pair<CheckResult, std::vector<std::string>>>> results(m_solvers.size());
+	std::vector<bool> running(m_solvers.size(), false);
+	size_t runningLanes = lanes.size();
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> answer;
+	// The solver with the highest priority that answered SAT, if the model is needed.
+	std::optional<size_t> satisfiedSolver;
+
+	// Whether the result of the solver at @a _index can still change the answer.
+	// Must be called with the mutex locked.
+	auto const needed = [&](size_t _index) {
+		return !answer && (!satisfiedSolver || _index < *satisfiedSolver);
+	};
+	// Updates the answer after the result of the solver at @a _index arrived.
+	// Must be called with the mutex locked.
+	auto const update = [&](size_t _index) {
+		CheckResult result = results[_index]->first;
+		if (solverAnswered(result) && needed(_index))
 		{
-			if (!solverAnswered(lastResult))
+			if (result == CheckResult::SATISFIABLE && !_expressionsToEvaluate.empty())
+				satisfiedSolver = _index;
+			else if (!satisfiedSolver)
+			{
+				answer = results[_index];
+				return;
+			}
+		}
+		if (answer || !satisfiedSolver)
+			return;
+		// The model is taken from the solver with the highest priority that answers.
+		for (size_t i = 0; i <= *satisfiedSolver; ++i)
+			if (!results[i])
+				return;
+			else if (solverAnswered(results[i]->first))
 			{
-				lastResult = result;
-				finalValues = std::move(values);
+				if (results[i]->first == CheckResult::SATISFIABLE)
+					answer = results[i];
+				else
+					answer = {CheckResult::CONFLICTING, {}};
+				return;
 			}
-			else if (lastResult != result)
+	};
+
+	std::vector<std::exception_ptr> exceptions = util::parallelFor(
+		lanes.size() + 1,
+		lanes.size() + 1,
+		[&](size_t _lane) {
+			if (_lane == lanes.size())
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				// A solver might miss an interrupt that arrives before its check has really started,
+				// so the solvers that are not needed anymore are interrupted until they return.
+				std::unique_lock lock(mutex);
+				while (runningLanes > 0)
+				{
+					for (size_t i = 0; i < m_solvers.size(); ++i)
+						if (running[i] && !needed(i))
+							m_solvers[i]->interrupt();
+					stateChanged.wait_for(lock, interruptRepetitionInterval);
+				}
+				return;
+			}
+
+			ScopeGuard laneFinished([&]() {
+				std::lock_guard lock(mutex);
+				--runningLanes;
+				stateChanged.notify_all();
+			});
+			for (size_t index: lanes[_lane])
+			{
+				{
+					std::lock_guard lock(mutex);
+					if (!needed(index))
+						continue;
+					running[index] = true;
+				}
+				ScopeGuard solverFinished([&]() {
+					std::lock_guard lock(mutex);
+					running[index] = false;
+				});
+				auto result = m_solvers[index]->check(_expressionsToEvaluate);
+
+				std::lock_guard lock(mutex);
+				results[index] = std::move(result);
+				update(index);
+				stateChanged.notify_all();
 			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
+	);
+
+	if (answer)
+		return std::move(*answer);
+	for (std::exception_ptr const& exception: exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+	std::pair<CheckResult, std::vector<std::string>> combined{CheckResult::ERROR, {}};
+	for (auto& result: results)
+		if (result)
+			combineResults(combined, std::move(*result));
+	return combined;
+}
+
+bool SMTPortfolio::combineResults(
+	std::pair<CheckResult, std::vector<std::string>>& _combined,
+	std::pair<CheckResult, std::vector<std::string>> _result
+)
+{
+	auto& [lastResult, finalValues] = _combined;
+	auto& [result, values] = _result;
+	if (solverAnswered(result))
+	{
+		if (!solverAnswered(lastResult))
+		{
 			lastResult = result;
+			finalValues = std::move(values);
+		}
+		else if (lastResult != result)
+		{
+			lastResult = CheckResult::CONFLICTING;
+			return false;
+		}
 	}
-	return std::make_pair(lastResult, finalValues);
+	else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
+		lastResult = result;
+	return true;
+}
+
+std::vector<SMTLib2Interface*> SMTPortfolio::smtlib2Solvers() const
+{
+	std::vector<SMTLib2Interface*> solvers;
+	for (auto const& s: m_solvers)
+		if (auto smtlib2 = dynamic_cast<SMTLib2Interface*>(s.get()))
+			solvers.push_back(smtlib2);
+		else
+			return {};
+	return solvers;
 }
 
 std::vector<std::string> SMTPortfolio::unhandledQueries()
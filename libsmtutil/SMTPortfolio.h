@@ -24,16 +24,19 @@
 #include <libsolutil/FixedHash.h>
 
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+class SMTLib2Interface;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * It either uses the first answer to an SMT query or checks whether
+ * different solvers give conflicting answers.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -42,7 +45,13 @@ public:
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
 
-	SMTPortfolio(std::vector<std::unique_ptr<SolverInterface>> solvers, std::optional<unsigned> _queryTimeout);
+	/// @param _verifyAgreement whether check() waits for all solvers to detect conflicting
+	/// answers instead of using the first answer.
+	SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> solvers,
+		std::optional<unsigned> _queryTimeout,
+		bool _verifyAgreement = true
+	);
 
 	void reset() override;
 
@@ -60,10 +69,27 @@ public:
 
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
+	/// @returns all solvers if every one of them communicates via SMT-LIB2 queries, so that queries
+	/// can be created upfront and solved concurrently, and an empty vector otherwise.
+	std::vector<SMTLib2Interface*> smtlib2Solvers() const;
+
+	/// Adds the result of a single solver to the result @a _combined of the previous solvers,
+	/// which has to start out as ERROR, as described in check().
+	/// @returns false if the combined result is final and no further solvers need to be queried.
+	static bool combineResults(
+		std::pair<CheckResult, std::vector<std::string>>& _combined,
+		std::pair<CheckResult, std::vector<std::string>> _result
+	);
+
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Queries all solvers concurrently and @returns the first answer, see check().
+	/// The model of a SAT answer always comes from the first solver that answers SAT.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	bool m_verifyAgreement = true;
 
 	std::vector<Expression> m_assertions;
 };
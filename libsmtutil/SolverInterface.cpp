@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+
+using namespace solidity::smtutil;
+
+namespace
+{
+
+bool identicalSorts(SortPointer const& _a, SortPointer const& _b);
+
+bool identicalSorts(std::vector<SortPointer> const& _a, std::vector<SortPointer> const& _b)
+{
+	return std::equal(
+		_a.begin(),
+		_a.end(),
+		_b.begin(),
+		_b.end(),
+		[](SortPointer const& _x, SortPointer const& _y) { return identicalSorts(_x, _y); }
+	);
+}
+
+/// Unlike Sort::operator==, this never considers sorts of different types identical,
+/// e.g. a plain Int sort and an IntSort, since expressions may depend on the type of their sort.
+bool identicalSorts(SortPointer const& _a, SortPointer const& _b)
+{
+	if (_a == _b)
+		return true;
+	if (!_a || !_b || typeid(*_a) != typeid(*_b))
+		return false;
+
+	if (auto const* intSort = dynamic_cast<IntSort const*>(_a.get()))
+		return intSort->isSigned == dynamic_cast<IntSort const&>(*_b).isSigned;
+	if (auto const* bitVectorSort = dynamic_cast<BitVectorSort const*>(_a.get()))
+		return bitVectorSort->size == dynamic_cast<BitVectorSort const&>(*_b).size;
+	if (auto const* functionSort = dynamic_cast<FunctionSort const*>(_a.get()))
+	{
+		auto const& other = dynamic_cast<FunctionSort const&>(*_b);
+		return identicalSorts(functionSort->domain, other.domain) && identicalSorts(functionSort->codomain, other.codomain);
+	}
+	if (auto const* arraySort = dynamic_cast<ArraySort const*>(_a.get()))
+	{
+		auto const& other = dynamic_cast<ArraySort const&>(*_b);
+		return identicalSorts(arraySort->domain, other.domain) && identicalSorts(arraySort->range, other.range);
+	}
+	if (auto const* sortSort = dynamic_cast<SortSort const*>(_a.get()))
+		return identicalSorts(sortSort->inner, dynamic_cast<SortSort const&>(*_b).inner);
+	if (auto const* tupleSort = dynamic_cast<TupleSort const*>(_a.get()))
+	{
+		auto const& other = dynamic_cast<TupleSort const&>(*_b);
+		return
+			tupleSort->name == other.name &&
+			tupleSort->members == other.members &&
+			identicalSorts(tupleSort->components, other.components);
+	}
+	return _a->kind == _b->kind;
+}
+
+std::size_t sortHash(SortPointer const& _sort)
+{
+	std::size_t hash = 0;
+	if (!_sort)
+		return hash;
+	boost::hash_combine(hash, static_cast<int>(_sort->kind));
+	if (auto const* intSort = dynamic_cast<IntSort const*>(_sort.get()))
+		boost::hash_combine(hash, intSort->isSigned);
+	else if (auto const* bitVectorSort = dynamic_cast<BitVectorSort const*>(_sort.get()))
+		boost::hash_combine(hash, bitVectorSort->size);
+	else if (auto const* tupleSort = dynamic_cast<TupleSort const*>(_sort.get()))
+		boost::hash_combine(hash, tupleSort->name);
+	return hash;
+}
+
+}
+
+std::shared_ptr<Expression::Node const> Expression::intern(
+	std::string _name,
+	std::vector<Expression> _arguments,
+	SortPointer _sort
+)
+{
+	// Expressions are created concurrently by independent queries, so the table is split into
+	// shards by hash, each with its own lock, instead of serialising all threads on one lock.
+	struct NodeTableShard
+	{
+		std::mutex mutex;
+		/// Maps the hash of every live node of the shard to its address and a weak reference to it.
+		/// A node removes itself when it is destroyed.
+		std::unordered_multimap<std::size_t, std::pair<Node const*, std::weak_ptr<Node const>>> nodes;
+	};
+	static std::size_t constexpr shardCount = 64;
+	// Intentionally never destroyed, since expressions may be destroyed during static destruction.
+	static std::array<NodeTableShard, shardCount>& table = *new std::array<NodeTableShard, shardCount>();
+	static auto const shardOf = [](std::size_t _hash) -> NodeTableShard& { return table[_hash % shardCount]; };
+
+	std::size_t hash = std::hash<std::string>{}(_name);
+	for (Expression const& argument: _arguments)
+		boost::hash_combine(hash, argument.hash());
+	boost::hash_combine(hash, sortHash(_sort));
+
+	// Nodes that do not match are only released after the shard is unlocked,
+	// since releasing the last reference to a node locks its shard.
+	std::vector<std::shared_ptr<Node const>> mismatches;
+	NodeTableShard& shard = shardOf(hash);
+	std::lock_guard lock(shard.mutex);
+	auto [begin, end] = shard.nodes.equal_range(hash);
+	for (auto it = begin; it != end; ++it)
+		if (std::shared_ptr<Node const> node = it->second.second.lock())
+		{
+			if (
+				node->name == _name &&
+				std::equal(
+					node->arguments.begin(),
+					node->arguments.end(),
+					_arguments.begin(),
+					_arguments.end(),
+					[](Expression const& _a, Expression const& _b) { return _a.identical(_b); }
+				) &&
+				identicalSorts(node->sort, _sort)
+			)
+				return node;
+			mismatches.emplace_back(std::move(node));
+		}
+
+	std::shared_ptr<Node const> node(
+		new Node{std::move(_name), std::move(_arguments), std::move(_sort), hash},
+		[](Node const* _node) {
+			{
+				NodeTableShard& nodeShard = shardOf(_node->hash);
+				std::lock_guard lock(nodeShard.mutex);
+				auto [begin, end] = nodeShard.nodes.equal_range(_node->hash);
+				for (auto it = begin; it != end; ++it)
+					if (it->second.first == _node)
+					{
+						nodeShard.nodes.erase(it);
+						break;
+					}
+			}
+			// Destroys the arguments, which might release further nodes.
+			delete _node;
+		}
+	);
+	shard.nodes.emplace(hash, std::make_pair(node.get(), std::weak_ptr<Node const>(node)));
+	return node;
+}
@@ -115,6 +115,9 @@ enum class CheckResult
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// Expressions are immutable and hash-consed: all structurally equal expressions that exist at the
+/// same time share one node, so copies are cheap, common subterms are stored only once and
+/// structural equality can be checked in constant time.
 class Expression
 {
 	friend class SolverInterface;
@@ -122,7 +125,7 @@ public:
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(std::shared_ptr<SortSort> _sort, std::string _name = ""): Expression(std::move(_name), {}, _sort) {}
 	explicit Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
-		name(std::move(_name)), arguments(std::move(_arguments)), sort(std::move(_sort)) {}
+		m_node(intern(std::move(_name), std::move(_arguments), std::move(_sort))) {}
 	Expression(size_t _number): Expression(std::to_string(_number), {}, SortProvider::uintSort) {}
 	Expression(u256 const& _number): Expression(_number.str(), {}, SortProvider::uintSort) {}
 	Expression(s256 const& _number): Expression(
@@ -145,13 +148,23 @@ public:
 	Expression& operator=(Expression const&) = default;
 	Expression& operator=(Expression&&) = default;
 
+	std::string const& name() const { return m_node->name; }
+	std::vector<Expression> const& arguments() const { return m_node->arguments; }
+	SortPointer const& sort() const { return m_node->sort; }
+
+	/// @returns true if both expressions have the same name, sort and arguments.
+	/// Takes constant time, since such expressions share their node.
+	bool identical(Expression const& _other) const { return m_node == _other.m_node; }
+	/// @returns a hash of the expression that is consistent with identical().
+	std::size_t hash() const { return m_node->hash; }
+
 	bool hasCorrectArity() const
 	{
-		if (name == "tuple_constructor")
+		if (name() == "tuple_constructor")
 		{
-			auto tupleSort = std::dynamic_pointer_cast<TupleSort>(sort);
+			auto tupleSort = std::dynamic_pointer_cast<TupleSort>(sort());
 			smtAssert(tupleSort, "");
-			return arguments.size() == tupleSort->components.size();
+			return arguments().size() == tupleSort->components.size();
 		}
 
 		static std::map<std::string, unsigned> const operatorsArity{
@@ -184,13 +197,13 @@ public:
 			{"const_array", 2},
 			{"tuple_get", 2}
 		};
-		return operatorsArity.count(name) && operatorsArity.at(name) == arguments.size();
+		return operatorsArity.count(name()) && operatorsArity.at(name()) == arguments().size();
 	}
 
 	static Expression ite(Expression _condition, Expression _trueValue, Expression _falseValue)
 	{
-		smtAssert(areCompatible(*_trueValue.sort, *_falseValue.sort));
-		SortPointer sort = _trueValue.sort;
+		smtAssert(areCompatible(*_trueValue.sort(), *_falseValue.sort()));
+		SortPointer sort = _trueValue.sort();
 		return Expression("ite", std::vector<Expression>{
 			std::move(_condition), std::move(_trueValue), std::move(_falseValue)
 		}, std::move(sort));
@@ -209,11 +222,11 @@ public:
 	/// select is the SMT representation of an array index access.
 	static Expression select(Expression _array, Expression _index)
 	{
-		smtAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		smtAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		smtAssert(arraySort, "");
-		smtAssert(_index.sort, "");
-		smtAssert(areCompatible(*arraySort->domain, *_index.sort));
+		smtAssert(_index.sort(), "");
+		smtAssert(areCompatible(*arraySort->domain, *_index.sort()));
 		return Expression(
 			"select",
 			std::vector<Expression>{std::move(_array), std::move(_index)},
@@ -225,12 +238,12 @@ public:
 	/// The function is pure and returns the modified array.
 	static Expression store(Expression _array, Expression _index, Expression _element)
 	{
-		auto arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		auto arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		smtAssert(arraySort, "");
-		smtAssert(_index.sort, "");
-		smtAssert(_element.sort, "");
-		smtAssert(areCompatible(*arraySort->domain, *_index.sort));
-		smtAssert(areCompatible(*arraySort->range, *_element.sort));
+		smtAssert(_index.sort(), "");
+		smtAssert(_element.sort(), "");
+		smtAssert(areCompatible(*arraySort->domain, *_index.sort()));
+		smtAssert(areCompatible(*arraySort->range, *_element.sort()));
 		return Expression(
 			"store",
 			std::vector<Expression>{std::move(_array), std::move(_index), std::move(_element)},
@@ -240,12 +253,12 @@ public:
 
 	static Expression const_array(Expression _sort, Expression _value)
 	{
-		smtAssert(_sort.sort->kind == Kind::Sort, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort);
+		smtAssert(_sort.sort()->kind == Kind::Sort, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort());
 		auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(sortSort && arraySort, "");
-		smtAssert(_value.sort, "");
-		smtAssert(areCompatible(*arraySort->range, *_value.sort));
+		smtAssert(_value.sort(), "");
+		smtAssert(areCompatible(*arraySort->range, *_value.sort()));
 		return Expression(
 			"const_array",
 			std::vector<Expression>{std::move(_sort), std::move(_value)},
@@ -255,8 +268,8 @@ public:
 
 	static Expression tuple_get(Expression _tuple, size_t _index)
 	{
-		smtAssert(_tuple.sort->kind == Kind::Tuple, "");
-		std::shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_tuple.sort);
+		smtAssert(_tuple.sort()->kind == Kind::Tuple, "");
+		std::shared_ptr<TupleSort> tupleSort = std::dynamic_pointer_cast<TupleSort>(_tuple.sort());
 		smtAssert(tupleSort, "");
 		smtAssert(_index < tupleSort->components.size(), "");
 		return Expression(
@@ -268,8 +281,8 @@ public:
 
 	static Expression tuple_constructor(Expression _tuple, std::vector<Expression> _arguments)
 	{
-		smtAssert(_tuple.sort->kind == Kind::Sort, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_tuple.sort);
+		smtAssert(_tuple.sort()->kind == Kind::Sort, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_tuple.sort());
 		auto tupleSort = std::dynamic_pointer_cast<TupleSort>(sortSort->inner);
 		smtAssert(tupleSort, "");
 		smtAssert(_arguments.size() == tupleSort->components.size(), "");
@@ -282,8 +295,8 @@ public:
 
 	static Expression int2bv(Expression _n, size_t _size)
 	{
-		smtAssert(_n.sort->kind == Kind::Int, "");
-		std::shared_ptr<IntSort> intSort = std::dynamic_pointer_cast<IntSort>(_n.sort);
+		smtAssert(_n.sort()->kind == Kind::Int, "");
+		std::shared_ptr<IntSort> intSort = std::dynamic_pointer_cast<IntSort>(_n.sort());
 		smtAssert(intSort, "");
 		smtAssert(_size <= 256, "");
 		return Expression(
@@ -295,8 +308,8 @@ public:
 
 	static Expression bv2int(Expression _bv, bool _signed = false)
 	{
-		smtAssert(_bv.sort->kind == Kind::BitVector, "");
-		std::shared_ptr<BitVectorSort> bvSort = std::dynamic_pointer_cast<BitVectorSort>(_bv.sort);
+		smtAssert(_bv.sort()->kind == Kind::BitVector, "");
+		std::shared_ptr<BitVectorSort> bvSort = std::dynamic_pointer_cast<BitVectorSort>(_bv.sort());
 		smtAssert(bvSort, "");
 		smtAssert(bvSort->size <= 256, "");
 		return Expression(
@@ -311,10 +324,10 @@ public:
 		if (_args.empty())
 			return true;
 
-		auto sort = _args.front().sort;
+		auto sort = _args.front().sort();
 		return ranges::all_of(
 			_args,
-			[&](auto const& _expr){ return _expr.sort->kind == sort->kind; }
+			[&](auto const& _expr){ return _expr.sort()->kind == sort->kind; }
 		);
 	}
 
@@ -323,7 +336,7 @@ public:
 		smtAssert(!_args.empty(), "");
 		smtAssert(sameSort(_args), "");
 
-		auto sort = _args.front().sort;
+		auto sort = _args.front().sort();
 		if (sort->kind == Kind::BitVector)
 			return Expression("bvand", std::move(_args), sort);
 
@@ -336,7 +349,7 @@ public:
 		smtAssert(!_args.empty(), "");
 		smtAssert(sameSort(_args), "");
 
-		auto sort = _args.front().sort;
+		auto sort = _args.front().sort();
 		if (sort->kind == Kind::BitVector)
 			return Expression("bvor", std::move(_args), sort);
 
@@ -349,7 +362,7 @@ public:
 		smtAssert(!_args.empty(), "");
 		smtAssert(sameSort(_args), "");
 
-		auto sort = _args.front().sort;
+		auto sort = _args.front().sort();
 		smtAssert(sort->kind == Kind::BitVector || sort->kind == Kind::Int, "");
 		return Expression("+", std::move(_args), sort);
 	}
@@ -359,38 +372,38 @@ public:
 		smtAssert(!_args.empty(), "");
 		smtAssert(sameSort(_args), "");
 
-		auto sort = _args.front().sort;
+		auto sort = _args.front().sort();
 		smtAssert(sort->kind == Kind::BitVector || sort->kind == Kind::Int, "");
 		return Expression("*", std::move(_args), sort);
 	}
 
 	friend Expression operator!(Expression _a)
 	{
-		if (_a.sort->kind == Kind::BitVector)
+		if (_a.sort()->kind == Kind::BitVector)
 			return ~_a;
 		return Expression("not", std::move(_a), Kind::Bool);
 	}
 	friend Expression operator&&(Expression _a, Expression _b)
 	{
-		if (_a.sort->kind == Kind::BitVector)
+		if (_a.sort()->kind == Kind::BitVector)
 		{
-			smtAssert(_b.sort->kind == Kind::BitVector, "");
+			smtAssert(_b.sort()->kind == Kind::BitVector, "");
 			return _a & _b;
 		}
 		return Expression("and", std::move(_a), std::move(_b), Kind::Bool);
 	}
 	friend Expression operator||(Expression _a, Expression _b)
 	{
-		if (_a.sort->kind == Kind::BitVector)
+		if (_a.sort()->kind == Kind::BitVector)
 		{
-			smtAssert(_b.sort->kind == Kind::BitVector, "");
+			smtAssert(_b.sort()->kind == Kind::BitVector, "");
 			return _a | _b;
 		}
 		return Expression("or", std::move(_a), std::move(_b), Kind::Bool);
 	}
 	friend Expression operator==(Expression _a, Expression _b)
 	{
-		smtAssert(_a.sort->kind == _b.sort->kind, "Trying to create an 'equal' expression with different sorts");
+		smtAssert(_a.sort()->kind == _b.sort()->kind, "Trying to create an 'equal' expression with different sorts");
 		return Expression("=", std::move(_a), std::move(_b), Kind::Bool);
 	}
 	friend Expression operator!=(Expression _a, Expression _b)
@@ -415,80 +428,88 @@ public:
 	}
 	friend Expression operator+(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("+", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator-(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("-", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator*(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("*", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator/(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("div", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator%(Expression _a, Expression _b)
 	{
-		auto intSort = _a.sort;
+		auto intSort = _a.sort();
 		return Expression("mod", {std::move(_a), std::move(_b)}, intSort);
 	}
 	friend Expression operator~(Expression _a)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvnot", {std::move(_a)}, bvSort);
 	}
 	friend Expression operator&(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvand", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator|(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvor", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator^(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvxor", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator<<(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvshl", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	friend Expression operator>>(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvlshr", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	static Expression ashr(Expression _a, Expression _b)
 	{
-		auto bvSort = _a.sort;
+		auto bvSort = _a.sort();
 		return Expression("bvashr", {std::move(_a), std::move(_b)}, bvSort);
 	}
 	Expression operator()(std::vector<Expression> _arguments) const
 	{
 		smtAssert(
-			sort->kind == Kind::Function,
+			sort()->kind == Kind::Function,
 			"Attempted function application to non-function."
 		);
-		auto fSort = dynamic_cast<FunctionSort const*>(sort.get());
+		auto fSort = dynamic_cast<FunctionSort const*>(sort().get());
 		smtAssert(fSort, "");
-		return Expression(name, std::move(_arguments), fSort->codomain);
+		return Expression(name(), std::move(_arguments), fSort->codomain);
 	}
 
-	std::string name;
-	std::vector<Expression> arguments;
-	SortPointer sort;
-
 private:
+	struct Node
+	{
+		std::string name;
+		std::vector<Expression> arguments;
+		SortPointer sort;
+		std::size_t hash;
+	};
+
+	/// @returns the node of the expression with the given name, arguments and sort,
+	/// which is created if no such expression exists yet.
+	static std::shared_ptr<Node const> intern(std::string _name, std::vector<Expression> _arguments, SortPointer _sort);
+
 	/// Helper method for checking sort compatibility when creating expressions
 	/// Signed and unsigned Int sorts are compatible even though they are not same
 	static bool areCompatible(Sort const& s1, Sort const& s2)
@@ -505,6 +526,18 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg)}, _kind) {}
 	Expression(std::string _name, Expression _arg1, Expression _arg2, Kind _kind):
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
+
+	std::shared_ptr<Node const> m_node;
+};
+
+/// Hash and equality for expressions as keys of unordered containers.
+struct ExpressionHash
+{
+	std::size_t operator()(Expression const& _expr) const { return _expr.hash(); }
+};
+struct ExpressionIdentical
+{
+	bool operator()(Expression const& _a, Expression const& _b) const { return _a.identical(_b); }
 };
 
 DEV_SIMPLE_EXCEPTION(SolverError);
@@ -536,6 +569,12 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that is running on another thread to stop as soon as possible,
+	/// since its result is not needed anymore. An interrupted check returns UNKNOWN or ERROR.
+	/// Does nothing if the solver cannot be interrupted or no check is running yet, so callers
+	/// have to repeat it until the check returns.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
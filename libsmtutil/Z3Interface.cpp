@@ -141,15 +141,15 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	z3::expr_vector arguments(m_context);
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toZ3Expr(arg));
 
 	try
 	{
-		std::string const& n = _expr.name;
+		std::string const& n = _expr.name();
 		if (m_functions.count(n))
 			return m_functions.at(n)(arguments);
 		else if (m_constants.count(n))
@@ -163,15 +163,15 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 				return m_context.bool_val(true);
 			else if (n == "false")
 				return m_context.bool_val(false);
-			else if (_expr.sort->kind == Kind::Sort)
+			else if (_expr.sort()->kind == Kind::Sort)
 			{
-				auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.sort);
+				auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.sort());
 				smtAssert(sortSort, "");
 				return m_context.constant(n.c_str(), z3Sort(*sortSort->inner));
 			}
 			else if (n == "tuple_constructor")
 			{
-				auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort)));
+				auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort())));
 				smtAssert(constructor.arity() == arguments.size());
 				return constructor();
 			}
@@ -233,12 +233,12 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 			return z3::ashr(arguments[0], arguments[1]);
 		else if (n == "int2bv")
 		{
-			size_t size = std::stoul(_expr.arguments[1].name);
+			size_t size = std::stoul(_expr.arguments()[1].name());
 			return z3::int2bv(static_cast<unsigned>(size), arguments[0]);
 		}
 		else if (n == "bv2int")
 		{
-			auto intSort = std::dynamic_pointer_cast<IntSort>(_expr.sort);
+			auto intSort = std::dynamic_pointer_cast<IntSort>(_expr.sort());
 			smtAssert(intSort, "");
 			return z3::bv2int(arguments[0], intSort->isSigned);
 		}
@@ -248,7 +248,7 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 			return z3::store(arguments[0], arguments[1], arguments[2]);
 		else if (n == "const_array")
 		{
-			std::shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			std::shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			smtAssert(sortSort, "");
 			auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 			smtAssert(arraySort && arraySort->domain, "");
@@ -256,12 +256,12 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 		}
 		else if (n == "tuple_get")
 		{
-			size_t index = stoul(_expr.arguments[1].name);
-			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments[0].sort), static_cast<unsigned>(index)))(arguments[0]);
+			size_t index = stoul(_expr.arguments()[1].name());
+			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments()[0].sort()), static_cast<unsigned>(index)))(arguments[0]);
 		}
 		else if (n == "tuple_constructor")
 		{
-			auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort)));
+			auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort())));
 			smtAssert(constructor.arity() == arguments.size(), "");
 			z3::expr_vector args(m_context);
 			for (auto const& arg: arguments)
@@ -28,6 +28,8 @@
 
 #include <cstdlib>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "license.h"
@@ -44,6 +46,8 @@ namespace
 // The std::strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static std::list<std::string> solidityAllocations;
+/// Guards solidityAllocations, since callbacks may be invoked from other threads than the one calling solidity_compile().
+static std::mutex solidityAllocationsMutex;
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -52,6 +56,7 @@ static std::list<std::string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 std::string takeOverAllocation(char const* _data)
 {
+	std::lock_guard lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -76,8 +81,12 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 	ReadCallback::Callback readCallback;
 	if (_readCallback)
 	{
+		// The compiler may query the callback from several threads (e.g. when solving SMT queries
+		// concurrently), but the callback implementer does not have to be thread-safe.
+		auto callbackMutex = std::make_shared<std::mutex>();
 		readCallback = [=](std::string const& _kind, std::string const& _data)
 		{
+			std::lock_guard lock(*callbackMutex);
 			char* contents_c = nullptr;
 			char* error_c = nullptr;
 			_readCallback(_readContext, _kind.data(), _data.data(), &contents_c, &error_c);
@@ -128,13 +137,16 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	std::string output = compile(_input, _readCallback, _readContext);
+	std::lock_guard lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(std::move(output)).data();
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
+		std::lock_guard lock(solidityAllocationsMutex);
 		return solidityAllocations.emplace_back(_size, '\0').data();
 	}
 	catch (...)
@@ -154,6 +166,7 @@ extern void solidity_reset() noexcept
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
 	yul::YulStringRepository::reset();
+	std::lock_guard lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
 }
@@ -50,6 +50,9 @@ extern "C" {
 /// of the deallocation.
 ///
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
+///
+/// The callback may be invoked from a different thread than the one that called solidity_compile(),
+/// but it is never invoked concurrently for the same compilation.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
 /// Returns the complete license document.
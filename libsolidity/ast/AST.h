@@ -127,7 +127,10 @@ public:
 	virtual bool experimentalSolidityOnly() const { return false; }
 
 protected:
-	size_t const m_id = 0;
+	friend class Parser;
+
+	/// Only modified by the parser to renumber sources that were parsed separately.
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
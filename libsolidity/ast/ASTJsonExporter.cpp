@@ -201,7 +201,36 @@ Json ASTJsonExporter::inlineAssemblyIdentifierToJson(std::pair<yul::Identifier c
 
 void ASTJsonExporter::print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	util::JsonWriter writer(_stream, _format);
+	write(writer, _node);
+}
+
+void ASTJsonExporter::write(util::JsonWriter& _writer, ASTNode const& _node)
+{
+	std::vector<ASTPointer<ASTNode>> children;
+	if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+		children = sourceUnit->nodes();
+	else if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_node))
+		children = contract->subNodes();
+	else
+	{
+		_writer.value(toJson(_node));
+		return;
+	}
+
+	m_nodeWithoutChildren = &_node;
+	Json node = toJson(_node);
+	m_nodeWithoutChildren = nullptr;
+
+	_writer.object(node, {{"nodes", [&](util::JsonWriter& _nodesWriter) {
+		_nodesWriter.beginArray();
+		for (auto const& child: children)
+			if (child)
+				write(_nodesWriter, *child);
+			else
+				_nodesWriter.value(Json());
+		_nodesWriter.endArray();
+	}}});
 }
 
 Json ASTJsonExporter::toJson(ASTNode const& _node)
@@ -214,7 +243,7 @@ bool ASTJsonExporter::visit(SourceUnit const& _node)
 {
 	std::vector<std::pair<std::string, Json>> attributes = {
 		std::make_pair("license", _node.licenseString() ? Json(*_node.licenseString()) : Json()),
-		std::make_pair("nodes", toJson(_node.nodes())),
+		std::make_pair("nodes", &_node == m_nodeWithoutChildren ? Json() : toJson(_node.nodes())),
 	};
 
 	if (_node.experimentalSolidity())
@@ -292,7 +321,7 @@ bool ASTJsonExporter::visit(ContractDefinition const& _node)
 		// Do not require call graph because the AST is also created for incorrect sources.
 		std::make_pair("usedEvents", getContainerIds(_node.interfaceEvents(false))),
 		std::make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
-		std::make_pair("nodes", toJson(_node.subNodes())),
+		std::make_pair("nodes", &_node == m_nodeWithoutChildren ? Json() : toJson(_node.subNodes())),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
@@ -59,6 +59,9 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format);
+	/// Writes the json representation of the AST to _writer. Produces the same output as
+	/// toJson(), but only builds the json of one top-level node or contract member at a time.
+	void write(util::JsonWriter& _writer, ASTNode const& _node);
 	Json toJson(ASTNode const& _node);
 	template <class T>
 	Json toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -197,6 +200,8 @@ private:
 
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	/// Source unit or contract whose "nodes" member is omitted, since write() streams it separately.
+	ASTNode const* m_nodeWithoutChildren = nullptr;
 	Json m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
@@ -92,7 +92,7 @@ SourceLocation const ASTJsonImporter::createSourceLocation(Json const& _node)
 {
 	astAssert(member(_node, "src").is_string(), "'src' must be a string");
 
-	return solidity::langutil::parseSourceLocation(_node["src"].get<std::string>(), m_sourceNames);
+	return solidity::langutil::parseSourceLocation(_node["src"].get_ref<std::string const&>(), m_sourceNames);
 }
 
 std::optional<std::vector<SourceLocation>> ASTJsonImporter::createSourceLocations(Json const& _node) const
@@ -142,7 +142,7 @@ ASTPointer<T> ASTJsonImporter::convertJsonToASTNode(Json const& _node)
 ASTPointer<ASTNode> ASTJsonImporter::convertJsonToASTNode(Json const& _json)
 {
 	astAssert(_json["nodeType"].is_string() && _json.contains("id"), "JSON-Node needs to have 'nodeType' and 'id' fields.");
-	std::string nodeType = _json["nodeType"].get<std::string>();
+	std::string const& nodeType = _json["nodeType"].get_ref<std::string const&>();
 	if (nodeType == "PragmaDirective")
 		return createPragmaDirective(_json);
 	if (nodeType == "ImportDirective")
@@ -1080,11 +1080,11 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json co
 
 // ===== helper functions ==========
 
-Json ASTJsonImporter::member(Json const& _node, std::string const& _name)
+Json const& ASTJsonImporter::member(Json const& _node, std::string const& _name)
 {
-	if (!_node.contains(_name))
-		return Json();
-	return _node[_name];
+	static Json const null;
+	auto it = _node.find(_name);
+	return it != _node.end() ? *it : null;
 }
 
 Token ASTJsonImporter::scanSingleToken(Json const& _node)
@@ -1102,14 +1102,14 @@ ASTPointer<ASTString> ASTJsonImporter::nullOrASTString(Json const& _json, std::s
 
 ASTPointer<ASTString> ASTJsonImporter::memberAsASTString(Json const& _node, std::string const& _name)
 {
-	Json value = member(_node, _name);
+	Json const& value = member(_node, _name);
 	astAssert(value.is_string(), "field " + _name + " must be of type string.");
 	return std::make_shared<ASTString>(_node[_name].get<std::string>());
 }
 
 bool ASTJsonImporter::memberAsBool(Json const& _node, std::string const& _name)
 {
-	Json value = member(_node, _name);
+	Json const& value = member(_node, _name);
 	astAssert(value.is_boolean(), "field " + _name + " must be of type boolean.");
 	return _node[_name].get<bool>();
 }
@@ -1153,7 +1153,7 @@ Token ASTJsonImporter::literalTokenKind(Json const& _node)
 
 Visibility ASTJsonImporter::visibility(Json const& _node)
 {
-	Json visibility = member(_node, "visibility");
+	Json const& visibility = member(_node, "visibility");
 	astAssert(visibility.is_string(), "'visibility' expected to be a string.");
 
 	std::string const visibilityStr = visibility.get<std::string>();
@@ -1177,7 +1177,7 @@ Visibility ASTJsonImporter::visibility(Json const& _node)
 
 VariableDeclaration::Location ASTJsonImporter::location(Json const& _node)
 {
-	Json storageLoc = member(_node, "storageLocation");
+	Json const& storageLoc = member(_node, "storageLocation");
 	astAssert(storageLoc.is_string(), "'storageLocation' expected to be a string.");
 
 	std::string const storageLocStr = storageLoc.get<std::string>();
@@ -1201,7 +1201,7 @@ VariableDeclaration::Location ASTJsonImporter::location(Json const& _node)
 
 Literal::SubDenomination ASTJsonImporter::subdenomination(Json const& _node)
 {
-	Json subDen = member(_node, "subdenomination");
+	Json const& subDen = member(_node, "subdenomination");
 
 	if (subDen.is_null())
 		return Literal::SubDenomination::None;
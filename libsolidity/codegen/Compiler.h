@@ -59,6 +59,14 @@ public:
 	/// @returns Runtime assembly as a shared pointer.
 	std::shared_ptr<evmasm::Assembly> runtimeAssemblyPtr() const;
 
+	/// Enables recording the execution statistics of the Yul optimiser steps in @a _yulProfile
+	/// and of the EVM assembly optimiser passes in @a _evmasmProfile while compiling the contract.
+	void setOptimiserProfiles(util::StepProfile* _yulProfile, util::StepProfile* _evmasmProfile)
+	{
+		m_runtimeContext.setOptimiserProfiles(_yulProfile, _evmasmProfile);
+		m_context.setOptimiserProfiles(_yulProfile, _evmasmProfile);
+	}
+
 	std::string generatedYulUtilityCode() const { return m_context.generatedYulUtilityCode(); }
 	std::string runtimeGeneratedYulUtilityCode() const { return m_runtimeContext.generatedYulUtilityCode(); }
 
@@ -36,6 +36,7 @@
 #include <libyul/backends/evm/AsmCodeGen.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/Object.h>
 #include <libyul/YulName.h>
@@ -61,6 +62,99 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Replaces the debug data that the Yul parser attached to all nodes due to a source location
+/// override by debug data for a different source location.
+/// Debug data of nodes created by the optimizer that does not carry the old location is kept.
+class DebugDataRetargeter: public yul::ASTModifier
+{
+public:
+	DebugDataRetargeter(SourceLocation _from, SourceLocation const& _to):
+		m_from(std::move(_from)),
+		m_to(DebugData::create(_to, _to))
+	{}
+
+	using ASTModifier::operator();
+	void operator()(yul::Literal& _literal) override { retarget(_literal.debugData); }
+	void operator()(yul::Identifier& _identifier) override { retarget(_identifier.debugData); }
+	void operator()(yul::FunctionCall& _funCall) override
+	{
+		retarget(_funCall.debugData);
+		retarget(_funCall.functionName.debugData);
+		ASTModifier::operator()(_funCall);
+	}
+	void operator()(yul::ExpressionStatement& _statement) override
+	{
+		retarget(_statement.debugData);
+		ASTModifier::operator()(_statement);
+	}
+	void operator()(yul::Assignment& _assignment) override
+	{
+		retarget(_assignment.debugData);
+		ASTModifier::operator()(_assignment);
+	}
+	void operator()(yul::VariableDeclaration& _varDecl) override
+	{
+		retarget(_varDecl.debugData);
+		for (auto& variable: _varDecl.variables)
+			retarget(variable.debugData);
+		ASTModifier::operator()(_varDecl);
+	}
+	void operator()(yul::If& _if) override
+	{
+		retarget(_if.debugData);
+		ASTModifier::operator()(_if);
+	}
+	void operator()(yul::Switch& _switch) override
+	{
+		retarget(_switch.debugData);
+		for (auto& _case: _switch.cases)
+			retarget(_case.debugData);
+		ASTModifier::operator()(_switch);
+	}
+	void operator()(yul::FunctionDefinition& _function) override
+	{
+		retarget(_function.debugData);
+		for (auto& parameter: _function.parameters)
+			retarget(parameter.debugData);
+		for (auto& returnVariable: _function.returnVariables)
+			retarget(returnVariable.debugData);
+		ASTModifier::operator()(_function);
+	}
+	void operator()(yul::ForLoop& _for) override
+	{
+		retarget(_for.debugData);
+		ASTModifier::operator()(_for);
+	}
+	void operator()(yul::Break& _break) override { retarget(_break.debugData); }
+	void operator()(yul::Continue& _continue) override { retarget(_continue.debugData); }
+	void operator()(yul::Leave& _leave) override { retarget(_leave.debugData); }
+	void operator()(yul::Block& _block) override
+	{
+		retarget(_block.debugData);
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	void retarget(DebugData::ConstPtr& _debugData) const
+	{
+		if (
+			_debugData &&
+			!_debugData->astID &&
+			_debugData->nativeLocation == m_from &&
+			_debugData->originLocation == m_from
+		)
+			_debugData = m_to;
+	}
+
+	SourceLocation m_from;
+	DebugData::ConstPtr m_to;
+};
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -440,8 +534,50 @@ void CompilerContext::appendInlineAssembly(
 	std::optional<langutil::SourceLocation> locationOverride;
 	if (!_system)
 		locationOverride = m_asm->currentSourceLocation();
+
+	auto assemble = [&](yul::Block const& _code, yul::AsmAnalysisInfo& _analysisInfo)
+	{
+		yul::CodeGenerator::assemble(
+			_code,
+			_analysisInfo,
+			*m_asm,
+			m_evmVersion,
+			identifierAccess.generateCode,
+			_system,
+			_optimiserSettings.optimizeStackAllocation
+		);
+
+		// Reset the source location to the one of the node (instead of the CODEGEN source location)
+		updateSourceLocation();
+	};
+
+	// Apart from the source location override, the result of parsing, analysis and optimization
+	// only depends on the key, so it can be reused for snippets that are appended repeatedly.
+	auto cacheKey = std::make_tuple(
+		_assembly,
+		_localVariables,
+		_externallyUsedFunctions,
+		_sourceName,
+		locationOverride && locationOverride->isValid()
+	);
+	if (!_system)
+		if (
+			auto cached = m_inlineAssemblyCache.find(cacheKey);
+			cached != m_inlineAssemblyCache.end() && cached->second.optimiserSettings == _optimiserSettings
+		)
+		{
+			CachedInlineAssembly& entry = cached->second;
+			if (entry.locationOverride != *locationOverride)
+			{
+				DebugDataRetargeter{entry.locationOverride, *locationOverride}(*entry.code);
+				entry.locationOverride = *locationOverride;
+			}
+			assemble(*entry.code, *entry.analysisInfo);
+			return;
+		}
+
 	std::shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
+		yul::Parser(errorReporter, dialect, locationOverride)
 		.parse(charStream);
 #ifdef SOL_OUTPUT_ASM
 	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
@@ -517,18 +653,18 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
-	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
-		*m_asm,
-		m_evmVersion,
-		identifierAccess.generateCode,
-		_system,
-		_optimiserSettings.optimizeStackAllocation
-	);
-
-	// Reset the source location to the one of the node (instead of the CODEGEN source location)
-	updateSourceLocation();
+	if (_system)
+		assemble(*parserResult, analysisInfo);
+	else
+	{
+		CachedInlineAssembly& entry = m_inlineAssemblyCache[cacheKey] = CachedInlineAssembly{
+			_optimiserSettings,
+			std::move(parserResult),
+			std::make_shared<yul::AsmAnalysisInfo>(std::move(analysisInfo)),
+			*locationOverride
+		};
+		assemble(*entry.code, *entry.analysisInfo);
+	}
 }
 
 
@@ -548,7 +684,8 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 		_optimiserSettings.yulOptimiserSteps,
 		_optimiserSettings.yulOptimiserCleanupSteps,
 		isCreation? std::nullopt : std::make_optional(_optimiserSettings.expectedExecutionsPerDeployment),
-		_externalIdentifiers
+		_externalIdentifiers,
+		m_yulOptimiserProfile
 	);
 
 #ifdef SOL_OUTPUT_ASM
@@ -37,7 +37,9 @@
 #include <liblangutil/EVMVersion.h>
 #include <libsolutil/Common.h>
 #include <libsolutil/ErrorCodes.h>
+#include <libsolutil/StepProfile.h>
 
+#include <libyul/ASTForward.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
@@ -47,6 +49,10 @@
 #include <queue>
 #include <utility>
 #include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
 
 namespace solidity::frontend
 {
@@ -283,7 +289,20 @@ public:
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
 	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion)); }
+	void optimise(OptimiserSettings const& _settings)
+	{
+		evmasm::Assembly::OptimiserSettings settings = evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion);
+		settings.profile = m_evmasmOptimiserProfile;
+		m_asm->optimise(settings);
+	}
+
+	/// Enables recording the execution statistics of the Yul optimiser steps (run on inline assembly
+	/// and utility code) in @a _yulProfile and of the EVM assembly optimiser passes in @a _evmasmProfile.
+	void setOptimiserProfiles(util::StepProfile* _yulProfile, util::StepProfile* _evmasmProfile)
+	{
+		m_yulOptimiserProfile = _yulProfile;
+		m_evmasmOptimiserProfile = _evmasmProfile;
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -393,6 +412,25 @@ private:
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
 	/// Flag to check that appendYulUtilityFunctions() was called exactly once
 	bool m_appendYulUtilityFunctionsRan = false;
+	util::StepProfile* m_yulOptimiserProfile = nullptr;
+	util::StepProfile* m_evmasmOptimiserProfile = nullptr;
+
+	/// Result of parsing, analyzing and optimizing a non-system inline assembly snippet.
+	struct CachedInlineAssembly
+	{
+		OptimiserSettings optimiserSettings;
+		std::shared_ptr<yul::Block> code;
+		std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+		/// Source location all nodes created by the parser currently point to.
+		langutil::SourceLocation locationOverride;
+	};
+	/// Cache of inline assembly snippets, keyed by the assembly text, the local variables,
+	/// the externally used functions, the source name and whether the location override was valid.
+	/// The snippets emitted by the code generator (e.g. for reverts and checks) repeat a lot.
+	std::map<
+		std::tuple<std::string, std::vector<std::string>, std::set<std::string>, std::string, bool>,
+		CachedInlineAssembly
+	> m_inlineAssemblyCache;
 };
 
 }
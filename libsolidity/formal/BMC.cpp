@@ -30,6 +30,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <utility>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -51,21 +53,23 @@ BMC::BMC(
 	std::map<h256, std::string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism
 ):
-	SMTEncoder(_context, _settings, _errorReporter, _unsupportedErrorReporter, _provedSafeReporter, _charStreamProvider)
+	SMTEncoder(_context, _settings, _errorReporter, _unsupportedErrorReporter, _provedSafeReporter, _charStreamProvider),
+	m_parallelism(_parallelism)
 {
 	solAssert(!_settings.printQuery || _settings.solvers == SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
 	std::vector<std::unique_ptr<SolverInterface>> solvers;
 	if (_settings.solvers.smtlib2)
 		solvers.emplace_back(std::make_unique<SMTLib2Interface>(_smtlib2Responses, _smtCallback, _settings.timeout));
 	if (_settings.solvers.cvc5)
-		solvers.emplace_back(std::make_unique<Cvc5SMTLib2Interface>(_smtCallback, _settings.timeout));
+		solvers.emplace_back(std::make_unique<Cvc5SMTLib2Interface>(_smtCallback, _settings.timeout, _settings.persistentSolvers));
 #ifdef HAVE_Z3
 	if (_settings.solvers.z3 && Z3Interface::available())
 		solvers.emplace_back(std::make_unique<Z3Interface>(_settings.timeout));
 #endif
-	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout);
+	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout, _settings.verifyAgreement);
 #if defined (HAVE_Z3)
 	if (m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -939,8 +943,32 @@ std::string BMC::targetDescription(BMCVerificationTarget const& _target)
 
 void BMC::checkVerificationTargets()
 {
-	for (auto& target: m_verificationTargets)
-		checkVerificationTarget(target);
+	auto const* portfolio = dynamic_cast<SMTPortfolio const*>(m_interface.get());
+	if (
+		m_parallelism > 1 &&
+		!m_settings.persistentSolvers &&
+		m_verificationTargets.size() > 1 &&
+		portfolio &&
+		!portfolio->smtlib2Solvers().empty()
+	)
+	{
+		// Every target is checked between push and pop, so the queries are independent of each other.
+		// They are collected in a first pass and solved concurrently. The second pass performs
+		// the same checks again and reports the results in the same order as the sequential checks.
+		// Persistent solver sessions answer the queries incrementally one by one instead.
+		m_queryBatch.emplace();
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		solveQueryBatch();
+		m_queryBatch->solved = true;
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		solAssert(m_queryBatch->nextQuery == m_queryBatch->queries.size());
+		m_queryBatch.reset();
+	}
+	else
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -1137,6 +1165,22 @@ void BMC::checkCondition(
 	std::vector<std::string> values;
 	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
 
+	if (m_queryBatch && !m_queryBatch->solved)
+	{
+		// The query was only collected, the result is reported once the batch has been solved.
+		m_interface->pop();
+		return;
+	}
+
+	if (m_settings.showTimings)
+		m_errorReporter.info(
+			5021_error,
+			_location,
+			"BMC: Solving the " + targetDescription(_target) + " check took " +
+			std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(m_lastQueryDuration).count()) +
+			" ms."
+		);
+
 	std::string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
 		extraComment +=
@@ -1168,7 +1212,7 @@ void BMC::checkCondition(
 			modelMessage << "Counterexample:\n";
 			std::map<std::string, std::string> sortedModel;
 			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
+				if (expressionsToEvaluate.at(i).name() != values.at(i))
 					sortedModel[expressionNames.at(i)] = values.at(i);
 
 			for (auto const& eval: sortedModel)
@@ -1275,14 +1319,31 @@ BMC::checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _e
 	{
 		if (m_settings.printQuery)
 		{
-			auto portfolio = dynamic_cast<smtutil::SMTPortfolio*>(m_interface.get());
-			std::string smtlibCode = portfolio->dumpQuery(_expressionsToEvaluate);
-			m_errorReporter.info(
-				6240_error,
-				"BMC: Requested query:\n" + smtlibCode
-			);
+			// Queries of a batch are reported when their results are, i.e. in the same order as the sequential checks.
+			std::string smtlibCode;
+			if (m_queryBatch && m_queryBatch->solved)
+				smtlibCode = m_queryBatch->printedQueries.at(m_queryBatch->nextQuery);
+			else
+			{
+				auto portfolio = dynamic_cast<smtutil::SMTPortfolio*>(m_interface.get());
+				smtlibCode = portfolio->dumpQuery(_expressionsToEvaluate);
+			}
+			if (m_queryBatch && !m_queryBatch->solved)
+				m_queryBatch->printedQueries.emplace_back(std::move(smtlibCode));
+			else
+				m_errorReporter.info(
+					6240_error,
+					"BMC: Requested query:\n" + smtlibCode
+				);
+		}
+		if (m_queryBatch)
+			tie(result, values) = checkBatched(_expressionsToEvaluate);
+		else
+		{
+			auto const start = std::chrono::steady_clock::now();
+			tie(result, values) = m_interface->check(_expressionsToEvaluate);
+			m_lastQueryDuration = std::chrono::steady_clock::now() - start;
 		}
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
@@ -1306,6 +1367,61 @@ BMC::checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _e
 	return make_pair(result, values);
 }
 
+std::pair<smtutil::CheckResult, std::vector<std::string>>
+BMC::checkBatched(std::vector<smtutil::Expression> const& _expressionsToEvaluate)
+{
+	std::vector<SMTLib2Interface*> solvers = dynamic_cast<SMTPortfolio const&>(*m_interface).smtlib2Solvers();
+	if (!m_queryBatch->solved)
+	{
+		std::vector<std::string> queries;
+		for (SMTLib2Interface* solver: solvers)
+			queries.emplace_back(solver->dumpQuery(_expressionsToEvaluate));
+		m_queryBatch->queries.emplace_back(std::move(queries));
+		return {smtutil::CheckResult::UNKNOWN, {}};
+	}
+
+	size_t const index = m_queryBatch->nextQuery++;
+	solAssert(index < m_queryBatch->queries.size());
+	m_lastQueryDuration = m_queryBatch->durations.at(index);
+	std::pair<smtutil::CheckResult, std::vector<std::string>> combined{smtutil::CheckResult::ERROR, {}};
+	for (size_t i = 0; i < solvers.size(); ++i)
+		if (!SMTPortfolio::combineResults(
+			combined,
+			solvers[i]->checkResult(
+				m_queryBatch->queries[index][i],
+				m_queryBatch->responses[index][i],
+				_expressionsToEvaluate
+			)
+		))
+			break;
+	return combined;
+}
+
+void BMC::solveQueryBatch()
+{
+	std::vector<SMTLib2Interface*> solvers = dynamic_cast<SMTPortfolio const&>(*m_interface).smtlib2Solvers();
+	QueryBatch& batch = *m_queryBatch;
+	batch.responses.assign(batch.queries.size(), std::vector<std::optional<std::string>>(solvers.size()));
+	batch.durations.assign(batch.queries.size(), {});
+	// The solvers take turns because the configuration of the callback is shared between them.
+	for (size_t solverIndex = 0; solverIndex < solvers.size(); ++solverIndex)
+	{
+		solvers[solverIndex]->setupSmtCallback();
+		std::vector<std::exception_ptr> exceptions = util::parallelFor(
+			batch.queries.size(),
+			m_parallelism,
+			[&](size_t _index) {
+				auto const start = std::chrono::steady_clock::now();
+				batch.responses[_index][solverIndex] = solvers[solverIndex]->solveQuery(batch.queries[_index][solverIndex]);
+				batch.durations[_index] += std::chrono::steady_clock::now() - start;
+			}
+		);
+		for (std::exception_ptr const& exception: exceptions)
+			if (exception)
+				std::rethrow_exception(exception);
+	}
+}
+
 smtutil::CheckResult BMC::checkSatisfiable()
 {
 	return checkSatisfiableAndGenerateModel({}).first;
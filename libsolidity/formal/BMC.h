@@ -38,6 +38,8 @@
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <chrono>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -66,7 +68,8 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -198,6 +201,12 @@ private:
 	);
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Adds the query to m_queryBatch if it is not solved yet and returns UNKNOWN.
+	/// Otherwise uses the responses to the next query of the batch.
+	std::pair<smtutil::CheckResult, std::vector<std::string>>
+	checkBatched(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Solves the queries of m_queryBatch concurrently using up to m_parallelism threads.
+	void solveQueryBatch();
 
 	smtutil::CheckResult checkSatisfiable();
 	//@}
@@ -207,6 +216,30 @@ private:
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
 
+	/// Maximum number of verification targets that are solved concurrently.
+	size_t m_parallelism = 1;
+
+	/// Queries of the verification targets that are solved concurrently, see checkVerificationTargets().
+	struct QueryBatch
+	{
+		/// For every query, the SMT-LIB2 code for each solver of the portfolio.
+		std::vector<std::vector<std::string>> queries;
+		/// For every query, the response of each solver.
+		std::vector<std::vector<std::optional<std::string>>> responses;
+		/// For every query, how long the solvers took to answer it.
+		std::vector<std::chrono::steady_clock::duration> durations;
+		/// For every query, the SMT-LIB2 code that is reported if printing queries is requested.
+		std::vector<std::string> printedQueries;
+		/// Whether the responses are available. Until then, queries are only collected.
+		bool solved = false;
+		/// Index of the next query whose responses are used.
+		size_t nextQuery = 0;
+	};
+	std::optional<QueryBatch> m_queryBatch;
+
+	/// How long the solvers took to answer the last query.
+	std::chrono::steady_clock::duration m_lastQueryDuration{};
+
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
 	bool m_externalFunctionCallHappened = false;
@@ -36,6 +36,7 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -67,11 +68,13 @@ CHC::CHC(
 	std::map<util::h256, std::string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _unsupportedErrorReporter, _provedSafeReporter, _charStreamProvider),
 	m_smtlib2Responses(_smtlib2Responses),
-	m_smtCallback(_smtCallback)
+	m_smtCallback(_smtCallback),
+	m_parallelism(_parallelism)
 {
 	solAssert(!_settings.printQuery || _settings.solvers == smtutil::SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
 }
@@ -192,7 +195,7 @@ void CHC::endVisit(ContractDefinition const& _contract)
 	addRule(smtutil::Expression::implies(
 		initialConstraints(_contract) && zeroes && newAddress && initialBalanceConstraint,
 		predicate(entry)
-	), entry.functor().name);
+	), entry.functor().name());
 
 	setCurrentBlock(entry);
 
@@ -302,7 +305,7 @@ bool CHC::visit(FunctionDefinition const& _function)
 	auto functionPred = predicate(*functionEntryBlock);
 	auto bodyPred = predicate(*bodyBlock);
 
-	addRule(functionPred, functionPred.name);
+	addRule(functionPred, functionPred.name());
 
 	solAssert(m_currentContract, "");
 	m_context.addAssertion(initialConstraints(*m_currentContract, &_function));
@@ -991,7 +994,7 @@ void CHC::nondetCall(ContractDefinition const& _contract, VariableDeclaration co
 	auto nondet = (*m_nondetInterfaces.at(&_contract))(stateExprs + preCallState + postCallState);
 	auto nondetCall = callPredicate(stateExprs + preCallState + postCallState);
 
-	addRule(smtutil::Expression::implies(nondet, nondetCall), nondetCall.name);
+	addRule(smtutil::Expression::implies(nondet, nondetCall), nondetCall.name());
 
 	m_context.addAssertion(nondetCall);
 
@@ -1072,7 +1075,7 @@ void CHC::externalFunctionCall(FunctionCall const& _funCall)
 	auto nondet = (*m_nondetInterfaces.at(m_currentContract))(stateExprs + preCallState + postCallState);
 	auto nondetCall = callPredicate(stateExprs + preCallState + postCallState);
 
-	addRule(smtutil::Expression::implies(nondet, nondetCall), nondetCall.name);
+	addRule(smtutil::Expression::implies(nondet, nondetCall), nondetCall.name());
 
 	m_context.addAssertion(nondetCall);
 	solAssert(m_errorDest, "");
@@ -1529,7 +1532,7 @@ void CHC::defineExternalFunctionInterface(FunctionDefinition const& _function, C
 	// such as balance updates because of ``msg.value``.
 	auto functionEntryBlock = createBlock(&_function, PredicateType::FunctionBlock);
 	auto functionPred = predicate(*functionEntryBlock);
-	addRule(functionPred, functionPred.name);
+	addRule(functionPred, functionPred.name());
 	setCurrentBlock(*functionEntryBlock);
 
 	m_context.addAssertion(initialConstraints(_contract, &_function));
@@ -1613,7 +1616,7 @@ void CHC::defineContractInitializer(ContractDefinition const& _contract, Contrac
 	auto const& implicitConstructorPredicate = *createConstructorBlock(_contract, "contract_initializer_entry");
 
 	auto implicitFact = smt::constructor(implicitConstructorPredicate, m_context);
-	addRule(smtutil::Expression::implies(initialConstraints(_contract), implicitFact), implicitFact.name);
+	addRule(smtutil::Expression::implies(initialConstraints(_contract), implicitFact), implicitFact.name());
 	setCurrentBlock(implicitConstructorPredicate);
 
 	auto prevErrorDest = m_errorDest;
@@ -1752,7 +1755,7 @@ void CHC::connectBlocks(smtutil::Expression const& _from, smtutil::Expression co
 		_from && m_context.assertions() && _constraints,
 		_to
 	);
-	addRule(edge, _from.name + "_to_" + _to.name);
+	addRule(edge, _from.name() + "_to_" + _to.name());
 }
 
 smtutil::Expression CHC::initialConstraints(ContractDefinition const& _contract, FunctionDefinition const* _function)
@@ -1907,7 +1910,7 @@ smtutil::Expression CHC::predicate(
 		kind == FunctionType::Kind::Internal ? PredicateType::InternalCall : PredicateType::ExternalCallTrusted
 	);
 	auto to = smt::function(callPredicate, contract, m_context);
-	addRule(smtutil::Expression::implies(from, to), to.name);
+	addRule(smtutil::Expression::implies(from, to), to.name());
 
 	return callPredicate(args);
 }
@@ -1926,16 +1929,10 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 	{
 		auto smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
 		solAssert(smtLibInterface, "Requested to print queries but CHCSmtLib2Interface not available");
-		std::string smtLibCode = smtLibInterface->dumpQuery(_query);
-		m_errorReporter.info(
-			2339_error,
-			"CHC: Requested query:\n" + smtLibCode
-		);
+		printQuery(smtLibInterface->dumpQuery(_query));
 	}
 	std::tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
+	if (result == CheckResult::SATISFIABLE)
 	{
 	// We still need the ifdef because of Z3CHCInterface.
 		if (m_settings.solvers.z3)
@@ -1960,10 +1957,25 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 			solAssert(false);
 #endif
 		}
-		break;
 	}
+	reportSolverFailure(result, _location);
+	return {result, invariant, cex};
+}
+
+void CHC::printQuery(std::string const& _smtLibCode)
+{
+	m_errorReporter.info(
+		2339_error,
+		"CHC: Requested query:\n" + _smtLibCode
+	);
+}
+
+void CHC::reportSolverFailure(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1973,7 +1985,6 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -2011,7 +2022,7 @@ void CHC::verificationTargetEncountered(
 		extendedErrorCondition && errorFlag().currentValue() == errorId
 	);
 	solAssert(m_errorDest, "");
-	addRule(smtutil::Expression::implies(pred, predicate(*m_errorDest)), pred.name);
+	addRule(smtutil::Expression::implies(pred, predicate(*m_errorDest)), pred.name());
 
 	m_context.addAssertion(errorFlag().currentValue() == previousError);
 }
@@ -2075,15 +2086,26 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
-	std::set<unsigned> checkedErrorIds;
-	for (auto const& [targetId, placeholders]: targetEntryPoints)
-	{
-		auto const& target = m_verificationTargets.at(targetId);
-		auto [errorType, errorReporterId] = targetDescription(target);
+	// Queries sent to external solvers are independent of each other and can be solved concurrently.
+	// The Z3 API is only used sequentially.
+	if (
+		m_parallelism > 1 &&
+		targetEntryPoints.size() > 1 &&
+		dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get())
+	)
+		checkAndReportTargetsConcurrently(targetEntryPoints);
+	else
+		for (auto const& [targetId, placeholders]: targetEntryPoints)
+		{
+			auto const& target = m_verificationTargets.at(targetId);
+			auto [errorType, errorReporterId] = targetDescription(target);
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
-		checkedErrorIds.insert(target.errorId);
-	}
+			checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		}
+
+	std::set<unsigned> checkedErrorIds;
+	for (unsigned targetId: targetEntryPoints | ranges::views::keys)
+		checkedErrorIds.insert(m_verificationTargets.at(targetId).errorId);
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -2207,6 +2229,99 @@ void CHC::checkAndReportTarget(
 	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
 		return;
 
+	smtutil::Expression errorBlock = createTargetQuery(_target, _placeholders);
+	auto const start = std::chrono::steady_clock::now();
+	auto queryResult = query(errorBlock, _target.errorNode->location());
+	reportTarget(
+		_target,
+		_errorReporterId,
+		_satMsg,
+		_unknownMsg,
+		errorBlock,
+		queryResult,
+		std::chrono::steady_clock::now() - start
+	);
+}
+
+void CHC::checkAndReportTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints)
+{
+	auto& smtLibInterface = dynamic_cast<CHCSmtLib2Interface&>(*m_interface);
+
+	struct TargetQuery
+	{
+		CHCVerificationTarget const& target;
+		smtutil::Expression errorBlock;
+		std::string smtLibCode;
+		std::optional<std::string> response = {};
+		std::chrono::steady_clock::duration solvingTime = {};
+	};
+
+	auto alreadyUnsafe = [&](CHCVerificationTarget const& _target) {
+		return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+	};
+
+	smtLibInterface.setupSmtCallback();
+	auto nextTarget = _targetEntryPoints.begin();
+	while (nextTarget != _targetEntryPoints.end())
+	{
+		// The queries are created in the same order and from the same rules as in checkAndReportTarget,
+		// so that they do not depend on the number of threads. Whether a target is skipped depends on the
+		// results of the previous targets with the same error node and type, so such a target starts a new batch.
+		std::vector<TargetQuery> queries;
+		std::set<std::pair<ASTNode const*, VerificationTargetType>> batchTargets;
+		for (; nextTarget != _targetEntryPoints.end(); ++nextTarget)
+		{
+			auto const& [targetId, placeholders] = *nextTarget;
+			auto const& target = m_verificationTargets.at(targetId);
+			if (alreadyUnsafe(target))
+				continue;
+			if (!batchTargets.emplace(target.errorNode, target.type).second)
+				break;
+			smtutil::Expression errorBlock = createTargetQuery(target, placeholders);
+			std::string smtLibCode = smtLibInterface.dumpQuery(errorBlock);
+			queries.push_back({target, std::move(errorBlock), std::move(smtLibCode)});
+		}
+
+		std::vector<std::exception_ptr> exceptions = util::parallelFor(
+			queries.size(),
+			m_parallelism,
+			[&](size_t _index) {
+				auto const start = std::chrono::steady_clock::now();
+				queries[_index].response = smtLibInterface.solveQuery(queries[_index].smtLibCode);
+				queries[_index].solvingTime = std::chrono::steady_clock::now() - start;
+			}
+		);
+		for (std::exception_ptr const& exception: exceptions)
+			if (exception)
+				std::rethrow_exception(exception);
+
+		for (TargetQuery const& targetQuery: queries)
+		{
+			auto const& target = targetQuery.target;
+			if (m_settings.printQuery)
+				printQuery(targetQuery.smtLibCode);
+			auto queryResult = smtLibInterface.queryResult(targetQuery.smtLibCode, targetQuery.response);
+			reportSolverFailure(std::get<0>(queryResult), target.errorNode->location());
+
+			auto [errorType, errorReporterId] = targetDescription(target);
+			reportTarget(
+				target,
+				errorReporterId,
+				errorType + " happens here.",
+				errorType + " might happen here.",
+				targetQuery.errorBlock,
+				queryResult,
+				targetQuery.solvingTime
+			);
+		}
+	}
+}
+
+smtutil::Expression CHC::createTargetQuery(
+	CHCVerificationTarget const& _target,
+	std::vector<CHCQueryPlaceholder> const& _placeholders
+)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -2214,8 +2329,30 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+	return error();
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	std::string const& _satMsg,
+	std::string const& _unknownMsg,
+	smtutil::Expression const& _errorBlock,
+	std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _queryResult,
+	std::chrono::steady_clock::duration _solvingTime
+)
+{
+	auto const& [result, invariant, model] = _queryResult;
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	if (m_settings.showTimings)
+		m_errorReporter.info(
+			7048_error,
+			location,
+			"CHC: Solving the " + targetDescription(_target).first + " check took " +
+			std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(_solvingTime).count()) +
+			" ms."
+		);
+
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target);
@@ -2231,7 +2368,7 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, _errorBlock.name());
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
@@ -2278,7 +2415,7 @@ std::optional<std::string> CHC::generateCounterexample(CHCSolverInterface::CexGr
 {
 	std::optional<unsigned> rootId;
 	for (auto const& [id, node]: _graph.nodes)
-		if (node.name == _root)
+		if (node.name() == _root)
 		{
 			rootId = id;
 			break;
@@ -2291,15 +2428,15 @@ std::optional<std::string> CHC::generateCounterexample(CHCSolverInterface::CexGr
 
 	auto callGraph = summaryCalls(_graph, *rootId);
 
-	auto nodePred = [&](auto _node) { return Predicate::predicate(_graph.nodes.at(_node).name); };
-	auto nodeArgs = [&](auto _node) { return _graph.nodes.at(_node).arguments; };
+	auto nodePred = [&](auto _node) { return Predicate::predicate(_graph.nodes.at(_node).name()); };
+	auto nodeArgs = [&](auto _node) { return _graph.nodes.at(_node).arguments(); };
 
 	bool first = true;
 	for (auto summaryId: callGraph.at(*rootId))
 	{
 		CHCSolverInterface::CexNode const& summaryNode = _graph.nodes.at(summaryId);
-		Predicate const* summaryPredicate = Predicate::predicate(summaryNode.name);
-		auto const& summaryArgs = summaryNode.arguments;
+		Predicate const* summaryPredicate = Predicate::predicate(summaryNode.name());
+		auto const& summaryArgs = summaryNode.arguments();
 
 		if (!summaryPredicate->programVariable())
 		{
@@ -2421,10 +2558,10 @@ std::map<unsigned, std::vector<unsigned>> CHC::summaryCalls(CHCSolverInterface::
 			static_cast<void>(std::from_chars(beg, _s.data() + _s.size(), result));
 			return result;
 		};
-		auto anum = extract(_graph.nodes.at(_a).name);
-		auto bnum = extract(_graph.nodes.at(_b).name);
+		auto anum = extract(_graph.nodes.at(_a).name());
+		auto bnum = extract(_graph.nodes.at(_b).name());
 		// The second part of the condition is needed to ensure that two different predicates are not considered equal
-		return (anum > bnum) || (anum == bnum && _graph.nodes.at(_a).name > _graph.nodes.at(_b).name);
+		return (anum > bnum) || (anum == bnum && _graph.nodes.at(_a).name() > _graph.nodes.at(_b).name());
 	};
 
 	std::queue<std::pair<unsigned, unsigned>> q;
@@ -2434,8 +2571,8 @@ std::map<unsigned, std::vector<unsigned>> CHC::summaryCalls(CHCSolverInterface::
 		auto [node, root] = q.front();
 		q.pop();
 
-		Predicate const* nodePred = Predicate::predicate(_graph.nodes.at(node).name);
-		Predicate const* rootPred = Predicate::predicate(_graph.nodes.at(root).name);
+		Predicate const* nodePred = Predicate::predicate(_graph.nodes.at(node).name());
+		Predicate const* rootPred = Predicate::predicate(_graph.nodes.at(root).name());
 		if (nodePred->isSummary() && (
 			_root == root ||
 			nodePred->isInternalCall() ||
@@ -2462,10 +2599,10 @@ std::string CHC::cex2dot(CHCSolverInterface::CexGraph const& _cex)
 
 	auto pred = [&](CHCSolverInterface::CexNode const& _node) {
 		std::vector<std::string> args = applyMap(
-			_node.arguments,
-			[&](auto const& arg) { return arg.name; }
+			_node.arguments(),
+			[&](auto const& arg) { return arg.name(); }
 		);
-		return "\"" + _node.name + "(" + boost::algorithm::join(args, ", ") + ")\"";
+		return "\"" + _node.name() + "(" + boost::algorithm::join(args, ", ") + ")\"";
 	};
 
 	for (auto const& [u, vs]: _cex.edges)
@@ -44,6 +44,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <chrono>
 #include <map>
 #include <optional>
 #include <set>
@@ -62,7 +63,8 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -297,6 +299,10 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Reports the SMT-LIB2 code of a query as requested by the printQuery setting.
+	void printQuery(std::string const& _smtLibCode);
+	/// Reports a warning if the solvers could not give a meaningful answer to a query.
+	void reportSolverFailure(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -310,6 +316,27 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Solves the queries of the targets concurrently using up to m_parallelism threads.
+	/// The queries and the reported results are the same as when calling checkAndReportTarget for each target.
+	/// Requires m_interface to be a CHCSmtLib2Interface.
+	void checkAndReportTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints);
+	/// Creates a new error block which is reachable if the target is violated in one of the
+	/// contexts given by @a _placeholders.
+	/// @returns the error block, which is the query for the target.
+	smtutil::Expression createTargetQuery(
+		CHCVerificationTarget const& _target,
+		std::vector<CHCQueryPlaceholder> const& _placeholders
+	);
+	/// Records the result of the query @a _errorBlock for the target as safe, unsafe or unproved.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		smtutil::Expression const& _errorBlock,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _queryResult,
+		std::chrono::steady_clock::duration _solvingTime
+	);
 
 	std::pair<std::string, langutil::ErrorId> targetDescription(CHCVerificationTarget const& _target);
 
@@ -483,6 +510,9 @@ private:
 
 	std::map<util::h256, std::string> const& m_smtlib2Responses;
 	ReadCallback::Callback const& m_smtCallback;
+
+	/// Maximum number of verification targets that are solved concurrently.
+	size_t m_parallelism = 1;
 };
 
 }
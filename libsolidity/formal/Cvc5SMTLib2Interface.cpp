@@ -18,18 +18,53 @@
 
 #include <libsolidity/formal/Cvc5SMTLib2Interface.h>
 
+#include <libsolidity/interface/SMTSolverCommand.h>
 #include <libsolidity/interface/UniversalCallback.h>
 
+#include <libsolutil/Common.h>
+
+using namespace solidity::smtutil;
 using namespace solidity::frontend::smt;
 
 Cvc5SMTLib2Interface::Cvc5SMTLib2Interface(
 	frontend::ReadCallback::Callback _smtCallback,
-	std::optional<unsigned int> _queryTimeout
+	std::optional<unsigned int> _queryTimeout,
+	bool _persistentSession
 ): SMTLib2Interface({}, std::move(_smtCallback), _queryTimeout)
 {
+	enableLetBindings();
+	if (_persistentSession && m_smtCallback.target<frontend::UniversalCallback>())
+		m_session = frontend::SMTSolverSession::cvc5(m_queryTimeout);
+}
+
+std::pair<CheckResult, std::vector<std::string>> Cvc5SMTLib2Interface::check(
+	std::vector<Expression> const& _expressionsToEvaluate
+)
+{
+	{
+		std::lock_guard lock(m_checkingThreadMutex);
+		m_checkingThread = std::this_thread::get_id();
+	}
+	solidity::ScopeGuard endCheck([&]() {
+		std::lock_guard lock(m_checkingThreadMutex);
+		m_checkingThread.reset();
+	});
+	return SMTLib2Interface::check(_expressionsToEvaluate);
 }
 
 void Cvc5SMTLib2Interface::setupSmtCallback() {
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
 		universalCallback->smtCommand().setCvc5(m_queryTimeout);
 }
+
+void Cvc5SMTLib2Interface::interrupt()
+{
+	SMTLib2Interface::interrupt();
+	// Holding the lock keeps the check from ending, and its thread from sending the query of
+	// another solver, until the process is terminated.
+	std::lock_guard lock(m_checkingThreadMutex);
+	if (!m_checkingThread)
+		return;
+	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+		universalCallback->smtCommand().interrupt(*m_checkingThread);
+}
@@ -20,18 +20,36 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <mutex>
+#include <optional>
+#include <thread>
+
 namespace solidity::frontend::smt
 {
 
 class Cvc5SMTLib2Interface: public smtutil::SMTLib2Interface
 {
 public:
+	/// @param _persistentSession if true, cvc5 is kept running between queries instead of being
+	/// started for each query through the callback. Requires the callback to be a UniversalCallback.
 	explicit Cvc5SMTLib2Interface(
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _persistentSession = false
 	);
-private:
+
+	std::pair<smtutil::CheckResult, std::vector<std::string>> check(
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	) override;
 	void setupSmtCallback() override;
+	/// Also terminates the cvc5 process started via the callback for the running check.
+	void interrupt() override;
+
+private:
+	/// Protects m_checkingThread.
+	std::mutex m_checkingThreadMutex;
+	/// The thread on which check() is running, whose query is the one terminated by interrupt().
+	std::optional<std::thread::id> m_checkingThread;
 };
 
 }
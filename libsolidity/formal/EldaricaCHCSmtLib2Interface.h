@@ -32,9 +32,9 @@ public:
 		bool computeInvariants
 	);
 
-private:
 	void setupSmtCallback() override;
 
+private:
 	bool m_computeInvariants;
 };
 
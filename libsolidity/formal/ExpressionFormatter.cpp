@@ -43,7 +43,7 @@ namespace
 
 std::string formatDatatypeAccessor(smtutil::Expression const& _expr, std::vector<std::string> const& _args)
 {
-	auto const& op = _expr.name;
+	auto const& op = _expr.name();
 
 	// This is the most complicated part of the translation.
 	// Datatype accessor means access to a field of a datatype.
@@ -65,7 +65,7 @@ std::string formatDatatypeAccessor(smtutil::Expression const& _expr, std::vector
 	std::string accessorStr = "accessor_";
 	// Struct members have suffix "accessor_<memberName>".
 	std::string type = op.substr(op.rfind(accessorStr) + accessorStr.size());
-	solAssert(_expr.arguments.size() == 1, "");
+	solAssert(_expr.arguments().size() == 1, "");
 
 	if (type == "length")
 		return _args.at(0) + ".length";
@@ -88,7 +88,7 @@ std::string formatDatatypeAccessor(smtutil::Expression const& _expr, std::vector
 
 std::string formatGenericOp(smtutil::Expression const& _expr, std::vector<std::string> const& _args)
 {
-	return _expr.name + "(" + boost::algorithm::join(_args, ", ") + ")";
+	return _expr.name() + "(" + boost::algorithm::join(_args, ", ") + ")";
 }
 
 std::string formatInfixOp(std::string const& _op, std::vector<std::string> const& _args)
@@ -98,7 +98,7 @@ std::string formatInfixOp(std::string const& _op, std::vector<std::string> const
 
 std::string formatArrayOp(smtutil::Expression const& _expr, std::vector<std::string> const& _args)
 {
-	if (_expr.name == "select")
+	if (_expr.name() == "select")
 	{
 		auto const& a0 = _args.at(0);
 		static std::set<std::string> const ufs{"keccak256", "sha256", "ripemd160", "ecrecover"};
@@ -106,16 +106,16 @@ std::string formatArrayOp(smtutil::Expression const& _expr, std::vector<std::str
 			return _args.at(0) + "(" + _args.at(1) + ")";
 		return _args.at(0) + "[" + _args.at(1) + "]";
 	}
-	if (_expr.name == "store")
+	if (_expr.name() == "store")
 		return "(" + _args.at(0) + "[" + _args.at(1) + "] := " + _args.at(2) + ")";
 	return formatGenericOp(_expr, _args);
 }
 
 std::string formatUnaryOp(smtutil::Expression const& _expr, std::vector<std::string> const& _args)
 {
-	if (_expr.name == "not")
+	if (_expr.name() == "not")
 		return "!" + _args.at(0);
-	if (_expr.name == "-")
+	if (_expr.name() == "-")
 		return "-" + _args.at(0);
 	// Other operators such as exists may end up here.
 	return formatGenericOp(_expr, _args);
@@ -127,20 +127,18 @@ smtutil::Expression substitute(smtutil::Expression _from, std::map<std::string,
 {
 	// TODO For now we ignore nested quantifier expressions,
 	// but we should support them in the future.
-	if (_from.name == "forall" || _from.name == "exists")
+	if (_from.name() == "forall" || _from.name() == "exists")
 		return smtutil::Expression(true);
-	if (_subst.count(_from.name))
-		_from.name = _subst.at(_from.name);
-	for (auto& arg: _from.arguments)
-		arg = substitute(arg, _subst);
-	return _from;
+	std::string name = _subst.count(_from.name()) ? _subst.at(_from.name()) : _from.name();
+	auto arguments = util::applyMap(_from.arguments(), [&](auto const& _arg) { return substitute(_arg, _subst); });
+	return smtutil::Expression(std::move(name), std::move(arguments), _from.sort());
 }
 
 std::string toSolidityStr(smtutil::Expression const& _expr)
 {
-	auto const& op = _expr.name;
+	auto const& op = _expr.name();
 
-	auto const& args = _expr.arguments;
+	auto const& args = _expr.arguments();
 	auto strArgs = util::applyMap(args, [](auto const& _arg) { return toSolidityStr(_arg); });
 
 	// Constant or variable.
@@ -187,10 +185,10 @@ namespace
 bool fillArray(smtutil::Expression const& _expr, std::vector<std::string>& _array, ArrayType const& _type)
 {
 	// Base case
-	if (_expr.name == "const_array")
+	if (_expr.name() == "const_array")
 	{
 		auto length = _array.size();
-		std::optional<std::string> elemStr = expressionToString(_expr.arguments.at(1), _type.baseType());
+		std::optional<std::string> elemStr = expressionToString(_expr.arguments().at(1), _type.baseType());
 		if (!elemStr)
 			return false;
 		_array.clear();
@@ -199,11 +197,11 @@ bool fillArray(smtutil::Expression const& _expr, std::vector<std::string>& _arra
 	}
 
 	// Recursive case.
-	if (_expr.name == "store")
+	if (_expr.name() == "store")
 	{
-		if (!fillArray(_expr.arguments.at(0), _array, _type))
+		if (!fillArray(_expr.arguments().at(0), _array, _type))
 			return false;
-		std::optional<std::string> indexStr = expressionToString(_expr.arguments.at(1), TypeProvider::uint256());
+		std::optional<std::string> indexStr = expressionToString(_expr.arguments().at(1), TypeProvider::uint256());
 		if (!indexStr)
 			return false;
 		// Sometimes the solver assigns huge lengths that are not related,
@@ -221,7 +219,7 @@ bool fillArray(smtutil::Expression const& _expr, std::vector<std::string>& _arra
 		{
 			return true;
 		}
-		std::optional<std::string> elemStr = expressionToString(_expr.arguments.at(2), _type.baseType());
+		std::optional<std::string> elemStr = expressionToString(_expr.arguments().at(2), _type.baseType());
 		if (!elemStr)
 			return false;
 		if (index < _array.size())
@@ -230,7 +228,7 @@ bool fillArray(smtutil::Expression const& _expr, std::vector<std::string>& _arra
 	}
 
 	// Special base case, not supported yet.
-	if (_expr.name.rfind("(_ as-array") == 0)
+	if (_expr.name().rfind("(_ as-array") == 0)
 	{
 		// Z3 expression representing reinterpretation of a different term as an array
 		return false;
@@ -244,8 +242,8 @@ std::optional<std::string> expressionToString(smtutil::Expression const& _expr,
 {
 	if (smt::isNumber(*_type))
 	{
-		solAssert(_expr.sort->kind == Kind::Int);
-		solAssert(_expr.arguments.empty());
+		solAssert(_expr.sort()->kind == Kind::Int);
+		solAssert(_expr.arguments().empty());
 
 		if (
 			_type->category() == frontend::Type::Category::Address ||
@@ -254,10 +252,10 @@ std::optional<std::string> expressionToString(smtutil::Expression const& _expr,
 		{
 			try
 			{
-				if (_expr.name == "0")
+				if (_expr.name() == "0")
 					return "0x0";
 				// For some reason the code below returns "0x" for "0".
-				return util::toHex(toCompactBigEndian(bigint(_expr.name)), util::HexPrefix::Add, util::HexCase::Lower);
+				return util::toHex(toCompactBigEndian(bigint(_expr.name())), util::HexPrefix::Add, util::HexCase::Lower);
 			}
 			catch (std::out_of_range const&)
 			{
@@ -267,33 +265,33 @@ std::optional<std::string> expressionToString(smtutil::Expression const& _expr,
 			}
 		}
 
-		return _expr.name;
+		return _expr.name();
 	}
 	if (smt::isBool(*_type))
 	{
-		solAssert(_expr.sort->kind == Kind::Bool);
-		solAssert(_expr.arguments.empty());
-		solAssert(_expr.name == "true" || _expr.name == "false");
-		return _expr.name;
+		solAssert(_expr.sort()->kind == Kind::Bool);
+		solAssert(_expr.arguments().empty());
+		solAssert(_expr.name() == "true" || _expr.name() == "false");
+		return _expr.name();
 	}
 	if (smt::isFunction(*_type))
 	{
-		solAssert(_expr.arguments.empty());
-		return _expr.name;
+		solAssert(_expr.arguments().empty());
+		return _expr.name();
 	}
 	if (smt::isArray(*_type))
 	{
 		auto const& arrayType = dynamic_cast<ArrayType const&>(*_type);
-		if (_expr.name != "tuple_constructor")
+		if (_expr.name() != "tuple_constructor")
 			return {};
 
-		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_expr.sort);
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_expr.sort());
 		solAssert(tupleSort.components.size() == 2);
 
 		unsigned long length;
 		try
 		{
-			length = stoul(_expr.arguments.at(1).name);
+			length = stoul(_expr.arguments().at(1).name());
 		}
 		catch(std::out_of_range const&)
 		{
@@ -313,7 +311,7 @@ std::optional<std::string> expressionToString(smtutil::Expression const& _expr,
 		try
 		{
 			std::vector<std::string> array(length);
-			if (!fillArray(_expr.arguments.at(0), array, arrayType))
+			if (!fillArray(_expr.arguments().at(0), array, arrayType))
 				return {};
 			return "[" + boost::algorithm::join(array, ", ") + "]";
 		}
@@ -325,15 +323,15 @@ std::optional<std::string> expressionToString(smtutil::Expression const& _expr,
 	if (smt::isNonRecursiveStruct(*_type))
 	{
 		auto const& structType = dynamic_cast<StructType const&>(*_type);
-		solAssert(_expr.name == "tuple_constructor");
-		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_expr.sort);
+		solAssert(_expr.name() == "tuple_constructor");
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_expr.sort());
 		auto members = structType.structDefinition().members();
 		solAssert(tupleSort.components.size() == members.size());
-		solAssert(_expr.arguments.size() == members.size());
+		solAssert(_expr.arguments().size() == members.size());
 		std::vector<std::string> elements;
 		for (unsigned i = 0; i < members.size(); ++i)
 		{
-			std::optional<std::string> elementStr = expressionToString(_expr.arguments.at(i), members[i]->type());
+			std::optional<std::string> elementStr = expressionToString(_expr.arguments().at(i), members[i]->type());
 			elements.push_back(members[i]->name() + (elementStr.has_value() ?  ": " + elementStr.value() : ""));
 		}
 		return "{" + boost::algorithm::join(elements, ", ") + "}";
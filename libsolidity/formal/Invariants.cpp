@@ -48,24 +48,24 @@ std::map<Predicate const*, std::set<std::string>> collectInvariants(
 	std::map<std::string, std::pair<smtutil::Expression, smtutil::Expression>> equalities;
 	// Collect equalities where one of the sides is a predicate we're interested in.
 	util::BreadthFirstSearch<smtutil::Expression const*>{{&_proof}}.run([&](auto&& _expr, auto&& _addChild) {
-		if (_expr->name == "=")
+		if (_expr->name() == "=")
 			for (auto const& t: targets)
 			{
-				auto arg0 = _expr->arguments.at(0);
-				auto arg1 = _expr->arguments.at(1);
-				if (starts_with(arg0.name, t))
-					equalities.insert({arg0.name, {arg0, std::move(arg1)}});
-				else if (starts_with(arg1.name, t))
-					equalities.insert({arg1.name, {arg1, std::move(arg0)}});
+				auto arg0 = _expr->arguments().at(0);
+				auto arg1 = _expr->arguments().at(1);
+				if (starts_with(arg0.name(), t))
+					equalities.insert({arg0.name(), {arg0, std::move(arg1)}});
+				else if (starts_with(arg1.name(), t))
+					equalities.insert({arg1.name(), {arg1, std::move(arg0)}});
 			}
-		for (auto const& arg: _expr->arguments)
+		for (auto const& arg: _expr->arguments())
 			_addChild(&arg);
 	});
 
 	std::map<Predicate const*, std::set<std::string>> invariants;
 	for (auto pred: _predicates)
 	{
-		auto predName = pred->functor().name;
+		auto predName = pred->functor().name();
 		if (!equalities.count(predName))
 			continue;
 
@@ -76,7 +76,7 @@ std::map<Predicate const*, std::set<std::string>> collectInvariants(
 		static std::set<std::string> const ignore{"true", "false"};
 		auto r = substitute(invExpr, pred->expressionSubstitution(predExpr));
 		// No point in reporting true/false as invariants.
-		if (!ignore.count(r.name))
+		if (!ignore.count(r.name()))
 			invariants[pred].insert(toSolidityStr(r));
 	}
 	return invariants;
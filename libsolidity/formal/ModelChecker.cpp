@@ -17,6 +17,9 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <libsolidity/formal/ModelChecker.h>
+
+#include <libsolidity/interface/UniversalCallback.h>
+
 #ifdef HAVE_Z3
 #include <libsmtutil/Z3Interface.h>
 #endif
@@ -40,15 +43,26 @@ ModelChecker::ModelChecker(
 	langutil::CharStreamProvider const& _charStreamProvider,
 	std::map<h256, std::string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
-	ReadCallback::Callback const& _smtCallback
+	ReadCallback::Callback const& _smtCallback,
+	size_t _parallelism
 ):
 	m_errorReporter(_errorReporter),
 	m_provedSafeReporter(m_provedSafeLogs),
 	m_settings(std::move(_settings)),
 	m_context(),
-	m_bmc(m_context, m_uniqueErrorReporter, m_unsupportedErrorReporter, m_provedSafeReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
-	m_chc(m_context, m_uniqueErrorReporter, m_unsupportedErrorReporter, m_provedSafeReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
+	m_bmc(m_context, m_uniqueErrorReporter, m_unsupportedErrorReporter, m_provedSafeReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, _parallelism),
+	m_chc(m_context, m_uniqueErrorReporter, m_unsupportedErrorReporter, m_provedSafeReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, _parallelism)
 {
+	if (m_settings.cacheDirectory)
+	{
+		// The copy of the callback refers to the same solver command.
+		ReadCallback::Callback smtCallback = _smtCallback;
+		if (auto* universalCallback = smtCallback.target<UniversalCallback>())
+		{
+			m_cachingSolverCommand = &universalCallback->smtCommand();
+			m_cachingSolverCommand->setQueryCache(*m_settings.cacheDirectory);
+		}
+	}
 }
 
 // TODO This should be removed for 0.9.0.
@@ -120,6 +134,10 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.none())
 		return;
 
+	std::optional<SMTSolverCommand::QueryCacheStats> cacheStatsBefore;
+	if (m_cachingSolverCommand)
+		cacheStatsBefore = m_cachingSolverCommand->queryCacheStats();
+
 	if (m_settings.engine.chc)
 		m_chc.analyze(_source);
 
@@ -135,6 +153,20 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.bmc)
 		m_bmc.analyze(_source, solvedTargets);
 
+	if (cacheStatsBefore)
+	{
+		SMTSolverCommand::QueryCacheStats cacheStats = m_cachingSolverCommand->queryCacheStats();
+		size_t hits = cacheStats.hits - cacheStatsBefore->hits;
+		size_t misses = cacheStats.misses - cacheStatsBefore->misses;
+		if (hits + misses > 0)
+			m_uniqueErrorReporter.info(
+				3154_error,
+				_source.location(),
+				"SMTChecker: " + std::to_string(hits) + " of " + std::to_string(hits + misses) +
+				" solver queries were answered by the query cache."
+			);
+	}
+
 	if (m_settings.showUnsupported)
 	{
 		m_errorReporter.append(m_unsupportedErrorReporter.errors());
@@ -29,6 +29,7 @@
 #include <libsolidity/formal/ModelCheckerSettings.h>
 
 #include <libsolidity/interface/ReadFile.h>
+#include <libsolidity/interface/SMTSolverCommand.h>
 
 #include <libsmtutil/SolverInterface.h>
 
@@ -49,12 +50,14 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _parallelism the maximum number of verification targets solved concurrently.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		size_t _parallelism = 1
 	);
 
 	// TODO This should be removed for 0.9.0.
@@ -111,6 +114,9 @@ private:
 
 	/// Constrained Horn Clauses engine.
 	CHC m_chc;
+
+	/// The command that runs the external solvers, if it caches their results.
+	SMTSolverCommand* m_cachingSolverCommand = nullptr;
 };
 
 }
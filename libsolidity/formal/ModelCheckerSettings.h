@@ -171,11 +171,21 @@ struct ModelCheckerSettings
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
 	bool printQuery = false;
 	bool showProvedSafe = false;
+	/// Report the time it took to solve the query of every verification target.
+	bool showTimings = false;
 	bool showUnproved = false;
 	bool showUnsupported = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout; // in milliseconds
+	/// Query all BMC solvers and report a warning if they disagree instead of
+	/// using the first definitive answer.
+	bool verifyAgreement = false;
+	/// Keep cvc5 running between the queries of BMC and send them incrementally
+	/// instead of starting the solver for every query.
+	bool persistentSolvers = false;
+	/// Directory in which the results of external solvers are cached between compiler runs.
+	std::optional<std::string> cacheDirectory;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
@@ -189,11 +199,15 @@ struct ModelCheckerSettings
 			invariants == _other.invariants &&
 			printQuery == _other.printQuery &&
 			showProvedSafe == _other.showProvedSafe &&
+			showTimings == _other.showTimings &&
 			showUnproved == _other.showUnproved &&
 			showUnsupported == _other.showUnsupported &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeout == _other.timeout &&
+			verifyAgreement == _other.verifyAgreement &&
+			persistentSolvers == _other.persistentSolvers &&
+			cacheDirectory == _other.cacheDirectory;
 	}
 };
 
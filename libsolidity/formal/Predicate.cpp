@@ -89,7 +89,7 @@ void Predicate::reset()
 
 smtutil::Expression Predicate::operator()(std::vector<smtutil::Expression> const& _args) const
 {
-	return smtutil::Expression(m_functor.name, _args, SortProvider::boolSort);
+	return smtutil::Expression(m_functor.name(), _args, SortProvider::boolSort);
 }
 
 smtutil::Expression const& Predicate::functor() const
@@ -444,12 +444,12 @@ std::pair<std::vector<std::optional<std::string>>, std::vector<VariableDeclarati
 std::map<std::string, std::string> Predicate::expressionSubstitution(smtutil::Expression const& _predExpr) const
 {
 	std::map<std::string, std::string> subst;
-	std::string predName = functor().name;
+	std::string predName = functor().name();
 
 	solAssert(contextContract(), "");
 	auto const& stateVars = SMTEncoder::stateVariablesIncludingInheritedAndPrivate(*contextContract());
 
-	auto nArgs = _predExpr.arguments.size();
+	auto nArgs = _predExpr.arguments().size();
 
 	// The signature of an interface predicate is
 	// interface(this, abiFunctions, (optionally) bytesConcatFunctions, cryptoFunctions, blockchainState, stateVariables).
@@ -459,10 +459,10 @@ std::map<std::string, std::string> Predicate::expressionSubstitution(smtutil::Ex
 	{
 		size_t shift = txValuesIndex();
 		solAssert(starts_with(predName, "interface"), "");
-		subst[_predExpr.arguments.at(0).name] = "address(this)";
+		subst[_predExpr.arguments().at(0).name()] = "address(this)";
 		solAssert(nArgs == stateVars.size() + shift, "");
 		for (size_t i = nArgs - stateVars.size(); i < nArgs; ++i)
-			subst[_predExpr.arguments.at(i).name] = stateVars.at(i - shift)->name();
+			subst[_predExpr.arguments().at(i).name()] = stateVars.at(i - shift)->name();
 	}
 	// The signature of a nondet interface predicate is
 	// nondet_interface(error, this, abiFunctions, (optionally) bytesConcatFunctions, cryptoFunctions, blockchainState, stateVariables, blockchainState', stateVariables').
@@ -474,13 +474,13 @@ std::map<std::string, std::string> Predicate::expressionSubstitution(smtutil::Ex
 	else if (isNondetInterface())
 	{
 		solAssert(starts_with(predName, "nondet_interface"), "");
-		subst[_predExpr.arguments.at(0).name] = "<errorCode>";
-		subst[_predExpr.arguments.at(1).name] = "address(this)";
+		subst[_predExpr.arguments().at(0).name()] = "<errorCode>";
+		subst[_predExpr.arguments().at(1).name()] = "address(this)";
 		solAssert(nArgs == stateVars.size() * 2 + firstArgIndex(), "");
 		for (size_t i = nArgs - stateVars.size(), s = 0; i < nArgs; ++i, ++s)
-			subst[_predExpr.arguments.at(i).name] = stateVars.at(s)->name() + "'";
+			subst[_predExpr.arguments().at(i).name()] = stateVars.at(s)->name() + "'";
 		for (size_t i = nArgs - (stateVars.size() * 2 + 1), s = 0; i < nArgs - (stateVars.size() + 1); ++i, ++s)
-			subst[_predExpr.arguments.at(i).name] = stateVars.at(s)->name();
+			subst[_predExpr.arguments().at(i).name()] = stateVars.at(s)->name();
 	}
 
 	return subst;
@@ -507,6 +507,6 @@ std::map<std::string, std::optional<std::string>> Predicate::readTxVars(smtutil:
 	};
 	std::map<std::string, std::optional<std::string>> vars;
 	for (auto&& [i, v]: txVars | ranges::views::enumerate)
-		vars.emplace(v.first, expressionToString(_tx.arguments.at(i), v.second));
+		vars.emplace(v.first, expressionToString(_tx.arguments().at(i), v.second));
 	return vars;
 }
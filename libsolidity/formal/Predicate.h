@@ -234,7 +234,7 @@ struct PredicateCompare
 		// represent the same program node.
 		// We use the symbolic name since it is unique per predicate and
 		// the order does not really matter.
-		return lhs->functor().name < rhs->functor().name;
+		return lhs->functor().name() < rhs->functor().name();
 	}
 };
 
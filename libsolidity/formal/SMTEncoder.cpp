@@ -837,7 +837,7 @@ void SMTEncoder::visitABIFunction(FunctionCall const& _funCall)
 		auto symbTuple = std::dynamic_pointer_cast<smt::SymbolicTupleVariable>(m_context.expression(_funCall));
 		solAssert(symbTuple, "");
 		solAssert(symbTuple->components().size() == outTypes.size(), "");
-		solAssert(out.sort->kind == smtutil::Kind::Tuple, "");
+		solAssert(out.sort()->kind == smtutil::Kind::Tuple, "");
 
 		symbTuple->increaseIndex();
 		for (unsigned i = 0; i < symbTuple->components().size(); ++i)
@@ -864,7 +864,7 @@ void SMTEncoder::visitCryptoFunction(FunctionCall const& _funCall)
 		auto arg1 = expr(*_funCall.arguments().at(1));
 		auto arg2 = expr(*_funCall.arguments().at(2));
 		auto arg3 = expr(*_funCall.arguments().at(3));
-		auto inputSort = dynamic_cast<smtutil::ArraySort&>(*e.sort).domain;
+		auto inputSort = dynamic_cast<smtutil::ArraySort&>(*e.sort()).domain;
 		auto ecrecoverInput = smtutil::Expression::tuple_constructor(
 			smtutil::Expression(std::make_shared<smtutil::SortSort>(inputSort), ""),
 			{arg0, arg1, arg2, arg3}
@@ -1315,7 +1315,7 @@ void SMTEncoder::addArrayLiteralAssertions(
 	auto tupleSort = std::dynamic_pointer_cast<smtutil::TupleSort>(smt::smtSort(*type));
 	auto sortSort = std::make_shared<smtutil::SortSort>(tupleSort->components.front());
 	smtutil::Expression arrayExpr = smtutil::Expression::const_array(smtutil::Expression(sortSort), smt::zeroValue(valueType));
-	smtAssert(arrayExpr.sort->kind == smtutil::Kind::Array);
+	smtAssert(arrayExpr.sort()->kind == smtutil::Kind::Array);
 	for (size_t i = 0; i < _elementValues.size(); i++)
 		arrayExpr = smtutil::Expression::store(arrayExpr, smtutil::Expression(i), _elementValues[i]);
 	m_context.addAssertion(_symArray.elements() == arrayExpr);
@@ -2194,7 +2194,7 @@ void SMTEncoder::tupleAssignment(Expression const& _left, Expression const& _rig
 		solAssert(lComponents.size() == rComponents.size(), "");
 
 		auto symbRight = expr(*right);
-		solAssert(symbRight.sort->kind == smtutil::Kind::Tuple, "");
+		solAssert(symbRight.sort()->kind == smtutil::Kind::Tuple, "");
 
 		for (unsigned i = 0; i < lComponents.size(); ++i)
 			if (auto component = lComponents.at(i); component && rComponents.at(i))
@@ -2563,7 +2563,7 @@ void SMTEncoder::defineExpr(Expression const& _e, smtutil::Expression _value)
 {
 	auto type = _e.annotation().type;
 	createExpr(_e);
-	solAssert(_value.sort->kind != smtutil::Kind::Function, "Equality operator applied to type that is not fully supported");
+	solAssert(_value.sort()->kind != smtutil::Kind::Function, "Equality operator applied to type that is not fully supported");
 	if (!smt::isInaccessibleDynamic(*type))
 		m_context.addAssertion(expr(_e) == _value);
 
@@ -3293,7 +3293,7 @@ smtutil::Expression SMTEncoder::createSelectExpressionForFunction(
 		if (args.at(i))
 			symbArgs.emplace_back(expr(*args.at(i), inTypes.at(i)));
 
-	auto inputSort = dynamic_cast<smtutil::ArraySort&>(*symbFunction.sort).domain;
+	auto inputSort = dynamic_cast<smtutil::ArraySort&>(*symbFunction.sort()).domain;
 	smtutil::Expression arg = smtutil::Expression::tuple_constructor(
 		smtutil::Expression(std::make_shared<smtutil::SortSort>(inputSort), ""),
 		symbArgs
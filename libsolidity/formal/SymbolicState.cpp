@@ -156,7 +156,7 @@ void SymbolicState::setAddressActive(
 void SymbolicState::newStorage()
 {
 	auto newStorageVar = SymbolicTupleVariable(
-		m_state->member("storage").sort,
+		m_state->member("storage").sort(),
 		"havoc_storage_" + std::to_string(m_context.newUniqueId()),
 		m_context
 	);
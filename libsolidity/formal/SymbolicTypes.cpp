@@ -619,7 +619,7 @@ std::optional<smtutil::Expression> symbolicTypeConversion(frontend::Type const*
 
 smtutil::Expression member(smtutil::Expression const& _tuple, std::string const& _member)
 {
-	TupleSort const& _sort = dynamic_cast<TupleSort const&>(*_tuple.sort);
+	TupleSort const& _sort = dynamic_cast<TupleSort const&>(*_tuple.sort());
 	return smtutil::Expression::tuple_get(
 		_tuple,
 		_sort.memberToIndex.at(_member)
@@ -628,14 +628,14 @@ smtutil::Expression member(smtutil::Expression const& _tuple, std::string const&
 
 smtutil::Expression assignMember(smtutil::Expression const _tuple, std::map<std::string, smtutil::Expression> const& _values)
 {
-	TupleSort const& _sort = dynamic_cast<TupleSort const&>(*_tuple.sort);
+	TupleSort const& _sort = dynamic_cast<TupleSort const&>(*_tuple.sort());
 	std::vector<smtutil::Expression> args;
 	for (auto const& m: _sort.members)
 		if (auto* value = util::valueOrNullptr(_values, m))
 			args.emplace_back(*value);
 		else
 			args.emplace_back(member(_tuple, m));
-	auto sortExpr = smtutil::Expression(std::make_shared<smtutil::SortSort>(_tuple.sort), _tuple.name);
+	auto sortExpr = smtutil::Expression(std::make_shared<smtutil::SortSort>(_tuple.sort()), _tuple.name());
 	return smtutil::Expression::tuple_constructor(sortExpr, args);
 }
 
@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/ArtifactCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+std::optional<Json> ArtifactCache::load(h256 const& _key) const
+{
+	try
+	{
+		fs::path path = entryPath(_key);
+		if (!fs::is_regular_file(path))
+			return std::nullopt;
+
+		Json artifacts;
+		if (jsonParseStrict(readFileAsString(path), artifacts) && artifacts.is_object())
+			return artifacts;
+	}
+	catch (util::Exception const&)
+	{
+	}
+	catch (fs::filesystem_error const&)
+	{
+	}
+	return std::nullopt;
+}
+
+std::optional<std::string> ArtifactCache::store(h256 const& _key, Json const& _artifacts) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return "Could not create cache directory \"" + m_directory.string() + "\": " + error.message();
+
+	// Concurrent compiler invocations must never observe a partially written entry.
+	fs::path temporaryPath = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp", error);
+	bool written = false;
+	if (!error)
+	{
+		fs::ofstream file(temporaryPath, std::ios::binary);
+		file << jsonCompactPrint(_artifacts);
+		// Errors while flushing the buffered data are only reported when the file is closed.
+		file.close();
+		written = !file.fail();
+	}
+	// Renaming within the same directory atomically replaces an existing entry.
+	if (written)
+		fs::rename(temporaryPath, entryPath(_key), error);
+
+	if (!written || error)
+	{
+		boost::system::error_code ignored;
+		fs::remove(temporaryPath, ignored);
+		return "Could not write cache entry \"" + entryPath(_key).string() + "\".";
+	}
+	return std::nullopt;
+}
+
+fs::path ArtifactCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache of compilation artifacts shared between compiler invocations.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Directory of JSON files, each named after the hash of everything the stored artifacts depend on.
+ * The directory can be shared between concurrent compiler invocations: entries are written to
+ * a temporary file first and then moved into place. Entries that cannot be read are treated
+ * as missing.
+ */
+class ArtifactCache
+{
+public:
+	explicit ArtifactCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the artifacts stored under @a _key or nullopt if there is no valid entry.
+	std::optional<Json> load(util::h256 const& _key) const;
+	/// Stores @a _artifacts under @a _key, creating the cache directory if necessary.
+	/// @returns an error message if the entry could not be written.
+	std::optional<std::string> store(util::h256 const& _key, Json const& _artifacts) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
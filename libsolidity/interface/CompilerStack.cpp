@@ -69,6 +69,7 @@
 #include <libyul/YulName.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmJsonConverter.h>
+#include <libyul/OptimizedObjectCache.h>
 #include <libyul/YulStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
@@ -84,6 +85,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -95,6 +97,7 @@
 
 #include <utility>
 #include <map>
+#include <mutex>
 #include <limits>
 #include <string>
 
@@ -107,21 +110,28 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
+static std::mutex g_compilerStackCountsMutex;
+static std::map<TypeProvider const*, int> g_compilerStackCounts;
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
+	m_typeProvider{TypeProvider::instance()},
 	m_errorReporter{m_errorList}
 {
 	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
+	// no more than one entity is actually using the same instance at a time.
+	std::lock_guard lock(g_compilerStackCountsMutex);
+	solAssert(g_compilerStackCounts[&m_typeProvider] == 0, "You shall not have another CompilerStack aside me.");
+	++g_compilerStackCounts[&m_typeProvider];
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
+	{
+		std::lock_guard lock(g_compilerStackCountsMutex);
+		g_compilerStackCounts.erase(&m_typeProvider);
+	}
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	TypeProvider::reset();
 }
 
@@ -227,6 +237,12 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	solAssert(_parallelism > 0, "At least one thread is required for compilation.");
+	m_parallelism = _parallelism;
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set EVM version before parsing.");
@@ -311,9 +327,11 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_optimiserProfiling = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -326,6 +344,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	TypeProvider::reset();
 }
 
@@ -348,17 +367,74 @@ bool CompilerStack::parse()
 
 	try
 	{
-		Parser parser{m_errorReporter, m_evmVersion};
-
 		std::vector<std::string> sourcesToParse;
 		for (auto const& s: m_sources)
 			sourcesToParse.push_back(s.first);
 
+		/// A source parsed ahead of time by its own parser and error reporter.
+		struct ParsedSource
+		{
+			ErrorList errors;
+			ErrorReporter errorReporter{errors};
+			std::unique_ptr<Parser> parser;
+			ASTPointer<SourceUnit> ast;
+		};
+		std::vector<std::unique_ptr<ParsedSource>> parsedAhead;
+		size_t parsedAheadBegin = 0;
+		int64_t maxAstId = 0;
+
 		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
+			// Whenever all sources parsed ahead of time are used up, the remaining ones known so far
+			// are parsed concurrently. They are still processed one by one in the order in which a
+			// single parser would have parsed them, so that the AST IDs and errors do not change.
+			if (m_parallelism > 1 && i == parsedAheadBegin + parsedAhead.size() && sourcesToParse.size() - i > 1)
+			{
+				parsedAheadBegin = i;
+				parsedAhead.clear();
+				// Sources that are imported from the standard library can occur more than once,
+				// but each char stream can only be parsed by one thread.
+				std::set<std::string> pathsInBatch;
+				std::vector<CharStream*> charStreams;
+				for (size_t j = i; j < sourcesToParse.size(); ++j)
+				{
+					bool firstOccurrence = pathsInBatch.insert(sourcesToParse[j]).second;
+					charStreams.emplace_back(firstOccurrence ? m_sources[sourcesToParse[j]].charStream.get() : nullptr);
+					parsedAhead.emplace_back(std::make_unique<ParsedSource>());
+				}
+				// Sources without a parser, e.g. because parsing them threw an exception, are parsed again below.
+				// Inline assembly is parsed into the Yul strings of the compilation this thread belongs to.
+				auto yulStringRepository = yul::YulStringRepository::currentCompilation();
+				util::parallelFor(charStreams.size(), m_parallelism, [&](size_t _index) {
+					if (!charStreams[_index])
+						return;
+					yul::YulStringRepository::CompilationScope yulStringScope(yulStringRepository);
+					ParsedSource& parsed = *parsedAhead[_index];
+					auto parser = std::make_unique<Parser>(parsed.errorReporter, m_evmVersion, true);
+					parsed.ast = parser->parse(*charStreams[_index]);
+					parsed.parser = std::move(parser);
+				});
+			}
+
 			std::string const& path = sourcesToParse[i];
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+			std::unique_ptr<ParsedSource> parsed;
+			if (i < parsedAheadBegin + parsedAhead.size())
+				parsed = std::move(parsedAhead[i - parsedAheadBegin]);
+			if (parsed && parsed->parser && m_errorReporter.appendWithinLimits(parsed->errorReporter))
+			{
+				parsed->parser->shiftIDs(maxAstId);
+				source.ast = parsed->ast;
+				maxAstId = parsed->parser->maxID();
+			}
+			else
+			{
+				Parser parser{m_errorReporter, m_evmVersion};
+				parser.shiftIDs(maxAstId);
+				source.ast = parser.parse(*source.charStream);
+				maxAstId = parser.maxID();
+			}
+
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
@@ -405,7 +481,7 @@ bool CompilerStack::parse()
 		storeContractDefinitions();
 
 		solAssert(!m_maxAstId.has_value());
-		m_maxAstId = parser.maxID();
+		m_maxAstId = maxAstId;
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
@@ -441,6 +517,7 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	solAssert(&TypeProvider::instance() == &m_typeProvider, "Types have to be taken from the TypeProvider of the compiler stack.");
 
 	if (!resolveImports())
 		return false;
@@ -648,7 +725,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 		if (m_modelCheckerSettings.engine.any())
 			m_modelCheckerSettings.solvers = ModelChecker::checkRequestedSolvers(m_modelCheckerSettings.solvers, m_errorReporter);
 
-		ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
+		ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_parallelism);
 		modelChecker.checkRequestedSourcesAndContracts(allSources);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
@@ -708,6 +785,27 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 	return false;
 }
 
+namespace
+{
+
+/// @returns the length of the longest chain of contracts created by @a _contract, i.e. 0 for contracts
+/// that do not embed the bytecode of other contracts.
+size_t dependencyDepth(
+	ContractDefinition const& _contract,
+	std::map<ContractDefinition const*, size_t, ASTCompareByID<ContractDefinition>>& _depths
+)
+{
+	if (size_t const* depth = util::valueOrNullptr(_depths, &_contract))
+		return *depth;
+	size_t depth = 0;
+	for (auto const& [dependency, referencingNode]: _contract.annotation().contractDependencies)
+		depth = std::max(depth, dependencyDepth(*dependency, _depths) + 1);
+	_depths[&_contract] = depth;
+	return depth;
+}
+
+}
+
 bool CompilerStack::compile(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -719,44 +817,98 @@ bool CompilerStack::compile(State _stopAfter)
 		return true;
 
 	// Only compile contracts individually which have been requested.
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
-
+	std::vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	try
+	{
+		if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
+		{
+			// IR generation relies on global state like the TypeProvider and embeds the unoptimized
+			// IR of the dependencies, so it is done serially. Everything after it only touches the
+			// Yul code of a single contract and can be done concurrently.
+			for (ContractDefinition const* contract: requestedContracts)
+				generateIR(*contract);
+
+			// Objects are only shared if the bytecode of a contract is embedded in another one. Otherwise
+			// computing the cache keys, which hashes every object, would be wasted.
+			// The cache is dropped after this compilation, so that it does not grow across resets.
+			for (ContractDefinition const* contract: requestedContracts)
+				if (!contract->annotation().contractDependencies.empty())
 				{
-					try
-					{
-						if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-							{
-								if (m_experimentalAnalysis)
-									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
-							}
-						}
-					}
-					catch (Error const& _error)
-					{
-						// Since codegen has no access to the error reporter, the only way for it to
-						// report an error is to throw. In most cases it uses dedicated exceptions,
-						// but CodeGenerationError is one case where someone decided to just throw Error.
-						solAssert(_error.type() == Error::Type::CodeGenerationError);
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _error)
-					{
-						reportUnimplementedFeatureError(_error);
-						return false;
-					}
+					m_optimizedObjectCache = std::make_shared<OptimizedObjectCache>();
+					break;
 				}
+
+			// The contracts are compiled in rounds, so that the objects of the contracts a contract creates
+			// are already in the cache when it is compiled: A round contains the contracts whose
+			// dependencies are all compiled in earlier rounds. Without dependencies, there is one round.
+			std::map<ContractDefinition const*, size_t, ASTCompareByID<ContractDefinition>> depths;
+			std::vector<std::vector<size_t>> rounds;
+			for (size_t i = 0; i < requestedContracts.size(); ++i)
+			{
+				size_t depth = dependencyDepth(*requestedContracts[i], depths);
+				if (rounds.size() <= depth)
+					rounds.resize(depth + 1);
+				rounds[depth].push_back(i);
+			}
+
+			auto yulStringRepository = yul::YulStringRepository::currentCompilation();
+			std::vector<std::exception_ptr> exceptions(requestedContracts.size());
+			for (std::vector<size_t> const& round: rounds)
+			{
+				std::vector<std::exception_ptr> roundExceptions = util::parallelFor(
+					round.size(),
+					m_parallelism,
+					[&](size_t _index) {
+						ContractDefinition const& contract = *requestedContracts[round[_index]];
+						yul::YulStringRepository::CompilationScope yulStringScope(yulStringRepository);
+						optimizeIR(contract);
+						if (m_generateEvmBytecode && m_viaIR)
+							generateEVMFromIR(contract);
+					}
+				);
+				for (size_t i = 0; i < round.size(); ++i)
+					exceptions[round[i]] = roundExceptions[i];
+			}
+			m_optimizedObjectCache.reset();
+			// Report results in the order of the contracts to keep the output independent of the
+			// number of threads.
+			for (size_t i = 0; i < requestedContracts.size(); ++i)
+			{
+				if (exceptions[i])
+					std::rethrow_exception(exceptions[i]);
+				if (m_generateEvmBytecode && m_viaIR)
+					reportCodeSizeWarnings(*requestedContracts[i]);
+			}
+		}
+		if (m_generateEvmBytecode && !m_viaIR)
+		{
+			if (m_experimentalAnalysis)
+				solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+			std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+			for (ContractDefinition const* contract: requestedContracts)
+				compileContract(*contract, otherCompilers);
+		}
+	}
+	catch (Error const& _error)
+	{
+		// Since codegen has no access to the error reporter, the only way for it to
+		// report an error is to throw. In most cases it uses dedicated exceptions,
+		// but CodeGenerationError is one case where someone decided to just throw Error.
+		solAssert(_error.type() == Error::Type::CodeGenerationError);
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _error)
+	{
+		reportUnimplementedFeatureError(_error);
+		return false;
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -911,7 +1063,12 @@ Json const& CompilerStack::yulIRAst(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
-	return contract(_contractName).yulIRAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIRAst.init([&]{
+		if (compiledContract.yulIR.empty())
+			return Json{};
+		return loadGeneratedIR(compiledContract.yulIR)->astJson();
+	});
 }
 
 std::string const& CompilerStack::yulIROptimized(std::string const& _contractName) const
@@ -924,7 +1081,14 @@ Json const& CompilerStack::yulIROptimizedAst(std::string const& _contractName) c
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
-	return contract(_contractName).yulIROptimizedAst;
+	Contract const& compiledContract = contract(_contractName);
+	// Optimizer does not maintain correct native source locations in the AST.
+	// We can work around it by regenerating the AST from scratch from optimized IR.
+	return compiledContract.yulIROptimizedAst.init([&]{
+		if (compiledContract.yulIROptimized.empty())
+			return Json{};
+		return loadGeneratedIR(compiledContract.yulIROptimized)->astJson();
+	});
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -1009,6 +1173,17 @@ Json const& CompilerStack::storageLayout(Contract const& _contract) const
 	return _contract.storageLayout.init([&]{ return StorageLayout().generate(*_contract.contract); });
 }
 
+Json CompilerStack::optimiserProfile(std::string const& _contractName) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
+	solAssert(m_optimiserProfiling, "Optimiser profiling was not enabled.");
+	Contract const& currentContract = contract(_contractName);
+	return {
+		{"yul", util::stepProfileToJson(currentContract.yulOptimiserProfile)},
+		{"evmasm", util::stepProfileToJson(currentContract.evmasmOptimiserProfile)}
+	};
+}
+
 Json const& CompilerStack::natspecUser(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
@@ -1330,6 +1505,11 @@ void CompilerStack::assembleYul(
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+}
+
+void CompilerStack::reportCodeSizeWarnings(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (2^14 + 2^13) bytes,
@@ -1390,6 +1570,8 @@ void CompilerStack::compileContract(
 
 	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
 	compiledContract.compiler = compiler;
+	if (m_optimiserProfiling)
+		compiler->setOptimiserProfiles(&compiledContract.yulOptimiserProfile, &compiledContract.evmasmOptimiserProfile);
 
 	solAssert(!m_viaIR, "");
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
@@ -1400,6 +1582,7 @@ void CompilerStack::compileContract(
 	_otherCompilers[compiledContract.contract] = compiler;
 
 	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	reportCodeSizeWarnings(_contract);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1463,37 +1646,25 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 			otherYulSources
 		);
 	}
+}
 
-	auto const parseYul = [&](std::string const& _irSource) {
-		YulStack stack(
-			m_evmVersion,
-			m_eofVersion,
-			YulStack::Language::StrictAssembly,
-			m_optimiserSettings,
-			m_debugInfoSelection
-		);
-		bool yulAnalysisSuccessful = stack.parseAndAnalyze("", _irSource);
-		solAssert(
-			yulAnalysisSuccessful,
-			_irSource + "\n\n"
-			"Invalid IR generated:\n" +
-			langutil::SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
-		);
-		return stack;
-	};
+void CompilerStack::optimizeIR(ContractDefinition const& _contract)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
 
-	{
-		YulStack stack = parseYul(compiledContract.yulIR);
-		compiledContract.yulIRAst = stack.astJson();
-		stack.optimize();
-		compiledContract.yulIROptimized = stack.print(this);
-	}
-	{
-		// Optimizer does not maintain correct native source locations in the AST.
-		// We can work around it by regenerating the AST from scratch from optimized IR.
-		YulStack stack = parseYul(compiledContract.yulIROptimized);
-		compiledContract.yulIROptimizedAst = stack.astJson();
-	}
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(!compiledContract.yulIR.empty(), "");
+	if (!compiledContract.yulIROptimized.empty())
+		return;
+
+	std::shared_ptr<YulStack> stack = loadGeneratedIR(compiledContract.yulIR);
+	if (m_optimiserProfiling)
+		stack->setOptimiserProfiles(&compiledContract.yulOptimiserProfile, nullptr);
+	stack->optimize();
+	compiledContract.yulIROptimized = stack->print(this);
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1508,25 +1679,42 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::YulStack stack(
-		m_evmVersion,
-		m_eofVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	solAssert(analysisSuccessful);
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	// Re-parse the optimized Yul IR, so that the code and source mappings are the same as those
+	// obtained by compiling the printed IR. When parsed, a node gets the last location printed
+	// before it, which is not always the location it has in the optimized AST: The optimizer creates
+	// some nodes without debug data (e.g. the break inserted by ForLoopConditionIntoBody), the
+	// locations of switch cases are not printed at all and the location of a function call is
+	// overridden by that of its function name if they differ.
+	std::shared_ptr<yul::YulStack> stack = loadGeneratedIR(compiledContract.yulIROptimized);
+	if (m_optimiserProfiling)
+		stack->setOptimiserProfiles(nullptr, &compiledContract.evmasmOptimiserProfile);
 
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack->assembleEVMWithDeployed(deployedName);
 	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
+std::shared_ptr<yul::YulStack> CompilerStack::loadGeneratedIR(std::string const& _ir) const
+{
+	auto stack = std::make_shared<YulStack>(
+		m_evmVersion,
+		m_eofVersion,
+		YulStack::Language::StrictAssembly,
+		m_optimiserSettings,
+		m_debugInfoSelection,
+		m_optimizedObjectCache
+	);
+	bool yulAnalysisSuccessful = stack->parseAndAnalyze("", _ir);
+	solAssert(
+		yulAnalysisSuccessful,
+		_ir + "\n\n"
+		"Invalid IR generated:\n" +
+		langutil::SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
+	);
+	return stack;
+}
+
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
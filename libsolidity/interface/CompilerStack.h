@@ -48,6 +48,7 @@
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/StepProfile.h>
 
 #include <functional>
 #include <memory>
@@ -69,6 +70,12 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class OptimizedObjectCache;
+class YulStack;
+}
+
 namespace solidity::frontend
 {
 
@@ -81,6 +88,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 namespace experimental
 {
 class Analysis;
@@ -168,6 +176,10 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximal number of threads used to optimize and assemble contracts concurrently.
+	/// The output does not depend on this setting.
+	void setParallelism(size_t _parallelism);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -195,6 +207,9 @@ public:
 	/// Enable generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Enable recording of the time spent in and the code size changed by each optimiser step.
+	void enableOptimiserProfiling(bool _enable = true) { m_optimiserProfiling = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -326,6 +341,11 @@ public:
 	/// Prerequisite: Successful call to parse or compile.
 	Json const& storageLayout(std::string const& _contractName) const;
 
+	/// @returns a JSON object with the per-step statistics of the Yul optimiser ("yul") and
+	/// of the libevmasm optimiser ("evmasm") collected while compiling the contract.
+	/// Prerequisite: Successful compilation with optimiser profiling enabled.
+	Json optimiserProfile(std::string const& _contractName) const;
+
 	/// @returns a JSON representing the contract's user documentation.
 	/// Prerequisite: Successful call to parse or compile.
 	Json const& natspecUser(std::string const& _contractName) const;
@@ -389,8 +409,8 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
 		std::string yulIROptimized; ///< Optimized Yul IR code.
-		Json yulIRAst; ///< JSON AST of Yul IR code.
-		Json yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		util::LazyInit<Json const> yulIRAst; ///< JSON AST of Yul IR code.
+		util::LazyInit<Json const> yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
@@ -400,6 +420,8 @@ private:
 		util::LazyInit<Json const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		util::StepProfile yulOptimiserProfile; ///< Statistics of the Yul optimiser steps.
+		util::StepProfile evmasmOptimiserProfile; ///< Statistics of the libevmasm optimiser steps.
 	};
 
 	void createAndAssignCallGraphs();
@@ -448,12 +470,26 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Reports warnings about the compiled contract exceeding the EVM code size limits.
+	void reportCodeSizeWarnings(ContractDefinition const& _contract);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
 
+	/// Optimize the Yul IR of a single contract.
+	/// Depends on output generated by generateIR. Does not report errors and only modifies the
+	/// given contract, so it can run concurrently for different contracts.
+	void optimizeIR(ContractDefinition const& _contract);
+
+	/// Parses and analyzes Yul code generated by the compiler.
+	/// Fails an assertion if the code is invalid.
+	/// The stack is returned by pointer because it cannot be safely moved.
+	std::shared_ptr<yul::YulStack> loadGeneratedIR(std::string const& _ir) const;
+
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
+	/// Depends on output generated by optimizeIR. Does not report errors and only modifies the
+	/// given contract, so it can run concurrently for different contracts.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
 	/// Links all the known library addresses in the available objects. Any unknown
@@ -506,16 +542,21 @@ private:
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
 	ReadCallback::Callback m_readFile;
+	/// TypeProvider that was current when the stack was created. Its types are
+	/// only valid as long as this stack is not reset or destroyed.
+	TypeProvider& m_typeProvider;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_parallelism = 1;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_optimiserProfiling = false;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
@@ -525,6 +566,10 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Optimized Yul objects shared between the contracts, so that a contract whose bytecode is
+	/// embedded in other contracts is optimized only once. Only set while the contracts of a
+	/// compilation are optimized, and only if some contract embeds the bytecode of another one.
+	std::shared_ptr<yul::OptimizedObjectCache> m_optimizedObjectCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
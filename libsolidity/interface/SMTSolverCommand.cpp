@@ -19,6 +19,7 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/Keccak256.h>
@@ -30,9 +31,91 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/process.hpp>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <pthread.h>
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 namespace solidity::frontend
 {
 
+namespace
+{
+
+/// Kills a process without waiting for it, which is left to the thread that started it.
+void killProcess(boost::process::pid_t _processId)
+{
+#ifdef _WIN32
+	if (HANDLE process = OpenProcess(PROCESS_TERMINATE, FALSE, _processId))
+	{
+		TerminateProcess(process, 1);
+		CloseHandle(process);
+	}
+#else
+	kill(_processId, SIGKILL);
+#endif
+}
+
+/// Blocks SIGPIPE for the current thread while it is in scope, so that writing to a solver
+/// that has exited fails with EPIPE instead of terminating the compiler.
+/// A SIGPIPE raised by the thread in the meantime is discarded.
+class ScopedSigpipeBlock
+{
+public:
+	ScopedSigpipeBlock()
+	{
+#ifndef _WIN32
+		sigemptyset(&m_sigpipe);
+		sigaddset(&m_sigpipe, SIGPIPE);
+		m_wasPending = sigpipePending();
+		pthread_sigmask(SIG_BLOCK, &m_sigpipe, &m_previousMask);
+#endif
+	}
+	~ScopedSigpipeBlock()
+	{
+#ifndef _WIN32
+		if (!m_wasPending && sigpipePending())
+		{
+			int signal = 0;
+			sigwait(&m_sigpipe, &signal);
+		}
+		pthread_sigmask(SIG_SETMASK, &m_previousMask, nullptr);
+#endif
+	}
+
+private:
+#ifndef _WIN32
+	static bool sigpipePending()
+	{
+		sigset_t pending;
+		sigemptyset(&pending);
+		sigpending(&pending);
+		return sigismember(&pending, SIGPIPE) == 1;
+	}
+
+	sigset_t m_sigpipe;
+	sigset_t m_previousMask;
+	bool m_wasPending = false;
+#endif
+};
+
+/// Printed by the solver after the output for a batch of commands.
+std::string const endOfOutput = "solc-end-of-output";
+
+/// How long a newly started solver may take to respond.
+std::chrono::seconds const startupTimeout{10};
+
+/// How much longer than the timeout per query the solver may take to respond.
+std::chrono::seconds const responseGracePeriod{1};
+
+}
+
 void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants)
 {
 	m_arguments.clear();
@@ -73,6 +156,24 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		if (m_solverCmd.empty())
 			return ReadCallback::Result{false, "No solver set."};
 
+		auto solverBin = boost::process::search_path(m_solverCmd);
+
+		if (solverBin.empty())
+			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
+
+		std::optional<util::h256> cacheKey;
+		if (m_queryCache)
+		{
+			cacheKey = queryCacheKey(solverBin, _query);
+			std::optional<Json> entry = m_queryCache->load(*cacheKey);
+			if (entry && entry->contains("response") && (*entry)["response"].is_string())
+			{
+				++m_queryCacheHits;
+				return ReadCallback::Result{true, (*entry)["response"].get<std::string>()};
+			}
+			++m_queryCacheMisses;
+		}
+
 		auto tempDir = solidity::util::TemporaryDirectory("smt");
 		util::h256 queryHash = util::keccak256(_query);
 		auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
@@ -80,11 +181,6 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		auto queryFile = boost::filesystem::ofstream(queryFileName);
 		queryFile << _query << std::flush;
 
-		auto solverBin = boost::process::search_path(m_solverCmd);
-
-		if (solverBin.empty())
-			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
-
 		auto args = m_arguments;
 		args.push_back(queryFileName.string());
 
@@ -97,14 +193,39 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		);
 
 		std::vector<std::string> data;
-		std::string line;
-		while (solverProcess.running() && std::getline(pipe, line))
-			if (!line.empty())
-				data.push_back(line);
+		{
+			// The process has to be unregistered before it is waited for, so that interrupt()
+			// never targets a process ID that might have been reused already.
+			{
+				std::lock_guard lock(m_runningProcessesMutex);
+				m_runningProcesses[std::this_thread::get_id()] = solverProcess.id();
+			}
+			ScopeGuard unregisterProcess([&]() {
+				std::lock_guard lock(m_runningProcessesMutex);
+				m_runningProcesses.erase(std::this_thread::get_id());
+			});
+
+			std::string line;
+			while (solverProcess.running() && std::getline(pipe, line))
+				if (!line.empty())
+					data.push_back(line);
+		}
 
 		solverProcess.wait();
 
-		return ReadCallback::Result{true, boost::join(data, "\n")};
+		std::string response = boost::join(data, "\n");
+		// Only definitive answers are stored, since "unknown" might be caused by a
+		// solver that was interrupted or ran out of resources.
+		if (
+			cacheKey &&
+			solverProcess.exit_code() == 0 &&
+			!data.empty() &&
+			(data.front() == "sat" || data.front() == "unsat")
+		)
+			// Failing to store the response only makes the next run slower.
+			m_queryCache->store(*cacheKey, Json{{"response", response}});
+
+		return ReadCallback::Result{true, std::move(response)};
 	}
 	catch (...)
 	{
@@ -112,4 +233,338 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 	}
 }
 
+util::h256 SMTSolverCommand::queryCacheKey(boost::filesystem::path const& _solverBin, std::string const& _query) const
+{
+	// The timeout is part of the arguments, so changing it or updating the solver invalidates the entries.
+	return util::keccak256(
+		"solver: " + _solverBin.string() + "\n" +
+		"version: " + solverVersion(_solverBin) + "\n" +
+		"arguments: " + boost::join(m_arguments, " ") + "\n" +
+		_query
+	);
+}
+
+std::string SMTSolverCommand::solverVersion(boost::filesystem::path const& _solverBin) const
+{
+	std::lock_guard lock(m_solverVersionsMutex);
+	auto [it, inserted] = m_solverVersions.try_emplace(_solverBin.string());
+	if (inserted)
+		try
+		{
+			boost::process::ipstream pipe;
+			boost::process::child versionProcess(
+				_solverBin,
+				"--version",
+				boost::process::std_in < boost::process::null,
+				boost::process::std_out > pipe,
+				boost::process::std_err > boost::process::null
+			);
+			std::string line;
+			while (std::getline(pipe, line))
+				it->second += line + "\n";
+			versionProcess.wait();
+		}
+		catch (boost::process::process_error const&)
+		{
+			// The binary still identifies the solver.
+		}
+	return it->second;
+}
+
+void SMTSolverCommand::interrupt(std::thread::id _thread)
+{
+	std::lock_guard lock(m_runningProcessesMutex);
+	if (auto process = m_runningProcesses.find(_thread); process != m_runningProcesses.end())
+		killProcess(process->second);
+}
+
+/// A running solver process together with a thread that writes its input and a thread that
+/// collects its output line by line, so that the solver can work on earlier commands in the
+/// background while the session neither blocks on writing nor on reading.
+struct SMTSolverSession::Process
+{
+	Process(boost::filesystem::path const& _binary, std::vector<std::string> const& _arguments):
+		child(
+			_binary,
+			_arguments,
+			boost::process::std_in < input,
+			boost::process::std_out > output,
+			boost::process::std_err > boost::process::null
+		),
+		reader([this]() { readOutput(); }),
+		writer([this]() { writeInput(); })
+	{}
+
+	~Process()
+	{
+		killProcess(child.id());
+		{
+			std::lock_guard lock(mutex);
+			stopping = true;
+			inputAvailable.notify_one();
+		}
+		reader.join();
+		writer.join();
+		std::error_code ignored;
+		child.wait(ignored);
+		// Close the input without flushing it, since the solver is gone.
+		input.pipe().close();
+	}
+
+	/// Queues @a _input to be written to the solver.
+	void send(std::string _input)
+	{
+		std::lock_guard lock(mutex);
+		pendingInput.push_back(std::move(_input));
+		inputAvailable.notify_one();
+	}
+
+	void writeInput()
+	{
+		// The solver may exit at any time, in which case the write fails with EPIPE.
+		ScopedSigpipeBlock blockSigpipe;
+		while (true)
+		{
+			std::string data;
+			{
+				std::unique_lock lock(mutex);
+				inputAvailable.wait(lock, [&]() { return !pendingInput.empty() || stopping; });
+				if (stopping)
+					return;
+				data = std::move(pendingInput.front());
+				pendingInput.pop_front();
+			}
+			input << data << std::flush;
+			// A solver that closed its input also stops producing output, which the reader notices.
+			if (!input)
+				return;
+		}
+	}
+
+	void readOutput()
+	{
+		std::string line;
+		while (std::getline(output, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			std::lock_guard lock(mutex);
+			lines.push_back(line);
+			outputAvailable.notify_one();
+		}
+		std::lock_guard lock(mutex);
+		closed = true;
+		outputAvailable.notify_one();
+	}
+
+	/// Makes nextLine() return nullopt once the output that has already arrived is consumed,
+	/// until it is reset again.
+	void setInterrupted(bool _interrupted)
+	{
+		std::lock_guard lock(mutex);
+		interrupted = _interrupted;
+		outputAvailable.notify_one();
+	}
+
+	/// @returns the next line of output or nullopt if the solver closed its output,
+	/// @a _deadline passed or the wait was interrupted.
+	std::optional<std::string> nextLine(std::optional<std::chrono::steady_clock::time_point> _deadline)
+	{
+		std::unique_lock lock(mutex);
+		auto const ready = [&]() { return !lines.empty() || closed || interrupted; };
+		if (!_deadline)
+			outputAvailable.wait(lock, ready);
+		else if (!outputAvailable.wait_until(lock, *_deadline, ready))
+			return std::nullopt;
+		if (lines.empty())
+			return std::nullopt;
+		std::string line = std::move(lines.front());
+		lines.pop_front();
+		return line;
+	}
+
+	boost::process::opstream input;
+	boost::process::ipstream output;
+	boost::process::child child;
+
+	std::mutex mutex;
+	std::condition_variable inputAvailable;
+	std::condition_variable outputAvailable;
+	std::deque<std::string> pendingInput;
+	std::deque<std::string> lines;
+	bool closed = false;
+	bool interrupted = false;
+	bool stopping = false;
+
+	/// Declared last so that they are started after all other members are initialized.
+	std::thread reader;
+	std::thread writer;
+};
+
+SMTSolverSession::SMTSolverSession(
+	std::string _solverCmd,
+	std::vector<std::string> _arguments,
+	std::optional<std::chrono::milliseconds> _responseTimeout
+):
+	m_solverCmd(std::move(_solverCmd)),
+	m_arguments(std::move(_arguments)),
+	m_responseTimeout(_responseTimeout)
+{
+}
+
+SMTSolverSession::~SMTSolverSession()
+{
+	stop();
+}
+
+std::unique_ptr<SMTSolverSession> SMTSolverSession::cvc5(std::optional<unsigned int> _timeoutInMilliseconds)
+{
+	std::vector<std::string> arguments{"--lang=smt2", "--incremental", "--interactive", "--no-interactive-prompt"};
+	std::optional<std::chrono::milliseconds> responseTimeout;
+	if (_timeoutInMilliseconds)
+	{
+		arguments.emplace_back("--tlimit-per");
+		arguments.emplace_back(std::to_string(*_timeoutInMilliseconds));
+		responseTimeout = std::chrono::milliseconds(*_timeoutInMilliseconds);
+	}
+	else
+	{
+		arguments.emplace_back("--rlimit-per");
+		arguments.emplace_back(std::to_string(12000));
+	}
+	return std::make_unique<SMTSolverSession>("cvc5", std::move(arguments), responseTimeout);
+}
+
+std::optional<std::string> SMTSolverSession::run(std::string const& _commands)
+{
+	{
+		std::lock_guard lock(m_interruptMutex);
+		m_runInProgress = true;
+		m_interruptRequested = false;
+	}
+	ScopeGuard endRun([&]() {
+		std::lock_guard lock(m_interruptMutex);
+		m_runInProgress = false;
+		m_interruptRequested = false;
+	});
+
+	if (!m_process && !start())
+		return std::nullopt;
+
+	send(_commands);
+	// The output for commands of interrupted runs arrives first and is skipped.
+	std::optional<std::string> output;
+	while (m_pendingOutputs > 0)
+		if (!(output = receive(responseDeadline())))
+		{
+			// An interrupted solver keeps working on the commands and is kept running.
+			if (!interruptRequested())
+				stop();
+			return std::nullopt;
+		}
+	return output;
+}
+
+void SMTSolverSession::interrupt()
+{
+	std::lock_guard lock(m_interruptMutex);
+	if (!m_runInProgress)
+		return;
+	m_interruptRequested = true;
+	if (m_waitingFor)
+		m_waitingFor->setInterrupted(true);
+}
+
+bool SMTSolverSession::start()
+{
+	if (m_failed)
+		return false;
+
+	boost::filesystem::path binary = m_solverCmd;
+	if (!binary.has_parent_path())
+		binary = boost::process::search_path(m_solverCmd);
+	try
+	{
+		if (!binary.empty())
+			m_process = std::make_unique<Process>(binary, m_arguments);
+	}
+	catch (boost::process::process_error const&)
+	{
+	}
+
+	std::optional<std::string> response;
+	if (m_process)
+	{
+		send("");
+		response = receive(std::chrono::steady_clock::now() + startupTimeout);
+	}
+	if (!response)
+	{
+		bool const interrupted = interruptRequested();
+		stop();
+		// An interrupted start says nothing about the solver, so it is tried again in the next run().
+		m_failed = !interrupted;
+		return false;
+	}
+	return true;
+}
+
+void SMTSolverSession::stop()
+{
+	{
+		std::lock_guard lock(m_interruptMutex);
+		m_waitingFor = nullptr;
+	}
+	m_process.reset();
+	m_pendingOutputs = 0;
+}
+
+bool SMTSolverSession::interruptRequested()
+{
+	std::lock_guard lock(m_interruptMutex);
+	return m_interruptRequested;
+}
+
+std::optional<std::chrono::steady_clock::time_point> SMTSolverSession::responseDeadline() const
+{
+	if (!m_responseTimeout)
+		return std::nullopt;
+	return std::chrono::steady_clock::now() + *m_responseTimeout + responseGracePeriod;
+}
+
+void SMTSolverSession::send(std::string const& _commands)
+{
+	m_process->send(_commands + "\n(echo \"" + endOfOutput + "\")\n");
+	++m_pendingOutputs;
+}
+
+std::optional<std::string> SMTSolverSession::receive(std::optional<std::chrono::steady_clock::time_point> _deadline)
+{
+	{
+		std::lock_guard lock(m_interruptMutex);
+		if (m_interruptRequested)
+			return std::nullopt;
+		m_process->setInterrupted(false);
+		m_waitingFor = m_process.get();
+	}
+	ScopeGuard stopWaiting([&]() {
+		std::lock_guard lock(m_interruptMutex);
+		m_waitingFor = nullptr;
+	});
+
+	std::vector<std::string> lines;
+	while (std::optional<std::string> line = m_process->nextLine(_deadline))
+	{
+		// Some solvers print the quotes of the echoed string literal.
+		if (*line == endOfOutput || *line == "\"" + endOfOutput + "\"")
+		{
+			--m_pendingOutputs;
+			return boost::join(lines, "\n");
+		}
+		if (!line->empty())
+			lines.push_back(std::move(*line));
+	}
+	return std::nullopt;
+}
+
 }
@@ -17,9 +17,21 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTLib2Interface.h>
+
 #include <boost/filesystem.hpp>
+#include <boost/process/child.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace solidity::frontend
 {
@@ -39,10 +51,107 @@ public:
 	void setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants);
 	void setCvc5(std::optional<unsigned int> timeoutInMilliseconds);
 
+	/// Stores the satisfiability results of the solvers in @a _directory and answers queries
+	/// from there that were already solved by the same version of the solver with the same options.
+	void setQueryCache(boost::filesystem::path _directory) { m_queryCache.emplace(std::move(_directory)); }
+	bool queryCacheEnabled() const { return m_queryCache.has_value(); }
+
+	struct QueryCacheStats
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+	QueryCacheStats queryCacheStats() const { return {m_queryCacheHits, m_queryCacheMisses}; }
+
+	/// Terminates the solver process started by the call to solve() that is currently running on
+	/// @a _thread, for example because its query was already answered by a different solver.
+	/// Queries sent from other threads are not affected. Can be called from any thread.
+	void interrupt(std::thread::id _thread);
+
 private:
 	/// The name of the solver's binary.
 	std::string m_solverCmd;
 	std::vector<std::string> m_arguments;
+
+	/// @returns the key of the query cache entry for @a _query sent to @a _solverBin with the current arguments.
+	util::h256 queryCacheKey(boost::filesystem::path const& _solverBin, std::string const& _query) const;
+	/// @returns the version string printed by @a _solverBin, which is only determined once per binary.
+	std::string solverVersion(boost::filesystem::path const& _solverBin) const;
+
+	/// Processes started by solve() that have not finished yet, by the thread that called solve().
+	mutable std::map<std::thread::id, boost::process::pid_t> m_runningProcesses;
+	mutable std::mutex m_runningProcessesMutex;
+
+	std::optional<ArtifactCache> m_queryCache;
+	mutable std::atomic<size_t> m_queryCacheHits{0};
+	mutable std::atomic<size_t> m_queryCacheMisses{0};
+	mutable std::map<std::string, std::string> m_solverVersions;
+	mutable std::mutex m_solverVersionsMutex;
+};
+
+/// SMTSolverSession keeps an SMT solver running between queries and talks SMT-LIB2 to it over
+/// its standard input and output. This avoids starting a process and re-parsing the whole
+/// assertion stack for every query.
+/// The solver is started on first use and checked to respond before it is used. A solver that
+/// does not respond in time or crashes is terminated and started again for the next query.
+/// An interrupted solver is kept running: it finishes the commands in the background and its
+/// output for them is skipped by the next run().
+class SMTSolverSession: public smtutil::SMTLib2Session
+{
+public:
+	/// @param _solverCmd the name of the solver's binary, which is searched for in PATH, or a path to it.
+	/// @param _responseTimeout time after which a solver that did not respond to a query is restarted.
+	SMTSolverSession(
+		std::string _solverCmd,
+		std::vector<std::string> _arguments,
+		std::optional<std::chrono::milliseconds> _responseTimeout
+	);
+	~SMTSolverSession() override;
+
+	/// Creates a session with cvc5, using the same limits per query as SMTSolverCommand::setCvc5.
+	static std::unique_ptr<SMTSolverSession> cvc5(std::optional<unsigned int> _timeoutInMilliseconds);
+
+	std::optional<std::string> run(std::string const& _commands) override;
+	void interrupt() override;
+	bool failed() const override { return m_failed; }
+	bool running() const override { return m_process != nullptr; }
+
+private:
+	struct Process;
+
+	/// Starts the solver and checks that it responds. Marks the session as failed if that is not the case.
+	/// @returns true on success.
+	bool start();
+	/// Terminates the solver.
+	void stop();
+	/// @returns whether interrupt() was called during the current run().
+	bool interruptRequested();
+	/// @returns the time until which the solver has to respond to the commands sent now.
+	std::optional<std::chrono::steady_clock::time_point> responseDeadline() const;
+	/// Sends @a _commands followed by a marker that the solver echoes after their output.
+	void send(std::string const& _commands);
+	/// Collects the output of the solver up to the next echoed marker.
+	/// @returns nullopt if the marker did not arrive before @a _deadline or the run was interrupted.
+	std::optional<std::string> receive(std::optional<std::chrono::steady_clock::time_point> _deadline);
+
+	std::string m_solverCmd;
+	std::vector<std::string> m_arguments;
+	std::optional<std::chrono::milliseconds> m_responseTimeout;
+	std::unique_ptr<Process> m_process;
+	bool m_failed = false;
+	/// Number of sent batches of commands whose output has not been received yet.
+	/// More than one remain after a run() was interrupted.
+	size_t m_pendingOutputs = 0;
+
+	/// Protects the members below, which are used by interrupt().
+	std::mutex m_interruptMutex;
+	/// The solver process while run() waits for its output.
+	Process* m_waitingFor = nullptr;
+	/// Whether run() is in progress. Interrupts outside of run() are ignored.
+	bool m_runInProgress = false;
+	/// Set by interrupt() during run(). The wait is only interrupted while run() waits for the
+	/// solver's output, otherwise run() checks this flag before waiting. Cleared when run() starts and ends.
+	bool m_interruptRequested = false;
 };
 
 }
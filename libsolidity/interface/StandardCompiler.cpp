@@ -22,8 +22,10 @@
  */
 
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
+#include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
@@ -39,6 +41,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -165,6 +168,57 @@ std::map<std::string, std::set<std::string>> requestedContractNames(Json const&
 	return contracts;
 }
 
+/// @returns true if the contract @a _contractName from the source @a _sourceName is selected by
+/// @a _requestedContractNames, as returned by requestedContractNames().
+bool isRequestedContract(
+	std::map<std::string, std::set<std::string>> const& _requestedContractNames,
+	std::string const& _sourceName,
+	std::string const& _contractName
+)
+{
+	if (_requestedContractNames.empty())
+		return true;
+
+	for (std::string const& key: {""s, _sourceName})
+	{
+		auto it = _requestedContractNames.find(key);
+		if (it != _requestedContractNames.end() && (it->second.count(_contractName) || it->second.count("")))
+			return true;
+	}
+	return false;
+}
+
+/// @returns the key under which the output of the contract @a _contractName is stored in the artifact cache.
+/// The metadata covers the compiler version, the settings affecting the bytecode and the hashes of all
+/// sources the contract depends on. Source indices and AST IDs are added, because they end up in source
+/// mappings and debug data, but depend on the other sources in the compilation as well.
+h256 artifactCacheKey(
+	CompilerStack const& _compilerStack,
+	std::string const& _contractName,
+	std::optional<DebugInfoSelection> const& _debugInfoSelection,
+	Json const& _outputSelection
+)
+{
+	SourceUnit const& sourceUnit = _compilerStack.contractDefinition(_contractName).sourceUnit();
+	std::set<SourceUnit const*> sourceUnits = sourceUnit.referencedSourceUnits(true);
+	sourceUnits.insert(&sourceUnit);
+	std::map<std::string, unsigned> sourceIndices = _compilerStack.sourceIndices();
+
+	Json key;
+	key["contract"] = _contractName;
+	key["metadata"] = _compilerStack.metadata(_contractName);
+	key["debugInfo"] = util::toString(_debugInfoSelection.value_or(DebugInfoSelection::Default()));
+	key["outputSelection"] = _outputSelection;
+	key["sourceCount"] = sourceIndices.size();
+	for (SourceUnit const* unit: sourceUnits)
+	{
+		std::string const& path = *unit->annotation().path;
+		key["sources"][path]["index"] = sourceIndices.at(path);
+		key["sources"][path]["id"] = unit->id();
+	}
+	return keccak256(jsonCompactPrint(key));
+}
+
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
 bool hashMatchesContent(std::string const& _hash, std::string const& _content)
 {
@@ -180,7 +234,7 @@ bool hashMatchesContent(std::string const& _hash, std::string const& _content)
 
 bool isArtifactRequested(Json const& _outputSelection, std::string const& _artifact, bool _wildcardMatchesExperimental)
 {
-	static std::set<std::string> experimental{"ir", "irAst", "irOptimized", "irOptimizedAst"};
+	static std::set<std::string> experimental{"ir", "irAst", "irOptimized", "irOptimizedAst", "optimizerProfile"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		std::string const& selectedArtifact = selectedArtifactJson.get<std::string>();
@@ -191,7 +245,7 @@ bool isArtifactRequested(Json const& _outputSelection, std::string const& _artif
 			return true;
 		else if (selectedArtifact == "*")
 		{
-			// "ir", "irOptimized" can only be matched by "*" if activated.
+			// "ir", "irOptimized" and "optimizerProfile" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
 				return true;
 		}
@@ -264,7 +318,7 @@ bool isBinaryRequested(Json const& _outputSelection)
 	// This does not include "evm.methodIdentifiers" on purpose!
 	static std::vector<std::string> const outputsThatRequireBinaries = std::vector<std::string>{
 		"*",
-		"ir", "irAst", "irOptimized", "irOptimizedAst",
+		"ir", "irAst", "irOptimized", "irOptimizedAst", "optimizerProfile",
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
@@ -283,7 +337,7 @@ bool isEvmBytecodeRequested(Json const& _outputSelection)
 		return false;
 
 	static std::vector<std::string> const outputsThatRequireEvmBinaries = std::vector<std::string>{
-		"*",
+		"*", "optimizerProfile",
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
@@ -316,6 +370,21 @@ bool isIRRequested(Json const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the optimizer profile was requested. Like the IR, it is not matched by '*'.
+bool isOptimizerProfileRequested(Json const& _outputSelection)
+{
+	if (!_outputSelection.is_object())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "optimizerProfile")
+					return true;
+
+	return false;
+}
+
 Json formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json ret = Json::object();
@@ -393,6 +462,129 @@ Json collectEVMObject(
 	return output;
 }
 
+/// @returns the output selected for the contract @a _contractName, which is called @a _name in @a _file.
+Json contractOutput(
+	CompilerStack const& _compilerStack,
+	Json const& _outputSelection,
+	langutil::EVMVersion _evmVersion,
+	StringMap const& _sourceList,
+	std::string const& _file,
+	std::string const& _name,
+	std::string const& _contractName,
+	bool _compilationSuccess
+)
+{
+	bool const wildcardMatchesExperimental = false;
+
+	// ABI, storage layout, documentation and metadata
+	Json contractData;
+	if (isArtifactRequested(_outputSelection, _file, _name, "abi", wildcardMatchesExperimental))
+		contractData["abi"] = _compilerStack.contractABI(_contractName);
+	if (isArtifactRequested(_outputSelection, _file, _name, "storageLayout", false))
+		contractData["storageLayout"] = _compilerStack.storageLayout(_contractName);
+	if (isArtifactRequested(_outputSelection, _file, _name, "metadata", wildcardMatchesExperimental))
+		contractData["metadata"] = _compilerStack.metadata(_contractName);
+	if (isArtifactRequested(_outputSelection, _file, _name, "userdoc", wildcardMatchesExperimental))
+		contractData["userdoc"] = _compilerStack.natspecUser(_contractName);
+	if (isArtifactRequested(_outputSelection, _file, _name, "devdoc", wildcardMatchesExperimental))
+		contractData["devdoc"] = _compilerStack.natspecDev(_contractName);
+
+	// IR
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "ir", wildcardMatchesExperimental))
+		contractData["ir"] = _compilerStack.yulIR(_contractName);
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "irAst", wildcardMatchesExperimental))
+		contractData["irAst"] = _compilerStack.yulIRAst(_contractName);
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "irOptimized", wildcardMatchesExperimental))
+		contractData["irOptimized"] = _compilerStack.yulIROptimized(_contractName);
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "irOptimizedAst", wildcardMatchesExperimental))
+		contractData["irOptimizedAst"] = _compilerStack.yulIROptimizedAst(_contractName);
+
+	// Optimizer profile
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "optimizerProfile", wildcardMatchesExperimental))
+		contractData["optimizerProfile"] = _compilerStack.optimiserProfile(_contractName);
+
+	// EVM
+	Json evmData;
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "evm.assembly", wildcardMatchesExperimental))
+		evmData["assembly"] = _compilerStack.assemblyString(_contractName, _sourceList);
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "evm.legacyAssembly", wildcardMatchesExperimental))
+		evmData["legacyAssembly"] = _compilerStack.assemblyJSON(_contractName);
+	if (isArtifactRequested(_outputSelection, _file, _name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+		evmData["methodIdentifiers"] = _compilerStack.interfaceSymbols(_contractName)["methods"];
+	if (_compilationSuccess && isArtifactRequested(_outputSelection, _file, _name, "evm.gasEstimates", wildcardMatchesExperimental))
+		evmData["gasEstimates"] = _compilerStack.gasEstimates(_contractName);
+
+	if (_compilationSuccess && isArtifactRequested(
+		_outputSelection,
+		_file,
+		_name,
+		evmObjectComponents("bytecode"),
+		wildcardMatchesExperimental
+	))
+		evmData["bytecode"] = collectEVMObject(
+			_evmVersion,
+			_compilerStack.object(_contractName),
+			_compilerStack.sourceMapping(_contractName),
+			_compilerStack.generatedSources(_contractName),
+			false,
+			[&](std::string const& _element) { return isArtifactRequested(
+				_outputSelection,
+				_file,
+				_name,
+				"evm.bytecode." + _element,
+				wildcardMatchesExperimental
+			); }
+		);
+
+	if (_compilationSuccess && isArtifactRequested(
+		_outputSelection,
+		_file,
+		_name,
+		evmObjectComponents("deployedBytecode"),
+		wildcardMatchesExperimental
+	))
+		evmData["deployedBytecode"] = collectEVMObject(
+			_evmVersion,
+			_compilerStack.runtimeObject(_contractName),
+			_compilerStack.runtimeSourceMapping(_contractName),
+			_compilerStack.generatedSources(_contractName, true),
+			true,
+			[&](std::string const& _element) { return isArtifactRequested(
+				_outputSelection,
+				_file,
+				_name,
+				"evm.deployedBytecode." + _element,
+				wildcardMatchesExperimental
+			); }
+		);
+
+	if (!evmData.empty())
+		contractData["evm"] = evmData;
+
+	return contractData;
+}
+
+/// @returns true if contractOutput() returns a non-empty object for the given contract.
+bool isContractOutputRequested(
+	Json const& _outputSelection,
+	std::string const& _file,
+	std::string const& _name,
+	bool _compilationSuccess
+)
+{
+	bool const wildcardMatchesExperimental = false;
+	std::vector<std::string> artifacts{"abi", "metadata", "userdoc", "devdoc", "evm.methodIdentifiers"};
+	if (_compilationSuccess)
+	{
+		artifacts += std::vector<std::string>{"ir", "irAst", "irOptimized", "irOptimizedAst", "optimizerProfile", "evm.assembly", "evm.legacyAssembly", "evm.gasEstimates"};
+		artifacts += evmObjectComponents("bytecode");
+		artifacts += evmObjectComponents("deployedBytecode");
+	}
+	return
+		isArtifactRequested(_outputSelection, _file, _name, artifacts, wildcardMatchesExperimental) ||
+		isArtifactRequested(_outputSelection, _file, _name, "storageLayout", false);
+}
+
 std::optional<Json> checkKeys(Json const& _input, std::set<std::string> const& _keys, std::string const& _name)
 {
 	if (!_input.empty() && !_input.is_object())
@@ -425,13 +617,13 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showTimings", "showUnproved", "showUnsupported", "solvers", "targets", "timeout", "verifyAgreement", "persistentSolvers"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -816,6 +1008,15 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned() || settings["parallelism"].get<size_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].get<size_t>();
+	}
+
+	ret.cacheDirectory = m_cacheDirectory;
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1097,6 +1298,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.showProvedSafe = showProvedSafe.get<bool>();
 	}
 
+	if (modelCheckerSettings.contains("showTimings"))
+	{
+		auto const& showTimings = modelCheckerSettings["showTimings"];
+		if (!showTimings.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.showTimings must be a Boolean value.");
+		ret.modelCheckerSettings.showTimings = showTimings.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("showUnproved"))
 	{
 		auto const& showUnproved = modelCheckerSettings["showUnproved"];
@@ -1171,6 +1380,24 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].get<Json::number_unsigned_t>();
 	}
 
+	if (modelCheckerSettings.contains("verifyAgreement"))
+	{
+		auto const& verifyAgreement = modelCheckerSettings["verifyAgreement"];
+		if (!verifyAgreement.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.verifyAgreement must be a Boolean value.");
+		ret.modelCheckerSettings.verifyAgreement = verifyAgreement.get<bool>();
+	}
+
+	if (modelCheckerSettings.contains("persistentSolvers"))
+	{
+		auto const& persistentSolvers = modelCheckerSettings["persistentSolvers"];
+		if (!persistentSolvers.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.persistentSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.persistentSolvers = persistentSolvers.get<bool>();
+	}
+
+	ret.modelCheckerSettings.cacheDirectory = m_modelCheckerCacheDirectory;
+
 	return {std::move(ret)};
 }
 
@@ -1298,7 +1525,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
-	CompilerStack compilerStack(m_readFile);
+	// Shared, since compile(std::string) might still need the ASTs after this function returns.
+	auto compilerStackPointer = std::make_shared<CompilerStack>(m_readFile);
+	CompilerStack& compilerStack = *compilerStackPointer;
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1306,6 +1535,7 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -1321,11 +1551,28 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	bool const optimizerProfileRequested = isOptimizerProfileRequested(_inputsAndSettings.outputSelection);
+	compilerStack.enableOptimiserProfiling(optimizerProfileRequested);
 
 	Json errors = std::move(_inputsAndSettings.errors);
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
+	// Output of requested contracts is served from the cache where possible and code is only generated
+	// for the remaining contracts (and the contracts they depend on). Profiles are only meaningful
+	// for an actual optimizer run, so the cache is bypassed if one is requested.
+	std::optional<ArtifactCache> artifactCache;
+	if (
+		_inputsAndSettings.cacheDirectory.has_value() &&
+		_inputsAndSettings.language == "Solidity" &&
+		binariesRequested &&
+		!optimizerProfileRequested
+	)
+		artifactCache.emplace(*_inputsAndSettings.cacheDirectory);
+	std::map<std::string, h256> artifactCacheKeys;
+	std::map<std::string, Json> cachedArtifacts;
+	size_t analysisErrorCount = 0;
+
 	try
 	{
 		if (_inputsAndSettings.language == "SolidityAST")
@@ -1345,7 +1592,39 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		}
 		else
 		{
-			if (binariesRequested)
+			if (artifactCache)
+			{
+				if (compilerStack.parseAndAnalyze() && !compilerStack.isExperimentalSolidity())
+				{
+					analysisErrorCount = compilerStack.errors().size();
+					auto const requestedContracts = requestedContractNames(_inputsAndSettings.outputSelection);
+					std::map<std::string, std::set<std::string>> uncachedContracts;
+					for (std::string const& contractName: compilerStack.contractNames())
+					{
+						ContractDefinition const& contract = compilerStack.contractDefinition(contractName);
+						if (!isRequestedContract(requestedContracts, contract.sourceUnitName(), contract.name()))
+							continue;
+
+						h256 key = artifactCacheKey(
+							compilerStack,
+							contractName,
+							_inputsAndSettings.debugInfoSelection,
+							_inputsAndSettings.outputSelection
+						);
+						artifactCacheKeys[contractName] = key;
+						if (std::optional<Json> artifacts = artifactCache->load(key))
+							cachedArtifacts[contractName] = std::move(*artifacts);
+						else
+							uncachedContracts[contract.sourceUnitName()].insert(contract.name());
+					}
+					compilerStack.setRequestedContractNames(uncachedContracts);
+					if (!uncachedContracts.empty())
+						compilerStack.compile();
+				}
+				else if (compilerStack.state() >= CompilerStack::State::AnalysisSuccessful)
+					compilerStack.compile();
+			}
+			else if (binariesRequested)
 				compilerStack.compile();
 			else
 				compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
@@ -1417,7 +1696,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 
 	bool parsingSuccess = compilerStack.state() >= CompilerStack::State::Parsed;
 	bool analysisSuccess = compilerStack.state() >= CompilerStack::State::AnalysisSuccessful;
-	bool compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool compilationSuccess =
+		compilerStack.state() == CompilerStack::State::CompilationSuccessful ||
+		(analysisSuccess && !artifactCacheKeys.empty() && cachedArtifacts.size() == artifactCacheKeys.size());
 
 	// If analysis fails, the artifacts inside CompilerStack are potentially incomplete and must not be returned.
 	// Note that not completing analysis due to stopAfter does not count as a failure. It's neither failure nor success.
@@ -1438,6 +1719,7 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	bool const wildcardMatchesExperimental = false;
 
 	output["sources"] = Json::object();
+	std::set<std::string> deferredASTs;
 	unsigned sourceIndex = 0;
 	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
 	// stopAfter: parsing with no parsing errors.
@@ -1447,10 +1729,19 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			Json sourceResult;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			{
+				if (m_deferOutputs)
+					deferredASTs.insert(sourceName);
+				else
+					sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
+	// The artifact cache stores the output of a contract as a whole, so it is only written
+	// directly by compile(std::string) if there is no cache.
+	bool const deferContracts = m_deferOutputs && !artifactCache;
+	std::map<std::string, std::map<std::string, std::string>> deferredContracts;
 	Json contractsOutput;
 	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
 	{
@@ -1459,86 +1750,41 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		std::string file = contractName.substr(0, colon);
 		std::string name = contractName.substr(colon + 1);
 
-		// ABI, storage layout, documentation and metadata
-		Json contractData;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
-			contractData["irAst"] = compilerStack.yulIRAst(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
-			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
-
-		// EVM
-		Json evmData;
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](std::string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		// Cached artifacts are only valid as part of a successful compilation, like freshly generated ones.
+		if (compilationSuccess && cachedArtifacts.count(contractName))
+		{
+			if (!cachedArtifacts.at(contractName).empty())
+				contractsOutput[file][name] = std::move(cachedArtifacts.at(contractName));
+			continue;
+		}
+
+		if (deferContracts)
+		{
+			if (isContractOutputRequested(_inputsAndSettings.outputSelection, file, name, compilationSuccess))
+				deferredContracts[file][name] = contractName;
+			continue;
+		}
 
-		if (compilationSuccess && isArtifactRequested(
+		Json contractData = contractOutput(
+			compilerStack,
 			_inputsAndSettings.outputSelection,
+			_inputsAndSettings.evmVersion,
+			sourceList,
 			file,
 			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](std::string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+			contractName,
+			compilationSuccess
+		);
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+		// Diagnostics reported during code generation are not part of the cached output,
+		// so the output is only cached if there were none.
+		if (
+			artifactCacheKeys.count(contractName) &&
+			compilationSuccess &&
+			compilerStack.errors().size() == analysisErrorCount
+		)
+			if (std::optional<std::string> cacheError = artifactCache->store(artifactCacheKeys.at(contractName), contractData))
+				output["errors"].emplace_back(formatError(Error::Type::Warning, "general", *cacheError));
 
 		if (!contractData.empty())
 		{
@@ -1550,6 +1796,23 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (!deferredASTs.empty() || !deferredContracts.empty())
+		m_deferredOutputs = DeferredOutputs{
+			compilerStackPointer,
+			std::move(deferredASTs),
+			std::move(deferredContracts),
+			_inputsAndSettings.outputSelection,
+			_inputsAndSettings.evmVersion,
+			std::move(sourceList),
+			compilationSuccess
+		};
+
+	if (!artifactCacheKeys.empty())
+	{
+		output["cache"]["hits"] = cachedArtifacts.size();
+		output["cache"]["misses"] = artifactCacheKeys.size() - cachedArtifacts.size();
+	}
+
 	return output;
 }
 
@@ -1700,8 +1963,15 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json StandardCompiler::compile(Json const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Uses a Yul string repository of its own, which is released once the compilation is done,
+	// unless this is called from compile(std::string const&).
+	YulStringRepository::CompilationScope yulStringScope;
 
+	return compileInput(_input);
+}
+
+Json StandardCompiler::compileInput(Json const& _input) noexcept
+{
 	try
 	{
 		auto parsed = parseInput(_input);
@@ -1747,13 +2017,45 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 			return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON: " + errors + "\"}]}";
 	}
 
+	// The scope has to outlive writing the output, since the deferred outputs refer to Yul strings.
+	YulStringRepository::CompilationScope yulStringScope;
+
+	m_deferOutputs = true;
+	ScopeGuard releaseDeferredOutputs([&]() {
+		m_deferOutputs = false;
+		m_deferredOutputs.reset();
+	});
+
 //	std::cout << "Input: " << solidity::util::jsonPrettyPrint(input) << std::endl;
-	Json output = compile(input);
+	Json output = compileInput(input);
 //	std::cout << "Output: " << solidity::util::jsonPrettyPrint(output) << std::endl;
 
+	Json fatalError;
+	try
+	{
+		std::string result;
+		util::JsonWriter writer(result, m_jsonPrintingFormat);
+		writeOutput(writer, output);
+		return result;
+	}
+	catch (Json::exception const&)
+	{
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+	}
+	// Generating a deferred output failed, which compile(Json const&) reports like compileInput() does.
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
+		fatalError = formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+	}
+	catch (...)
+	{
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::current_exception_diagnostic_information());
+	}
+
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		return util::jsonPrint(fatalError, m_jsonPrintingFormat);
 	}
 	catch (...)
 	{
@@ -1761,6 +2063,62 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::writeOutput(util::JsonWriter& _writer, Json const& _output) const
+{
+	if (!m_deferredOutputs)
+	{
+		_writer.value(_output);
+		return;
+	}
+
+	DeferredOutputs const& deferred = *m_deferredOutputs;
+	CompilerStack const& compilerStack = *deferred.compilerStack;
+	std::map<std::string, util::JsonWriter::MemberWriter> memberWriters;
+	if (!deferred.sourceNames.empty())
+		memberWriters["sources"] = [&](util::JsonWriter& _sourcesWriter) {
+			ASTJsonExporter exporter(compilerStack.state(), compilerStack.sourceIndices());
+			_sourcesWriter.beginObject();
+			for (auto const& [sourceName, sourceOutput]: _output["sources"].items())
+			{
+				_sourcesWriter.key(sourceName);
+				if (deferred.sourceNames.count(sourceName))
+					_sourcesWriter.object(sourceOutput, {{"ast", [&](util::JsonWriter& _astWriter) {
+						exporter.write(_astWriter, compilerStack.ast(sourceName));
+					}}});
+				else
+					_sourcesWriter.value(sourceOutput);
+			}
+			_sourcesWriter.endObject();
+		};
+	if (!deferred.contractNames.empty())
+		// Only the output of a single contract exists as json at any time.
+		memberWriters["contracts"] = [&](util::JsonWriter& _contractsWriter) {
+			_contractsWriter.beginObject();
+			for (auto const& [file, contracts]: deferred.contractNames)
+			{
+				_contractsWriter.key(file);
+				_contractsWriter.beginObject();
+				for (auto const& [name, contractName]: contracts)
+				{
+					_contractsWriter.key(name);
+					_contractsWriter.value(contractOutput(
+						compilerStack,
+						deferred.outputSelection,
+						deferred.evmVersion,
+						deferred.sourceList,
+						file,
+						name,
+						contractName,
+						deferred.compilationSuccess
+					));
+				}
+				_contractsWriter.endObject();
+			}
+			_contractsWriter.endObject();
+		};
+	_writer.object(_output, memberWriters);
+}
+
 Json StandardCompiler::formatFunctionDebugData(
 	std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
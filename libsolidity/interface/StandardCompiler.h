@@ -28,7 +28,9 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <memory>
 #include <optional>
+#include <set>
 #include <utility>
 #include <variant>
 
@@ -56,6 +58,14 @@ public:
 	{
 	}
 
+	/// Sets the directory used to cache compilation artifacts between invocations.
+	/// The input cannot specify this directory, since it may come from an untrusted source and the
+	/// compiler writes to the directory.
+	void setCacheDirectory(std::string _cacheDirectory) { m_cacheDirectory = std::move(_cacheDirectory); }
+	/// Sets the directory in which the SMTChecker caches the answers of solvers invoked as external
+	/// programs. Like the artifact cache, it cannot be specified by the input.
+	void setModelCheckerCacheDirectory(std::string _cacheDirectory) { m_modelCheckerCacheDirectory = std::move(_cacheDirectory); }
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json compile(Json const& _input) noexcept;
@@ -89,20 +99,49 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		std::optional<std::string> cacheDirectory;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
+	/// Source ASTs and contract outputs whose json is not part of the output of compileSolidity(),
+	/// but written directly by compile(std::string), so that they never exist as a whole in memory.
+	struct DeferredOutputs
+	{
+		std::shared_ptr<CompilerStack const> compilerStack;
+		/// Sources whose AST is deferred.
+		std::set<std::string> sourceNames;
+		/// Fully qualified names of the contracts whose output is deferred, by source and contract name.
+		std::map<std::string, std::map<std::string, std::string>> contractNames;
+		Json outputSelection;
+		langutil::EVMVersion evmVersion;
+		StringMap sourceList;
+		bool compilationSuccess = false;
+	};
+
+	/// Performs the processing steps of compile(Json const&) without resetting the Yul string repository.
+	Json compileInput(Json const& _input) noexcept;
+	/// Writes @a _output, inserting the ASTs and contract outputs in m_deferredOutputs.
+	void writeOutput(util::JsonWriter& _writer, Json const& _output) const;
+
 	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
 	Json compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::optional<std::string> m_cacheDirectory;
+	std::optional<std::string> m_modelCheckerCacheDirectory;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	/// If set, compileSolidity() leaves the requested ASTs and, unless they are cached,
+	/// the contract outputs to writeOutput().
+	bool m_deferOutputs = false;
+	std::optional<DeferredOutputs> m_deferredOutputs;
 };
 
 }
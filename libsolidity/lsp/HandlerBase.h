@@ -45,8 +45,9 @@ public:
 	/// from the JSON-RPC parameters.
 	std::pair<std::string, langutil::LineColumn> extractSourceUnitNameAndLineColumn(Json const& _params) const;
 
-	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return m_server.compilerStack(); }
-	FileRepository& fileRepository() const noexcept { return m_server.fileRepository(); }
+	/// Char streams of the last completed analysis of each source unit, which requests are answered from.
+	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return m_server; }
+	FileRepository const& fileRepository() const noexcept { return m_server.fileRepository(); }
 	Transport& client() const noexcept { return m_server.client(); }
 
 protected:
@@ -34,6 +34,8 @@
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Result.h>
+#include <libsolutil/StringUtils.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
 
@@ -41,8 +43,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <string>
+#include <thread>
 
 #include <fmt/format.h>
 
@@ -59,6 +63,27 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// Time without incoming messages after a source change before the diagnostics are updated.
+constexpr std::chrono::milliseconds diagnosticsUpdateDelay{100};
+/// Maximum time the diagnostics update is postponed while messages keep arriving.
+constexpr std::chrono::milliseconds maxDiagnosticsUpdateDelay{1000};
+/// Number of latency samples per operation after which their percentiles are logged.
+constexpr size_t latencyReportInterval = 50;
+
+/// Requests that take or return positions in the sources.
+std::set<std::string> const requestsOnSources{
+	"textDocument/definition",
+	"textDocument/hover",
+	"textDocument/implementation",
+	"textDocument/rename",
+	"textDocument/semanticTokens/full",
+};
+
+/// Requests whose results are edits, which the client applies to its current buffers.
+std::set<std::string> const requestsReturningEdits{
+	"textDocument/rename",
+};
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -150,10 +175,29 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/implementation", GotoDefinition(*this) },
 		{"textDocument/semanticTokens/full", std::bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
+		{"workspace/didChangeWatchedFiles", std::bind(&LanguageServer::handleWorkspaceDidChangeWatchedFiles, this, _2)},
 	},
-	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_fileRepository("/" /* basePath */, {} /* no search paths */)
+{
+}
+
+LanguageServer::Analysis::Analysis(fs::path const& _basePath, std::vector<fs::path> _includePaths):
+	fileRepository(_basePath, std::move(_includePaths))
+{
+	// The compiler stack resets the types of the provider that is current when it is created.
+	TypeProvider::Scope typeProviderScope(typeProvider);
+	compilerStack = std::make_unique<CompilerStack>(fileRepository.reader());
+}
+
+LanguageServer::Analysis const& LanguageServer::analysis(std::string const& _sourceUnitName) const
 {
+	lspRequire(analyzed(_sourceUnitName), ErrorCode::RequestFailed, "Unknown file: " + _sourceUnitName);
+	return *m_analyses.at(_sourceUnitName);
+}
+
+CharStream const& LanguageServer::charStream(std::string const& _sourceUnitName) const
+{
+	return analysis(_sourceUnitName).compilerStack->charStream(_sourceUnitName);
 }
 
 Json LanguageServer::toRange(SourceLocation const& _location)
@@ -205,6 +249,8 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 					typeFailureCount++;
 			}
 			m_fileRepository.setIncludePaths(std::move(includePaths));
+			m_forceAnalysis = true;
+			scheduleDiagnosticsUpdate();
 		}
 		else
 			++typeFailureCount;
@@ -214,7 +260,7 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 }
 
-std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
+std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject(fs::path const& _basePath)
 {
 	std::vector<fs::path> collectedPaths{};
 
@@ -222,9 +268,9 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	// open for a future PR to enable such a feature to be optionally enabled (default disabled).
 	// Note: Newer versions of boost have deprecated symlink_option::recurse
 #if (BOOST_VERSION < 107200)
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::symlink_option::recurse);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::symlink_option::recurse);
 #else
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::directory_options::follow_directory_symlink);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::directory_options::follow_directory_symlink);
 #endif
 	for (fs::directory_entry const& dirEntry: directoryIterator)
 		if (
@@ -236,78 +282,376 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+std::string const& LanguageServer::cachedFileContent(fs::path const& _path)
+{
+	std::time_t const now = std::time(nullptr);
+	std::time_t const lastWriteTime = fs::last_write_time(_path);
+	std::uintmax_t const size = fs::file_size(_path);
+
+	auto it = m_diskFiles.find(_path);
+	if (
+		it == m_diskFiles.end() ||
+		it->second.lastWriteTime != lastWriteTime ||
+		it->second.size != size ||
+		it->second.lastWriteTime >= it->second.readTime
+	)
+	{
+		lspDebug(fmt::format("reading file from disk: {}", _path.generic_string()));
+		it = m_diskFiles.insert_or_assign(
+			_path,
+			DiskFile{lastWriteTime, size, now, m_compilationCount, util::readFileAsString(_path)}
+		).first;
+	}
+	it->second.lastUsed = m_compilationCount;
+	return it->second.content;
+}
+
+std::set<std::string> LanguageServer::changedSourceUnits(FileRepository const& _fileRepository)
+{
+	solAssert(m_analyzedSources);
+
+	std::set<std::string> changed;
+	for (auto const& [sourceUnitName, content]: _fileRepository.sourceUnits())
+		if (!m_analyzedSources->count(sourceUnitName) || m_analyzedSources->at(sourceUnitName) != content)
+			changed.insert(sourceUnitName);
+
+	for (auto const& [sourceUnitName, content]: *m_analyzedSources)
+	{
+		if (_fileRepository.sourceUnits().count(sourceUnitName))
+			continue;
+
+		// Source units that were loaded through imports are not in the repository yet,
+		// so compare them against what the read callback would load now.
+		util::Result<fs::path> const resolvedPath = _fileRepository.tryResolvePath(stripFileUriSchemePrefix(sourceUnitName));
+		try
+		{
+			if (!resolvedPath.message().empty() || cachedFileContent(resolvedPath.get()) != content)
+				changed.insert(sourceUnitName);
+		}
+		catch (fs::filesystem_error const&)
+		{
+			changed.insert(sourceUnitName);
+		}
+	}
+
+	return changed;
+}
+
+std::set<std::string> LanguageServer::importingSourceUnits(std::set<std::string> const& _sourceUnitNames) const
+{
+	std::map<std::string, std::set<std::string>> importedBy;
+	for (auto const& [sourceUnitName, imports]: m_imports)
+		for (std::string const& import: imports)
+			importedBy[import].insert(sourceUnitName);
+
+	std::set<std::string> importing = _sourceUnitNames;
+	std::vector<std::string> toVisit(_sourceUnitNames.begin(), _sourceUnitNames.end());
+	while (!toVisit.empty())
+	{
+		std::string const sourceUnitName = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (importedBy.count(sourceUnitName))
+			for (std::string const& importingSourceUnit: importedBy.at(sourceUnitName))
+				if (importing.insert(importingSourceUnit).second)
+					toVisit.push_back(importingSourceUnit);
+	}
+	return importing;
+}
+
+std::optional<LanguageServer::AnalysisResult> LanguageServer::analyze(AnalysisJob const& _job)
 {
 	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
+	// so the repository only contains the open files and the ones on disk.
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	++m_compilationCount;
+	ScopeGuard evictUnusedDiskFiles([&]() {
+		for (auto it = m_diskFiles.begin(); it != m_diskFiles.end();)
+			if (it->second.lastUsed != m_compilationCount)
+				it = m_diskFiles.erase(it);
+			else
+				++it;
+	});
+	for (fs::path const& changedFile: _job.changedFiles)
+		m_diskFiles.erase(changedFile);
+	if (_job.forceAnalysis)
+		m_analyzedSources.reset();
+
+	AnalysisResult result;
+	result.generation = _job.generation;
+	auto analysis = std::make_shared<Analysis>(_job.basePath, _job.includePaths);
+	FileRepository& fileRepository = analysis->fileRepository;
 
 	// Load all solidity files from project.
-	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		for (auto const& projectFile: allSolidityFilesFromProject())
+	// Files that did not change on disk are not read again.
+	if (_job.fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
+		for (auto const& projectFile: allSolidityFilesFromProject(_job.basePath))
 		{
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+			fileRepository.setSourceByUri(
+				fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
+				cachedFileContent(projectFile)
 			);
 		}
 
 	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
-		);
+	for (auto const& [uri, content]: _job.openFiles)
+		fileRepository.setSourceByUri(uri, content);
+
+	// Only the source units that changed and the ones importing them are analyzed again.
+	// All other source units keep the results of their last analysis.
+	std::set<std::string> outdated;
+	if (m_analyzedSources)
+	{
+		std::set<std::string> const changed = changedSourceUnits(fileRepository);
+		if (changed.empty())
+		{
+			lspDebug("no source unit changed, skipping analysis");
+			return result;
+		}
+		outdated = importingSourceUnits(changed);
+		lspDebug(fmt::format(
+			"changed source units: {}, analyzing: {}",
+			util::joinHumanReadable(changed),
+			util::joinHumanReadable(outdated)
+		));
+	}
+	else
+		outdated = util::keys(fileRepository.sourceUnits());
+
+	StringMap sources;
+	for (std::string const& sourceUnitName: outdated)
+		if (fileRepository.sourceUnits().count(sourceUnitName))
+			sources[sourceUnitName] = fileRepository.sourceUnits().at(sourceUnitName);
+
+	CompilerStack& compilerStack = *analysis->compilerStack;
+	bool const analyzing = !sources.empty();
+	if (analyzing)
+	{
+		TypeProvider::Scope typeProviderScope(analysis->typeProvider);
+		yul::YulStringRepository::CompilationScope yulStringScope(analysis->yulStringRepository);
+		// The source units that are not imported by the outdated ones are loaded by the read callback.
+		compilerStack.setSources(std::move(sources));
+		// Newer changes make the result useless, so they cancel the analysis between its stages.
+		bool const parsed = compilerStack.parse();
+		if (analysisCancelled(_job.generation))
+			return std::nullopt;
+		if (parsed)
+			compilerStack.analyze();
+	}
+
+	if (!m_analyzedSources)
+	{
+		m_analyzedSources.emplace();
+		m_imports.clear();
+		result.complete = true;
+	}
+
+	if (analyzing)
+		for (std::string const& sourceUnitName: compilerStack.sourceNames())
+		{
+			// Source units imported by the outdated ones did not change, so they keep their analysis.
+			if (!outdated.count(sourceUnitName) && m_analyzedSources->count(sourceUnitName))
+				continue;
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+			result.analyzedSourceUnits.insert(sourceUnitName);
+			(*m_analyzedSources)[sourceUnitName] = compilerStack.charStream(sourceUnitName).source();
+			// If parsing failed, the imports of the last successful parse are the best guess.
+			if (compilerStack.state() >= CompilerStack::ParsedAndImported)
+			{
+				std::set<std::string>& imports = m_imports[sourceUnitName];
+				imports.clear();
+				for (auto const* import: ASTNode::filteredNodes<ImportDirective>(compilerStack.ast(sourceUnitName).nodes()))
+					imports.insert(*import->annotation().absolutePath);
+			}
+		}
+	if (!result.analyzedSourceUnits.empty())
+		result.analysis = std::move(analysis);
+
+	// Source units loaded through imports are only kept as long as they are imported.
+	std::set<std::string> live = util::keys(fileRepository.sourceUnits());
+	std::vector<std::string> toVisit(live.begin(), live.end());
+	while (!toVisit.empty())
+	{
+		std::string const sourceUnitName = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (m_imports.count(sourceUnitName))
+			for (std::string const& import: m_imports.at(sourceUnitName))
+				if (m_analyzedSources->count(import) && live.insert(import).second)
+					toVisit.push_back(import);
+	}
+	for (auto it = m_analyzedSources->begin(); it != m_analyzedSources->end();)
+		if (!live.count(it->first))
+		{
+			result.removedSourceUnits.insert(it->first);
+			m_imports.erase(it->first);
+			it = m_analyzedSources->erase(it);
+		}
+		else
+			++it;
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	return result;
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::analyzeInBackground()
 {
-	compile();
+	while (true)
+	{
+		AnalysisJob job;
+		{
+			std::unique_lock lock(m_analysisMutex);
+			m_analysisRequested.wait(lock, [&]() { return m_analysisJob || m_analysisStopped; });
+			if (m_analysisStopped)
+				return;
+			job = std::move(*m_analysisJob);
+			m_analysisJob.reset();
+		}
 
+		// A completed analysis is handed over even if it is outdated already,
+		// since it is still more recent than the ones requests are answered from.
+		std::optional<AnalysisResult> result;
+		try
+		{
+			result = analyze(job);
+		}
+		catch (...)
+		{
+			result.emplace();
+			result->generation = job.generation;
+			result->exception = std::current_exception();
+		}
+		if (!result)
+			continue;
+
+		{
+			std::lock_guard lock(m_inputMutex);
+			m_analysisResult = std::move(result);
+		}
+		m_inputAvailable.notify_one();
+	}
+}
+
+bool LanguageServer::analysisCancelled(size_t _generation)
+{
+	std::lock_guard lock(m_analysisMutex);
+	return m_analysisStopped || _generation != m_analysisGeneration;
+}
+
+void LanguageServer::scheduleDiagnosticsUpdate()
+{
+	m_lastSourceChange = std::chrono::steady_clock::now();
+	if (!m_diagnosticsOutdatedSince)
+		m_diagnosticsOutdatedSince = m_lastSourceChange;
+	if (!m_unanalyzedChangesSince)
+		m_unanalyzedChangesSince = m_lastSourceChange;
+}
+
+void LanguageServer::startAnalysis()
+{
+	AnalysisJob job;
+	job.basePath = m_fileRepository.basePath();
+	job.includePaths = m_fileRepository.includePaths();
+	job.fileLoadStrategy = m_fileLoadStrategy;
+	for (std::string const& uri: m_openFiles)
+		job.openFiles[uri] = m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(uri));
+	job.changedFiles = std::move(m_changedFiles);
+	job.forceAnalysis = m_forceAnalysis;
+	m_changedFiles.clear();
+	m_forceAnalysis = false;
+	m_unanalyzedChangesSince.reset();
+	if (!m_diagnosticsOutdatedSince)
+		m_diagnosticsOutdatedSince = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard lock(m_analysisMutex);
+		job.generation = ++m_analysisGeneration;
+		// A job the worker did not take yet is superseded, but what it carried still has to be applied.
+		if (m_analysisJob)
+		{
+			job.changedFiles.merge(m_analysisJob->changedFiles);
+			job.forceAnalysis = job.forceAnalysis || m_analysisJob->forceAnalysis;
+		}
+		m_analysisJob = std::move(job);
+	}
+	m_analysisRequested.notify_one();
+}
+
+void LanguageServer::handleAnalysisResult(AnalysisResult _result)
+{
+	if (_result.complete)
+		m_analyses.clear();
+	for (std::string const& sourceUnitName: _result.removedSourceUnits)
+		m_analyses.erase(sourceUnitName);
+	for (std::string const& sourceUnitName: _result.analyzedSourceUnits)
+		m_analyses[sourceUnitName] = _result.analysis;
+	// Diagnostics are only published for the most recent sources.
+	if (_result.generation != m_analysisGeneration)
+		return;
+
+	m_completedGeneration = _result.generation;
+	if (_result.exception)
+		// The sources were not analyzed completely, so they have to be analyzed again next time.
+		m_forceAnalysis = true;
+	else
+		updateDiagnostics();
+
+	std::vector<ReceivedMessage> requests = std::move(m_requestsWaitingForAnalysis);
+	m_requestsWaitingForAnalysis.clear();
+	// Messages that were held back may change the sources again, so the requests after them
+	// might have to wait for the next analysis.
+	for (ReceivedMessage& request: requests)
+		handleOrDefer(std::move(request));
+
+	if (_result.exception)
+		std::rethrow_exception(_result.exception);
+}
+
+void LanguageServer::updateDiagnostics()
+{
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	std::map<std::string, Json> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (std::string const& sourceUnitName: m_analyses | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	std::set<Analysis const*> reportedAnalyses;
+	for (std::shared_ptr<Analysis> const& analysis: m_analyses | ranges::views::values)
 	{
-		SourceLocation const* location = error->sourceLocation();
-		if (!location || !location->sourceName)
-			// LSP only has diagnostics applied to individual files.
+		if (!reportedAnalyses.insert(analysis.get()).second)
 			continue;
 
-		Json jsonDiag;
-		jsonDiag["source"] = "solc";
-		jsonDiag["severity"] = toDiagnosticSeverity(error->type());
-		jsonDiag["code"] = Json(error->errorId().error);
-		std::string message = Error::formatErrorType(error->type()) + ":";
-		if (std::string const* comment = error->comment())
-			message += " " + *comment;
-		jsonDiag["message"] = std::move(message);
-		jsonDiag["range"] = toRange(*location);
-
-		if (auto const* secondary = error->secondarySourceLocation())
-			for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
-			{
-				Json jsonRelated;
-				jsonRelated["message"] = secondaryMessage;
-				jsonRelated["location"] = toJson(secondaryLocation);
-				jsonDiag["relatedInformation"].emplace_back(jsonRelated);
-			}
+		for (std::shared_ptr<Error const> const& error: analysis->compilerStack->errors())
+		{
+			SourceLocation const* location = error->sourceLocation();
+			if (!location || !location->sourceName)
+				// LSP only has diagnostics applied to individual files.
+				continue;
+			// Errors in source units that were analyzed again later are outdated.
+			if (!analyzed(*location->sourceName) || m_analyses.at(*location->sourceName) != analysis)
+				continue;
+
+			Json jsonDiag;
+			jsonDiag["source"] = "solc";
+			jsonDiag["severity"] = toDiagnosticSeverity(error->type());
+			jsonDiag["code"] = Json(error->errorId().error);
+			std::string message = Error::formatErrorType(error->type()) + ":";
+			if (std::string const* comment = error->comment())
+				message += " " + *comment;
+			jsonDiag["message"] = std::move(message);
+			jsonDiag["range"] = toRange(*location);
+
+			if (auto const* secondary = error->secondarySourceLocation())
+				for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
+				{
+					Json jsonRelated;
+					jsonRelated["message"] = secondaryMessage;
+					jsonRelated["location"] = toJson(secondaryLocation);
+					jsonDiag["relatedInformation"].emplace_back(jsonRelated);
+				}
 
-		diagnosticsBySourceUnit[*location->sourceName].emplace_back(jsonDiag);
+			diagnosticsBySourceUnit[*location->sourceName].emplace_back(jsonDiag);
+		}
 	}
 
 	if (m_client.traceValue() != TraceValue::Off)
@@ -327,47 +671,257 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		params["diagnostics"] = std::move(diagnostics);
 		m_client.notify("textDocument/publishDiagnostics", std::move(params));
 	}
+
+	if (m_diagnosticsOutdatedSince)
+	{
+		recordLatency("diagnostics", std::chrono::steady_clock::now() - *m_diagnosticsOutdatedSince);
+		m_diagnosticsOutdatedSince = m_unanalyzedChangesSince;
+	}
 }
 
-bool LanguageServer::run()
+void LanguageServer::receiveMessages()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	bool exitReceived = false;
+	while (!exitReceived && !m_client.closed())
 	{
-		MessageID id;
+		std::optional<Json> jsonMessage;
 		try
 		{
-			std::optional<Json> const jsonMessage = m_client.receive();
-			if (!jsonMessage)
-				continue;
+			jsonMessage = m_client.receive();
+		}
+		catch (...)
+		{
+			m_client.error({}, ErrorCode::ParseError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+		}
+		if (!jsonMessage)
+			continue;
 
-			if ((*jsonMessage).contains("method") && (*jsonMessage)["method"].is_string())
-			{
-				std::string const methodName = (*jsonMessage)["method"].get<std::string>();
-				if ((*jsonMessage).contains("id"))
-					id = (*jsonMessage)["id"];
-				lspDebug(fmt::format("received method call: {}", methodName));
+		exitReceived = jsonMessage->contains("method") && (*jsonMessage)["method"] == "exit";
+		{
+			std::lock_guard lock(m_inputMutex);
+			m_input.push_back({std::move(*jsonMessage), std::chrono::steady_clock::now()});
+		}
+		m_inputAvailable.notify_one();
+	}
 
-				if (auto handler = util::valueOrDefault(m_handlers, methodName))
-					handler(id, (*jsonMessage)["params"]);
-				else
-					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
-			}
-			else
-				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+	{
+		std::lock_guard lock(m_inputMutex);
+		m_inputClosed = true;
+	}
+	m_inputAvailable.notify_one();
+}
+
+std::optional<LanguageServer::ReceivedMessage> LanguageServer::nextMessage()
+{
+	std::unique_lock lock(m_inputMutex);
+	auto const inputAvailable = [&]() { return !m_input.empty() || m_inputClosed || m_analysisResult; };
+
+	if (m_unanalyzedChangesSince)
+	{
+		// Edits usually arrive in bursts. Wait for the burst to end so that only the
+		// analysis of the last state is run instead of one analysis per edit.
+		auto const deadline = std::min(
+			m_lastSourceChange + diagnosticsUpdateDelay,
+			*m_unanalyzedChangesSince + maxDiagnosticsUpdateDelay
+		);
+		if (!m_inputAvailable.wait_until(lock, deadline, inputAvailable))
+			return std::nullopt;
+	}
+	else
+		m_inputAvailable.wait(lock, inputAvailable);
+
+	if (m_analysisResult || m_input.empty())
+		return std::nullopt;
+
+	ReceivedMessage message = std::move(m_input.front());
+	m_input.pop_front();
+	return message;
+}
+
+void LanguageServer::recordLatency(std::string const& _operation, std::chrono::steady_clock::duration _latency)
+{
+	std::vector<double>& samples = m_latencySamples[_operation];
+	samples.push_back(std::chrono::duration<double, std::milli>(_latency).count());
+	if (samples.size() < latencyReportInterval)
+		return;
+
+	std::sort(samples.begin(), samples.end());
+	auto const percentile = [&](size_t _percent) { return samples[(samples.size() - 1) * _percent / 100]; };
+	std::string const report = fmt::format(
+		"{} latency over {} samples: p50 {:.1f} ms, p90 {:.1f} ms, p99 {:.1f} ms, max {:.1f} ms",
+		_operation,
+		samples.size(),
+		percentile(50),
+		percentile(90),
+		percentile(99),
+		samples.back()
+	);
+	lspDebug(report);
+	samples.clear();
+}
+
+std::optional<std::string> LanguageServer::requestedSourceUnit(Json const& _message) const
+{
+	if (
+		!_message.contains("params") ||
+		!_message["params"].contains("textDocument") ||
+		!_message["params"]["textDocument"].contains("uri") ||
+		!_message["params"]["textDocument"]["uri"].is_string()
+	)
+		return std::nullopt;
+
+	return m_fileRepository.uriToSourceUnitName(_message["params"]["textDocument"]["uri"].get<std::string>());
+}
+
+bool LanguageServer::waitsForAnalysis(Json const& _message) const
+{
+	if (!_message.contains("method"))
+		return false;
+
+	std::string const methodName = _message["method"].get<std::string>();
+	bool const analysisPending = m_unanalyzedChangesSince || m_completedGeneration != m_analysisGeneration;
+	// Edits computed from an outdated analysis would be applied to the wrong positions of the buffers.
+	if (requestsReturningEdits.count(methodName))
+		return analysisPending;
+	if (!requestsOnSources.count(methodName))
+		return false;
+
+	std::optional<std::string> const sourceUnitName = requestedSourceUnit(_message);
+	return sourceUnitName && !analyzed(*sourceUnitName) && analysisPending;
+}
+
+void LanguageServer::handleOrDefer(ReceivedMessage _message)
+{
+	// Messages received after a request that returns edits are held back as well,
+	// so that the edits refer to the buffers as they were when the request was sent.
+	bool deferred = std::any_of(
+		m_requestsWaitingForAnalysis.begin(),
+		m_requestsWaitingForAnalysis.end(),
+		[](ReceivedMessage const& _waiting) {
+			return
+				_waiting.message.contains("method") &&
+				_waiting.message["method"].is_string() &&
+				requestsReturningEdits.count(_waiting.message["method"].get<std::string>());
+		}
+	);
+	if (!deferred)
+		try
+		{
+			deferred = waitsForAnalysis(_message.message);
 		}
 		catch (Json::exception const&)
 		{
-			m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+			// Malformed requests are reported by handleMessage().
 		}
-		catch (RequestError const& error)
+
+	if (deferred)
+	{
+		if (m_unanalyzedChangesSince)
+			startAnalysis();
+		m_requestsWaitingForAnalysis.emplace_back(std::move(_message));
+	}
+	else
+		handleMessage(_message);
+}
+
+void LanguageServer::handleMessage(ReceivedMessage const& _message)
+{
+	MessageID id;
+	try
+	{
+		Json const& jsonMessage = _message.message;
+		if (jsonMessage.contains("method") && jsonMessage["method"].is_string())
 		{
-			m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+			std::string const methodName = jsonMessage["method"].get<std::string>();
+			if (jsonMessage.contains("id"))
+				id = jsonMessage["id"];
+			lspDebug(fmt::format("received method call: {}", methodName));
+
+			// Types and Yul strings created while answering requests belong to the analysis they refer to.
+			std::optional<TypeProvider::Scope> typeProviderScope;
+			std::optional<yul::YulStringRepository::CompilationScope> yulStringScope;
+			if (std::optional<std::string> const sourceUnitName = requestedSourceUnit(jsonMessage))
+				if (analyzed(*sourceUnitName))
+				{
+					Analysis& owner = *m_analyses.at(*sourceUnitName);
+					typeProviderScope.emplace(owner.typeProvider);
+					yulStringScope.emplace(owner.yulStringRepository);
+				}
+
+			if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				handler(id, jsonMessage["params"]);
+			else
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+
+			recordLatency(methodName, std::chrono::steady_clock::now() - _message.receivedAt);
 		}
-		catch (...)
+		else
+			m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+	}
+	catch (Json::exception const&)
+	{
+		m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+	}
+	catch (RequestError const& error)
+	{
+		m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+	}
+	catch (...)
+	{
+		m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+	}
+}
+
+bool LanguageServer::run()
+{
+	// Messages are read on a separate thread, so that we know whether further edits
+	// are waiting before starting an analysis. The analysis runs on another thread,
+	// so that requests can be answered from the last completed analysis in the meantime.
+	std::thread receiver(&LanguageServer::receiveMessages, this);
+	std::thread analysisWorker(&LanguageServer::analyzeInBackground, this);
+
+	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown)
+	{
+		std::optional<ReceivedMessage> receivedMessage = nextMessage();
+		if (!receivedMessage)
 		{
-			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			std::optional<AnalysisResult> analysisResult;
+			bool inputClosed = false;
+			{
+				std::lock_guard lock(m_inputMutex);
+				std::swap(analysisResult, m_analysisResult);
+				inputClosed = m_inputClosed && m_input.empty();
+			}
+
+			if (analysisResult)
+			{
+				try
+				{
+					handleAnalysisResult(std::move(*analysisResult));
+				}
+				catch (...)
+				{
+					m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+				}
+			}
+			else if (m_unanalyzedChangesSince)
+				startAnalysis();
+			else if (inputClosed)
+				break;
+			continue;
 		}
+
+		handleOrDefer(std::move(*receivedMessage));
+	}
+
+	{
+		std::lock_guard lock(m_analysisMutex);
+		m_analysisStopped = true;
 	}
+	m_analysisRequested.notify_one();
+	analysisWorker.join();
+	// The receiver stops by itself after the exit notification or at the end of the input.
+	receiver.join();
 	return m_state == State::ExitRequested;
 }
 
@@ -410,6 +964,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 		setTrace(_args["trace"]);
 
 	m_fileRepository = FileRepository(rootPath, {});
+	m_forceAnalysis = true;
 	if (_args.contains("initializationOptions") && _args["initializationOptions"].is_object())
 		changeConfiguration(_args["initializationOptions"]);
 
@@ -432,7 +987,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 void LanguageServer::handleInitialized(MessageID, Json const&)
 {
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		compileAndUpdateDiagnostics();
+		startAnalysis();
 }
 
 void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
@@ -440,13 +995,9 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 	if (_args.contains("textDocument") && _args["textDocument"].contains("uri"))
 	{
 		auto uri = _args["textDocument"]["uri"];
-
-		compile();
-
 		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
-		SourceUnit const& ast = m_compilerStack.ast(sourceName);
-		m_compilerStack.charStream(sourceName);
-		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+		CompilerStack const& compilerStack = *analysis(sourceName).compilerStack;
+		Json data = SemanticTokensBuilder().build(compilerStack.ast(sourceName), compilerStack.charStream(sourceName));
 
 		Json reply;
 		reply["data"] = data;
@@ -465,6 +1016,20 @@ void LanguageServer::handleWorkspaceDidChangeConfiguration(Json const& _args)
 		changeConfiguration(_args["settings"]);
 }
 
+void LanguageServer::handleWorkspaceDidChangeWatchedFiles(Json const& _args)
+{
+	requireServerInitialized();
+
+	if (!_args.contains("changes") || !_args["changes"].is_array())
+		return;
+
+	for (Json const& change: _args["changes"])
+		if (change.contains("uri") && change["uri"].is_string())
+			m_changedFiles.insert(fs::path(stripFileUriSchemePrefix(change["uri"].get<std::string>())));
+
+	scheduleDiagnosticsUpdate();
+}
+
 void LanguageServer::setTrace(Json const& _args)
 {
 	if (!_args.is_string())
@@ -496,7 +1061,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.insert(uri);
 		m_fileRepository.setSourceByUri(uri, std::move(text));
-		compileAndUpdateDiagnostics();
+		scheduleDiagnosticsUpdate();
 	}
 }
 
@@ -543,7 +1108,7 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		scheduleDiagnosticsUpdate();
 	}
 }
 
@@ -562,7 +1127,7 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
 
-		compileAndUpdateDiagnostics();
+		scheduleDiagnosticsUpdate();
 	}
 }
 
@@ -573,14 +1138,17 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	// The file might have been opened after the last completed analysis.
+	if (!analyzed(_sourceUnitName))
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+
+	CompilerStack const& compilerStack = *m_analyses.at(_sourceUnitName)->compilerStack;
+	if (compilerStack.state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {locateInnermostASTNode(*sourcePos, compilerStack.ast(_sourceUnitName)), *sourcePos};
 }
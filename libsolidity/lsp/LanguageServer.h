@@ -19,14 +19,26 @@
 
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
+#include <libyul/YulString.h>
+
+#include <liblangutil/CharStreamProvider.h>
+
 #include <libsolutil/JSON.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -57,15 +69,18 @@ enum class FileLoadStrategy
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Char streams are provided from the analysis each source unit was analyzed in last.
  */
-class LanguageServer
+class LanguageServer: public langutil::CharStreamProvider
 {
 public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
-	void compileAndUpdateDiagnostics();
+	/// Marks the diagnostics as outdated. The sources are analyzed in the background
+	/// once no further messages arrived for a short while.
+	void scheduleDiagnosticsUpdate();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
 	///
@@ -75,11 +90,35 @@ public:
 	/// @return boolean indicating normal or abnormal termination.
 	bool run();
 
+	/// Result of the analysis of the source units that changed and the ones importing them.
+	struct Analysis
+	{
+		Analysis(boost::filesystem::path const& _basePath, std::vector<boost::filesystem::path> _includePaths);
+
+		/// Sources given to the compiler, extended by the ones loaded through imports.
+		FileRepository fileRepository;
+		/// Provider of the types of this analysis, which is independent of the one
+		/// of an analysis that runs concurrently.
+		frontend::TypeProvider typeProvider;
+		/// Repository of the Yul strings in the inline assembly of the sources.
+		std::shared_ptr<yul::YulStringRepository> yulStringRepository = yul::YulStringRepository::create();
+		std::unique_ptr<frontend::CompilerStack> compilerStack;
+	};
+
+	/// @returns the current content of the files, including the changes not analyzed yet.
 	FileRepository& fileRepository() noexcept { return m_fileRepository; }
 	Transport& client() noexcept { return m_client; }
+	/// @returns the last completed analysis that includes the given source unit. Requests that refer
+	/// to positions in the sources are answered from it, while newer changes are analyzed in the background.
+	Analysis const& analysis(std::string const& _sourceUnitName) const;
+	/// @returns true if the given source unit is part of a completed analysis.
+	bool analyzed(std::string const& _sourceUnitName) const { return m_analyses.count(_sourceUnitName); }
+	/// @returns the last completed analysis of each source unit.
+	/// Source units that were analyzed together share the same analysis.
+	std::map<std::string, std::shared_ptr<Analysis>> const& analyses() const noexcept { return m_analyses; }
+	langutil::CharStream const& charStream(std::string const& _sourceUnitName) const override;
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -88,6 +127,7 @@ private:
 	void handleInitialize(MessageID _id, Json const& _args);
 	void handleInitialized(MessageID _id, Json const& _args);
 	void handleWorkspaceDidChangeConfiguration(Json const& _args);
+	void handleWorkspaceDidChangeWatchedFiles(Json const& _args);
 	void setTrace(Json const& _args);
 	void handleTextDocumentDidOpen(Json const& _args);
 	void handleTextDocumentDidChange(Json const& _args);
@@ -99,10 +139,103 @@ private:
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
+	struct ReceivedMessage
+	{
+		Json message;
+		std::chrono::steady_clock::time_point receivedAt;
+	};
+
+	/// Reads messages from the transport and queues them until the end of the input
+	/// or an exit notification. Runs on a separate thread.
+	void receiveMessages();
+
+	/// Sources to analyze, handed from the main loop to the analysis worker.
+	struct AnalysisJob
+	{
+		/// Number of the job. Jobs are superseded by the ones with a higher number.
+		size_t generation = 0;
+		boost::filesystem::path basePath;
+		std::vector<boost::filesystem::path> includePaths;
+		FileLoadStrategy fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
+		/// Content of the files opened by the client, by their URI.
+		std::map<std::string, std::string> openFiles;
+		/// Files on disk the client reported as changed.
+		std::set<boost::filesystem::path> changedFiles;
+		/// If true, the sources are analyzed even if none of them changed since the last analysis.
+		bool forceAnalysis = false;
+	};
+
+	struct AnalysisResult
+	{
+		size_t generation = 0;
+		/// The completed analysis or nullptr if no source unit had to be analyzed.
+		std::shared_ptr<Analysis> analysis;
+		/// Source units whose last completed analysis is the one above.
+		std::set<std::string> analyzedSourceUnits;
+		/// Source units that are neither part of the project nor imported anymore.
+		std::set<std::string> removedSourceUnits;
+		/// If true, all source units were analyzed and the previous analyses are discarded.
+		bool complete = false;
+		std::exception_ptr exception;
+	};
+
+	/// @returns the name of the source unit the message refers to, if any.
+	std::optional<std::string> requestedSourceUnit(Json const& _message) const;
+
+	/// Waits for the next message from the queue.
+	/// @returns nullopt if the input was closed, if the result of an analysis arrived
+	/// or if a scheduled diagnostics update is due.
+	std::optional<ReceivedMessage> nextMessage();
+
+	/// Handles a single message, replying with an error if it fails.
+	void handleMessage(ReceivedMessage const& _message);
+
+	/// @returns true if the message is a request that has to wait for the analysis running in the background:
+	/// A request that returns edits while any analysis is pending, or a request that refers to positions
+	/// in a source unit which is not part of the last completed analysis.
+	bool waitsForAnalysis(Json const& _message) const;
+
+	/// Handles the message right away if it can be answered from the last completed analysis.
+	/// Otherwise, it is handled once the analysis running in the background completed.
+	void handleOrDefer(ReceivedMessage _message);
+
+	/// Records the latency of an operation and periodically logs its percentiles.
+	void recordLatency(std::string const& _operation, std::chrono::steady_clock::duration _latency);
+
+	/// Hands the current sources over to the analysis worker, superseding the job it is working on.
+	void startAnalysis();
+
+	/// Takes over the analysis that completed in the background, publishes its diagnostics
+	/// and handles the requests that waited for it.
+	void handleAnalysisResult(AnalysisResult _result);
 
-	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
+	/// Publishes the diagnostics of the last completed analysis.
+	void updateDiagnostics();
+
+	/// Analyzes the sources of the submitted jobs until the server stops. Runs on a separate thread.
+	void analyzeInBackground();
+
+	/// @returns true if a job with a higher number was submitted or if the server stops.
+	bool analysisCancelled(size_t _generation);
+
+	/// Compiles the source units that changed since the last analysis and the ones importing them
+	/// until after analysis phase.
+	/// @returns nullopt if the analysis was cancelled.
+	std::optional<AnalysisResult> analyze(AnalysisJob const& _job);
+
+	/// @returns the given source units together with all source units importing them directly or indirectly.
+	std::set<std::string> importingSourceUnits(std::set<std::string> const& _sourceUnitNames) const;
+
+	/// @returns the names of all source units whose content differs from the one used in the last analysis,
+	/// including source units that were added or removed since then.
+	std::set<std::string> changedSourceUnits(FileRepository const& _fileRepository);
+
+	/// @returns the content of the given file on disk.
+	/// The file is only read again if its modification time or size changed since the last call,
+	/// if it was modified in the same second in which it was read, or if the client reported a change.
+	std::string const& cachedFileContent(boost::filesystem::path const& _path);
+
+	static std::vector<boost::filesystem::path> allSolidityFilesFromProject(boost::filesystem::path const& _basePath);
 
 	using MessageHandler = std::function<void(MessageID, Json const&)>;
 
@@ -117,14 +250,77 @@ private:
 	Transport& m_client;
 	std::map<std::string, MessageHandler> m_handlers;
 
+	std::mutex m_inputMutex;
+	std::condition_variable m_inputAvailable;
+	/// Messages received but not yet handled. Guarded by m_inputMutex.
+	std::deque<ReceivedMessage> m_input;
+	/// Set once no further messages will be received. Guarded by m_inputMutex.
+	bool m_inputClosed = false;
+
+	/// Result of an analysis not yet taken over by the main loop. Guarded by m_inputMutex.
+	std::optional<AnalysisResult> m_analysisResult;
+
+	/// Time of the first source change not yet reflected in the published diagnostics.
+	std::optional<std::chrono::steady_clock::time_point> m_diagnosticsOutdatedSince;
+	/// Time of the first and the last source change not yet handed over to the analysis worker.
+	std::optional<std::chrono::steady_clock::time_point> m_unanalyzedChangesSince;
+	std::chrono::steady_clock::time_point m_lastSourceChange;
+
+	/// Latency samples in milliseconds by operation, collected since the last report.
+	std::map<std::string, std::vector<double>> m_latencySamples;
+
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
 	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
 	std::set<std::string> m_nonemptyDiagnostics;
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
+	/// Files on disk the client reported as changed since the last job was submitted.
+	std::set<boost::filesystem::path> m_changedFiles;
+	/// If true, the next job is analyzed even if none of the sources changed.
+	bool m_forceAnalysis = true;
+
+	/// Last completed analysis of each source unit.
+	std::map<std::string, std::shared_ptr<Analysis>> m_analyses;
+	/// Requests that wait for the analysis running in the background, together with the
+	/// messages received after a waiting request that returns edits.
+	std::vector<ReceivedMessage> m_requestsWaitingForAnalysis;
+	/// Number of the last job whose result was taken over.
+	size_t m_completedGeneration = 0;
+
+	std::mutex m_analysisMutex;
+	std::condition_variable m_analysisRequested;
+	/// Job not yet taken by the analysis worker. Guarded by m_analysisMutex.
+	std::optional<AnalysisJob> m_analysisJob;
+	/// Number of the last submitted job. Only written by the main loop, guarded by m_analysisMutex.
+	size_t m_analysisGeneration = 0;
+	/// Set once the analysis worker has to stop. Guarded by m_analysisMutex.
+	bool m_analysisStopped = false;
+
+	// The following fields are only accessed by the analysis worker.
+
+	/// Sources (including the ones loaded through imports) as of their last completed analysis,
+	/// or nullopt if all sources have to be analyzed regardless of any changes.
+	std::optional<StringMap> m_analyzedSources;
+	/// Source units imported by each of the analyzed source units.
+	std::map<std::string, std::set<std::string>> m_imports;
 
-	frontend::CompilerStack m_compilerStack;
+	struct DiskFile
+	{
+		std::time_t lastWriteTime;
+		std::uintmax_t size;
+		/// Time at which the file was read. Since the modification time only has a resolution of
+		/// seconds, the content is not trusted if the file was modified in the same second.
+		std::time_t readTime;
+		/// Number of the last call to analyze() that used the file.
+		size_t lastUsed;
+		std::string content;
+	};
+	/// Contents of files read from disk, by their path.
+	/// Files that were not used by the last call to analyze() are removed.
+	std::map<boost::filesystem::path, DiskFile> m_diskFiles;
+	/// Number of calls to analyze().
+	size_t m_compilationCount = 0;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
@@ -22,6 +22,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -33,6 +35,38 @@ using namespace solidity::lsp;
 namespace
 {
 
+/// @returns the declaration whose name is at the given location in the given source unit,
+/// or nullptr if the source unit is not part of the analysis.
+Declaration const* findDeclaration(
+	CompilerStack const& _compilerStack,
+	std::string const& _sourceUnitName,
+	SourceLocation const& _nameLocation
+)
+{
+	struct DeclarationFinder: public ASTConstVisitor
+	{
+		explicit DeclarationFinder(SourceLocation const& _location): location(_location) {}
+		bool visitNode(ASTNode const& _node) override
+		{
+			if (auto const* declaration = dynamic_cast<Declaration const*>(&_node))
+				if (declaration->nameLocation().start == location.start && declaration->nameLocation().end == location.end)
+					found = declaration;
+			return !found;
+		}
+
+		SourceLocation const& location;
+		Declaration const* found = nullptr;
+	};
+
+	std::vector<std::string> const sourceNames = _compilerStack.sourceNames();
+	if (std::find(sourceNames.begin(), sourceNames.end(), _sourceUnitName) == sourceNames.end())
+		return nullptr;
+
+	DeclarationFinder finder(_nameLocation);
+	_compilerStack.ast(_sourceUnitName).accept(finder);
+	return finder.found;
+}
+
 CallableDeclaration const* extractCallableDeclaration(FunctionCall const& _functionCall)
 {
 	if (
@@ -54,10 +88,14 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	std::string const uri = _args["textDocument"]["uri"].get<std::string>();
 
 	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
+	if (!sourceNode)
+	{
+		client().reply(_id, Json());
+		return;
+	}
 
 	m_symbolName = {};
 	m_declarationToRename = nullptr;
-	m_sourceUnits = { &m_server.compilerStack().ast(sourceUnitName) };
 	m_locations.clear();
 
 	std::optional<int> cursorBytePosition = charStreamProvider()
@@ -66,26 +104,56 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	solAssert(cursorBytePosition.has_value(), "Expected source pos");
 
 	extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
-
-	// Find all source units using this symbol
-	for (auto const& [name, content]: fileRepository().sourceUnits())
+	if (!m_declarationToRename)
 	{
-		auto const& sourceUnit = m_server.compilerStack().ast(name);
-		for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true, util::convertContainer<std::set<SourceUnit const*>>(m_sourceUnits)))
-			if (*referencedSourceUnit->location().sourceName == sourceUnitName)
-			{
-				m_sourceUnits.insert(&sourceUnit);
-				break;
-			}
+		client().reply(_id, Json());
+		return;
 	}
 
-	// Origin source unit should always be checked
-	m_sourceUnits.insert(&m_declarationToRename->sourceUnit());
+	// Source units that were analyzed separately have their own AST nodes,
+	// so the declaration is identified in the other analyses by its location.
+	LanguageServer::Analysis const* requestAnalysis = &m_server.analysis(sourceUnitName);
+	Declaration const* requestDeclaration = m_declarationToRename;
+	std::string const declaringSourceUnitName = *requestDeclaration->location().sourceName;
+
+	std::map<LanguageServer::Analysis const*, std::vector<std::string>> sourceUnitNamesByAnalysis;
+	for (auto const& [name, analysis]: m_server.analyses())
+		sourceUnitNamesByAnalysis[analysis.get()].push_back(name);
 
 	Visitor visitor(*this);
+	for (auto const& [analysis, sourceUnitNames]: sourceUnitNamesByAnalysis)
+	{
+		CompilerStack const& compilerStack = *analysis->compilerStack;
+		if (compilerStack.state() < CompilerStack::AnalysisSuccessful)
+			continue;
+
+		m_declarationToRename =
+			analysis == requestAnalysis ?
+			requestDeclaration :
+			findDeclaration(compilerStack, declaringSourceUnitName, requestDeclaration->nameLocation());
+		if (!m_declarationToRename)
+			continue;
+
+		// Find all source units using this symbol
+		m_sourceUnits.clear();
+		for (std::string const& name: sourceUnitNames)
+		{
+			auto const& sourceUnit = compilerStack.ast(name);
+			// Origin source unit should always be checked
+			if (name == sourceUnitName || name == declaringSourceUnitName)
+				m_sourceUnits.insert(&sourceUnit);
+			else
+				for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true))
+					if (*referencedSourceUnit->location().sourceName == sourceUnitName)
+					{
+						m_sourceUnits.insert(&sourceUnit);
+						break;
+					}
+		}
 
-	for (auto const* sourceUnit: m_sourceUnits)
-		sourceUnit->accept(visitor);
+		for (auto const* sourceUnit: m_sourceUnits)
+			sourceUnit->accept(visitor);
+	}
 
 	// Apply changes in reverse order (will iterate in reverse)
 	sort(m_locations.begin(), m_locations.end());
@@ -99,11 +167,8 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	{
 		solAssert(i->isValid());
 
-		// Replace in our file repository
+		// The client applies the changes and reports them like any other edit.
 		std::string const uri = fileRepository().sourceUnitNameToUri(*i->sourceName);
-		std::string buffer = fileRepository().sourceUnits().at(*i->sourceName);
-		buffer.replace((size_t)i->start, (size_t)(i->end - i->start), newName);
-		fileRepository().setSourceByUri(uri, std::move(buffer));
 
 		Json edit;
 		edit["range"] = toRange(*i);
@@ -111,7 +176,7 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 
 		// Record changes for the client
 		edits.emplace_back(edit);
-		if (i + 1 == m_locations.rend() || (i + 1)->sourceName != i->sourceName)
+		if (i + 1 == m_locations.rend() || *(i + 1)->sourceName != *i->sourceName)
 		{
 			reply["changes"][uri] = edits;
 			edits = Json::array(); // Reset.
@@ -156,7 +221,8 @@ void RenameSymbol::extractNameAndDeclaration(ASTNode const& _node, int _cursorBy
 	else
 		solAssert(false, "Unexpected ASTNODE id: " + std::to_string(_node.id()));
 
-	lspDebug(fmt::format("Goal: rename '{}', loc: {}-{}", m_symbolName, m_declarationToRename->nameLocation().start, m_declarationToRename->nameLocation().end));
+	if (m_declarationToRename)
+		lspDebug(fmt::format("Goal: rename '{}', loc: {}-{}", m_symbolName, m_declarationToRename->nameLocation().start, m_declarationToRename->nameLocation().end));
 }
 
 void RenameSymbol::extractNameAndDeclaration(ImportDirective const& _importDirective, int _cursorBytePosition)
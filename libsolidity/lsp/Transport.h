@@ -23,6 +23,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -112,6 +113,9 @@ public:
 private:
 	TraceValue m_logTrace = TraceValue::Off;
 
+	/// Serializes messages sent from different threads.
+	std::mutex m_sendMutex;
+
 protected:
 	/// Reads from the transport and parses the headers until the beginning
 	/// of the contents.
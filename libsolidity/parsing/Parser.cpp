@@ -76,7 +76,7 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.recordNode(std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...));
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -183,6 +183,14 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+void Parser::shiftIDs(int64_t _offset)
+{
+	solAssert(m_recordNodes || m_currentNodeID == 0);
+	for (ASTPointer<ASTNode> const& node: m_recordedNodes)
+		node->m_id = static_cast<size_t>(node->id() + _offset);
+	m_currentNodeID += _offset;
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, std::vector<Token> const& _tokens, std::vector<std::string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -1478,7 +1486,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block);
+	return recordNode(std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -38,18 +38,26 @@ namespace solidity::frontend
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @a _recordNodes keeps the created nodes alive until the parser is destroyed,
+	/// which is required to shift their IDs later.
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		bool _recordNodes = false
 	):
 		ParserBase(_errorReporter),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_recordNodes(_recordNodes)
 	{}
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+	/// Adds @a _offset to the IDs of all nodes created so far and to the IDs assigned from now on.
+	/// Sources parsed by separate parsers can thus get the IDs a single parser would have assigned.
+	/// Requires the nodes to be recorded, unless no nodes were created yet.
+	void shiftIDs(int64_t _offset);
 private:
 	class ASTNodeFactory;
 
@@ -213,6 +221,14 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Keeps @a _node for shiftIDs(), if requested.
+	template <class NodeType>
+	ASTPointer<NodeType> recordNode(ASTPointer<NodeType> _node)
+	{
+		if (m_recordNodes)
+			m_recordedNodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -249,6 +265,9 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_recordNodes = false;
+	/// All nodes created so far, including the ones not part of the AST, if m_recordNodes is set.
+	std::vector<ASTPointer<ASTNode>> m_recordedNodes;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+namespace solidity::util
+{
+
+/**
+ * A value whose copies share their storage until one of them is modified.
+ * Copying a CopyOnWrite is cheap, the stored value is only copied when calling "write"
+ * while the storage is shared with another copy.
+ *
+ * @tparam T the type of the stored value; has to be default-constructible and copyable.
+ */
+template<typename T>
+class CopyOnWrite
+{
+public:
+	using value_type = T;
+
+	static_assert(std::is_object_v<value_type> && !std::is_const_v<value_type>, "Only non-const object types are supported.");
+
+	CopyOnWrite() = default;
+	CopyOnWrite(value_type _value): m_value(std::make_shared<value_type>(std::move(_value))) {}
+
+	value_type const& operator*() const { return m_value ? *m_value : empty(); }
+	value_type const* operator->() const { return &**this; }
+
+	/// @returns a reference to the stored value that can be modified, copying the value first
+	/// if it is shared with another copy.
+	value_type& write()
+	{
+		if (!m_value)
+			m_value = std::make_shared<value_type>();
+		else if (m_value.use_count() > 1)
+			m_value = std::make_shared<value_type>(*m_value);
+		return *m_value;
+	}
+
+	/// @returns true if the value is stored together with other copies, i.e. if calling "write"
+	/// would copy it.
+	bool isShared() const { return m_value.use_count() > 1; }
+
+	/// @returns true if the value is stored in the same place as the value of @a _other,
+	/// which implies that neither has been modified since one was copied from the other.
+	bool sharesValueWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+
+private:
+	static value_type const& empty()
+	{
+		static value_type const emptyValue{};
+		return emptyValue;
+	}
+
+	/// Null for a default-constructed value, to avoid allocations for values that are never written.
+	std::shared_ptr<value_type> m_value;
+};
+
+}
@@ -23,9 +23,11 @@
 #include <libsolutil/JSON.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <optional>
 #include <sstream>
 
 #ifdef STRICT_NLOHMANN_JSON_VERSION_CHECK
@@ -65,47 +67,30 @@ void removeNullMembersHelper(Json& _json)
 
 std::string escapeNewlinesAndTabsWithinStringLiterals(std::string const& _json)
 {
-	std::stringstream fixed;
+	std::string fixed;
+	fixed.reserve(_json.size());
 	bool inQuotes = false;
-	for (size_t i = 0; i < _json.size(); ++i)
+	// Number of backslashes directly preceding the current character.
+	size_t backslashCount = 0;
+	for (char c: _json)
 	{
-		char c = _json[i];
-
 		// Originally we had just this here:
 		// if (c == '"' && (i == 0 || _json[i - 1] != '\\'))
 		//    inQuotes = !inQuotes;
 		// However, this is not working if the escape character itself was escaped. e.g. "\n\r'\"\\".
+		if (c == '"' && backslashCount % 2 == 0)
+			inQuotes = !inQuotes;
 
-		if (c == '"')
-		{
-			size_t backslashCount = 0;
-			size_t j = i;
-			while (j > 0 && _json[j - 1] == '\\')
-			{
-				backslashCount++;
-				j--;
-			}
-			if (backslashCount % 2 == 0)
-			{
-				inQuotes = !inQuotes;
-				fixed << c;
-				continue;
-			}
-		}
-
-		if (inQuotes)
-		{
-			if (c == '\n')
-				fixed << "\\n";
-			else if (c == '\t')
-				fixed << "\\t";
-			else
-				fixed << c;
-		}
+		if (inQuotes && c == '\n')
+			fixed += "\\n";
+		else if (inQuotes && c == '\t')
+			fixed += "\\t";
 		else
-			fixed << c;
+			fixed += c;
+
+		backslashCount = (c == '\\') ? backslashCount + 1 : 0;
 	}
-	return fixed.str();
+	return fixed;
 }
 
 } // end anonymous namespace
@@ -144,13 +129,151 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+JsonWriter::JsonWriter(std::ostream& _stream, JsonFormat const& _format):
+	m_output(nlohmann::detail::output_adapter<char>(_stream)),
+	m_serializer(m_output, ' '),
+	m_format(_format)
+{
+}
+
+JsonWriter::JsonWriter(std::string& _output, JsonFormat const& _format):
+	m_output(nlohmann::detail::output_adapter<char>(_output)),
+	m_serializer(m_output, ' '),
+	m_format(_format)
+{
+}
+
+void JsonWriter::value(Json const& _value)
+{
+	beginValue();
+	bool const pretty = m_format.format == JsonFormat::Pretty;
+	m_serializer.dump(
+		_value,
+		pretty,
+		/* ensure_ascii */ true,
+		pretty ? m_format.indent : 0,
+		pretty ? static_cast<unsigned>(m_levels.size()) * m_format.indent : 0
+	);
+}
+
+void JsonWriter::object(Json const& _object, std::map<std::string, MemberWriter> const& _memberWriters)
+{
+	assertThrow(_object.is_object(), Exception, "");
+	beginObject();
+	auto memberWriter = _memberWriters.begin();
+	auto writeMembersBefore = [&](std::string const* _key) {
+		for (; memberWriter != _memberWriters.end() && (!_key || memberWriter->first <= *_key); ++memberWriter)
+		{
+			key(memberWriter->first);
+			memberWriter->second(*this);
+		}
+	};
+	for (auto it = _object.begin(); it != _object.end(); ++it)
+	{
+		bool replaced = _memberWriters.count(it.key());
+		writeMembersBefore(&it.key());
+		if (!replaced)
+		{
+			key(it.key());
+			value(it.value());
+		}
+	}
+	writeMembersBefore(nullptr);
+	endObject();
+}
+
+void JsonWriter::beginObject()
+{
+	beginValue();
+	m_output->write_character('{');
+	m_levels.push_back({true, true, {}});
+}
+
+void JsonWriter::key(std::string const& _key)
+{
+	assertThrow(!m_levels.empty() && m_levels.back().isObject && !m_keyWritten, Exception, "");
+	Level& level = m_levels.back();
+	assertThrow(level.empty || level.lastKey < _key, Exception, "Object members have to be written in the order of their keys.");
+	if (!level.empty)
+		m_output->write_character(',');
+	newLine(m_levels.size());
+	level.empty = false;
+	level.lastKey = _key;
+
+	m_serializer.dump(Json(_key), false, /* ensure_ascii */ true, 0);
+	if (m_format.format == JsonFormat::Pretty)
+		m_output->write_characters(": ", 2);
+	else
+		m_output->write_character(':');
+	m_keyWritten = true;
+}
+
+void JsonWriter::endObject()
+{
+	assertThrow(!m_levels.empty() && m_levels.back().isObject && !m_keyWritten, Exception, "");
+	bool empty = m_levels.back().empty;
+	m_levels.pop_back();
+	if (!empty)
+		newLine(m_levels.size());
+	m_output->write_character('}');
+}
+
+void JsonWriter::beginArray()
+{
+	beginValue();
+	m_output->write_character('[');
+	m_levels.push_back({false, true, {}});
+}
+
+void JsonWriter::endArray()
+{
+	assertThrow(!m_levels.empty() && !m_levels.back().isObject, Exception, "");
+	bool empty = m_levels.back().empty;
+	m_levels.pop_back();
+	if (!empty)
+		newLine(m_levels.size());
+	m_output->write_character(']');
+}
+
+void JsonWriter::beginValue()
+{
+	if (m_levels.empty())
+		return;
+	Level& level = m_levels.back();
+	if (level.isObject)
+	{
+		assertThrow(m_keyWritten, Exception, "Object members need a key.");
+		m_keyWritten = false;
+	}
+	else
+	{
+		if (!level.empty)
+			m_output->write_character(',');
+		newLine(m_levels.size());
+		level.empty = false;
+	}
+}
+
+void JsonWriter::newLine(size_t _depth)
+{
+	if (m_format.format != JsonFormat::Pretty)
+		return;
+	m_output->write_character('\n');
+	for (size_t i = 0; i < _depth * m_format.indent; ++i)
+		m_output->write_character(' ');
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
 {
 	try
 	{
+		// TODO: remove this in the next breaking release?
+		std::optional<std::string> escapedInput;
+		// Avoids copying inputs without any newlines or tabs, e.g. compact ASTs.
+		if (_input.find_first_of("\n\t") != std::string::npos)
+			escapedInput = escapeNewlinesAndTabsWithinStringLiterals(_input);
 		_json = Json::parse(
-			// TODO: remove this in the next breaking release?
-			escapeNewlinesAndTabsWithinStringLiterals(_input),
+			escapedInput ? *escapedInput : _input,
 			/* callback */ nullptr,
 			/* allow exceptions */ true,
 			/* ignore_comments */true
@@ -26,10 +26,14 @@
 #include <libsolutil/Assertions.h>
 #include <nlohmann/json.hpp>
 
+#include <functional>
+#include <map>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +75,51 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/**
+ * Writes a JSON document piece by piece, so that large documents do not have to be built in memory
+ * as a whole. The output is identical to that of jsonPrint() for the complete document, which
+ * requires the members of every object to be written in the order of their keys.
+ */
+class JsonWriter
+{
+public:
+	using MemberWriter = std::function<void(JsonWriter&)>;
+
+	JsonWriter(std::ostream& _stream, JsonFormat const& _format);
+	JsonWriter(std::string& _output, JsonFormat const& _format);
+
+	/// Writes @a _value as the next array element, as the value of the last key or as the document.
+	void value(Json const& _value);
+	/// Writes the object @a _object, but lets the functions in @a _memberWriters write the values
+	/// of the members with their keys instead. These members are added if @a _object lacks them.
+	void object(Json const& _object, std::map<std::string, MemberWriter> const& _memberWriters);
+
+	void beginObject();
+	/// Writes the key of the next member of the current object.
+	void key(std::string const& _key);
+	void endObject();
+	void beginArray();
+	void endArray();
+
+private:
+	struct Level
+	{
+		bool isObject = false;
+		bool empty = true;
+		std::string lastKey;
+	};
+
+	/// Writes the separator and indentation in front of the next value.
+	void beginValue();
+	void newLine(size_t _depth);
+
+	nlohmann::detail::output_adapter_t<char> m_output;
+	nlohmann::detail::serializer<Json> m_serializer;
+	JsonFormat m_format;
+	std::vector<Level> m_levels;
+	bool m_keyWritten = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
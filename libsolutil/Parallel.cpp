@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
+using namespace solidity;
+using namespace solidity::util;
+
+std::vector<std::exception_ptr> solidity::util::parallelFor(
+	size_t _count,
+	size_t _threads,
+	std::function<void(size_t)> const& _task
+)
+{
+	std::vector<std::exception_ptr> exceptions(_count);
+	std::atomic<size_t> nextIndex{0};
+	std::atomic<bool> failed{false};
+
+	auto const work = [&]() {
+		while (!failed)
+		{
+			size_t index = nextIndex++;
+			if (index >= _count)
+				break;
+			try
+			{
+				_task(index);
+			}
+			catch (...)
+			{
+				exceptions[index] = std::current_exception();
+				failed = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> helpers;
+	size_t const helperCount = std::min(std::max<size_t>(_threads, 1), std::max<size_t>(_count, 1)) - 1;
+	for (size_t i = 0; i < helperCount; ++i)
+		try
+		{
+			helpers.emplace_back(work);
+		}
+		catch (std::system_error const&)
+		{
+			// Not being able to spawn more threads is not an error, the remaining ones pick up the work.
+			break;
+		}
+
+	work();
+	for (std::thread& helper: helpers)
+		helper.join();
+
+	return exceptions;
+}
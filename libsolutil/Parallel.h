@@ -0,0 +1,46 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent tasks on multiple threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Calls @a _task for every index in [0, @a _count) using up to @a _threads threads,
+/// one of which is the calling thread. Tasks are started in increasing index order but may
+/// finish in any order, so each task must only modify state belonging to its own index.
+/// Once a task has failed, no further tasks are started. All tasks with a lower index than
+/// the failed one have been started at that point and still run to completion, so the
+/// first failure by index does not depend on the number of threads.
+/// @returns for every index the exception thrown by its task, or a null pointer if the task
+/// succeeded or was not started.
+std::vector<std::exception_ptr> parallelFor(
+	size_t _count,
+	size_t _threads,
+	std::function<void(size_t)> const& _task
+);
+
+}
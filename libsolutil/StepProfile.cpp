@@ -0,0 +1,35 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/StepProfile.h>
+
+using namespace solidity;
+using namespace solidity::util;
+
+Json solidity::util::stepProfileToJson(StepProfile const& _profile)
+{
+	Json result = Json::object();
+	for (auto const& [name, statistics]: _profile)
+	{
+		Json& step = result[name];
+		step["invocations"] = statistics.invocations;
+		step["durationMicroseconds"] = std::chrono::duration_cast<std::chrono::microseconds>(statistics.duration).count();
+		step["sizeDelta"] = statistics.sizeDelta;
+	}
+	return result;
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of execution statistics of repeatedly run steps, e.g. optimiser steps.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <type_traits>
+
+namespace solidity::util
+{
+
+struct StepStatistics
+{
+	size_t invocations = 0;
+	std::chrono::steady_clock::duration duration{};
+	/// Sum of the changes of the code size caused by the step.
+	std::int64_t sizeDelta = 0;
+};
+
+/// Statistics by step name.
+using StepProfile = std::map<std::string, StepStatistics>;
+
+/// Runs @a _step and, unless @a _profile is null, records its duration and the change
+/// of the code size as reported by @a _codeSize under the name @a _name.
+/// @returns the return value of @a _step.
+template <typename CodeSize, typename Step>
+std::invoke_result_t<Step> profileStep(StepProfile* _profile, std::string const& _name, CodeSize const& _codeSize, Step&& _step)
+{
+	if (!_profile)
+		return _step();
+
+	auto const sizeBefore = static_cast<std::int64_t>(_codeSize());
+	auto const start = std::chrono::steady_clock::now();
+	auto const record = [&]() {
+		StepStatistics& statistics = (*_profile)[_name];
+		++statistics.invocations;
+		statistics.duration += std::chrono::steady_clock::now() - start;
+		statistics.sizeDelta += static_cast<std::int64_t>(_codeSize()) - sizeBefore;
+	};
+
+	if constexpr (std::is_void_v<std::invoke_result_t<Step>>)
+	{
+		_step();
+		record();
+	}
+	else
+	{
+		auto result = _step();
+		record();
+		return result;
+	}
+}
+
+/// @returns a JSON object containing the invocation count, the total duration in microseconds
+/// and the total code size change of every step.
+Json stepProfileToJson(StepProfile const& _profile);
+
+}
@@ -26,12 +26,246 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' ||
+		_c == '$' ||
+		_c == '-';
+}
+
+/// @returns the length of the (possibly empty) parameter name starting at @a _pos.
+size_t parameterLength(std::string_view _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	return end - _pos;
+}
+
+}
+
+struct Whiskers::Template
+{
+	struct Node
+	{
+		enum class Kind { Text, Parameter, List, Condition, ValueCondition };
+		Kind kind;
+		/// Literal text or the name of the parameter, list or condition (without "+").
+		std::string text;
+		/// Body of a list or the part of a condition that is used if it is true.
+		std::vector<Node> body = {};
+		/// Part of a condition that is used if it is false.
+		std::vector<Node> elseBody = {};
+	};
+
+	explicit Template(std::string_view _text):
+		nodes(parse(_text)),
+		invalidTag(findInvalidTag(_text))
+	{}
+
+	/// Splits @a _text into literal text and tags. The bodies of lists and conditions extend to the
+	/// first matching closing tag. Tags without a matching closing tag are treated as literal text.
+	static std::vector<Node> parse(std::string_view _text);
+	/// @returns the first tag starting with "<#", "<?", "<!" or "</" that is not closed by ">" right after its name.
+	static std::optional<std::string> findInvalidTag(std::string_view _text);
+
+	static void render(
+		std::vector<Node> const& _nodes,
+		Whiskers const& _whiskers,
+		StringMap const* _listElement,
+		std::string& _output
+	);
+
+	std::vector<Node> nodes;
+	std::optional<std::string> invalidTag;
+};
+
+std::vector<Whiskers::Template::Node> Whiskers::Template::parse(std::string_view _text)
+{
+	std::vector<Node> nodes;
+	size_t textStart = 0;
+	auto appendText = [&](size_t _end) {
+		if (_end > textStart)
+			nodes.push_back({Node::Kind::Text, std::string(_text.substr(textStart, _end - textStart))});
+	};
+
+	size_t pos = _text.find('<');
+	while (pos != std::string_view::npos)
+	{
+		char prefix = pos + 1 < _text.size() ? _text[pos + 1] : '\0';
+		if (isParameterCharacter(prefix))
+		{
+			size_t nameEnd = pos + 1 + parameterLength(_text, pos + 1);
+			if (nameEnd < _text.size() && _text[nameEnd] == '>')
+			{
+				appendText(pos);
+				nodes.push_back({Node::Kind::Parameter, std::string(_text.substr(pos + 1, nameEnd - pos - 1))});
+				textStart = nameEnd + 1;
+				pos = _text.find('<', textStart);
+				continue;
+			}
+		}
+		else if (prefix == '#' || prefix == '?')
+		{
+			size_t tagNameStart = pos + 2;
+			bool valueCondition = prefix == '?' && tagNameStart < _text.size() && _text[tagNameStart] == '+';
+			size_t nameStart = tagNameStart + (valueCondition ? 1 : 0);
+			size_t nameEnd = nameStart + parameterLength(_text, nameStart);
+			if (nameEnd > nameStart && nameEnd < _text.size() && _text[nameEnd] == '>')
+			{
+				std::string tagName(_text.substr(tagNameStart, nameEnd - tagNameStart));
+				std::string closingTag = "</" + tagName + ">";
+				size_t bodyStart = nameEnd + 1;
+				size_t bodyEnd = _text.find(closingTag, bodyStart);
+				if (bodyEnd != std::string_view::npos)
+				{
+					appendText(pos);
+					Node node{Node::Kind::List, std::string(_text.substr(nameStart, nameEnd - nameStart))};
+					if (prefix == '#')
+						node.body = parse(_text.substr(bodyStart, bodyEnd - bodyStart));
+					else
+					{
+						node.kind = valueCondition ? Node::Kind::ValueCondition : Node::Kind::Condition;
+						std::string elseTag = "<!" + tagName + ">";
+						size_t elseStart = _text.substr(0, bodyEnd).find(elseTag, bodyStart);
+						if (elseStart != std::string_view::npos)
+						{
+							node.body = parse(_text.substr(bodyStart, elseStart - bodyStart));
+							size_t elseBodyStart = elseStart + elseTag.size();
+							node.elseBody = parse(_text.substr(elseBodyStart, bodyEnd - elseBodyStart));
+						}
+						else
+							node.body = parse(_text.substr(bodyStart, bodyEnd - bodyStart));
+					}
+					nodes.push_back(std::move(node));
+					textStart = bodyEnd + closingTag.size();
+					pos = _text.find('<', textStart);
+					continue;
+				}
+			}
+		}
+		pos = _text.find('<', pos + 1);
+	}
+	appendText(_text.size());
+	return nodes;
+}
+
+std::optional<std::string> Whiskers::Template::findInvalidTag(std::string_view _text)
+{
+	for (size_t pos = _text.find('<'); pos != std::string_view::npos; pos = _text.find('<', pos + 1))
+	{
+		if (pos + 1 >= _text.size() || std::string_view("#?!/").find(_text[pos + 1]) == std::string_view::npos)
+			continue;
+		size_t nameStart = pos + 2;
+		if (nameStart < _text.size() && _text[nameStart] == '+')
+			++nameStart;
+		size_t nameEnd = nameStart + parameterLength(_text, nameStart);
+		if (nameEnd == nameStart)
+			continue;
+		if (nameEnd == _text.size())
+			return std::string(_text.substr(pos));
+		if (_text[nameEnd] != '>')
+			return std::string(_text.substr(pos, nameEnd + 1 - pos));
+	}
+	return std::nullopt;
+}
+
+void Whiskers::Template::render(
+	std::vector<Node> const& _nodes,
+	Whiskers const& _whiskers,
+	StringMap const* _listElement,
+	std::string& _output
+)
+{
+	auto findParameter = [&](std::string const& _name) -> std::string const* {
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = _whiskers.m_parameters.find(_name); it != _whiskers.m_parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Node const& node: _nodes)
+		switch (node.kind)
+		{
+		case Node::Kind::Text:
+			_output += node.text;
+			break;
+		case Node::Kind::Parameter:
+		{
+			std::string const* value = findParameter(node.text);
+			assertThrow(
+				value,
+				WhiskersError,
+				"Value for tag " + node.text + " not provided.\n" +
+				"Template:\n" +
+				_whiskers.m_template
+			);
+			_output += *value;
+			break;
+		}
+		case Node::Kind::List:
+		{
+			// Lists cannot be nested.
+			auto list = _whiskers.m_listParameters.find(node.text);
+			assertThrow(
+				!_listElement && list != _whiskers.m_listParameters.end(),
+				WhiskersError, "List parameter " + node.text + " not set."
+			);
+			for (StringMap const& element: list->second)
+			{
+				for (auto const& parameter: element)
+					assertThrow(!_whiskers.m_parameters.count(parameter.first), WhiskersError, "Parameter collision");
+				render(node.body, _whiskers, &element, _output);
+			}
+			break;
+		}
+		case Node::Kind::Condition:
+		case Node::Kind::ValueCondition:
+		{
+			bool conditionValue = false;
+			if (node.kind == Node::Kind::ValueCondition)
+			{
+				if (std::string const* value = findParameter(node.text))
+					conditionValue = !value->empty();
+				else if (auto list = _whiskers.m_listParameters.find(node.text); !_listElement && list != _whiskers.m_listParameters.end())
+					conditionValue = !list->second.empty();
+				else
+					assertThrow(false, WhiskersError, "Tag " + node.text + " used as condition but was not set.");
+			}
+			else
+			{
+				auto condition = _whiskers.m_conditions.find(node.text);
+				assertThrow(
+					condition != _whiskers.m_conditions.end(),
+					WhiskersError, "Condition parameter " + node.text + " not set."
+				);
+				conditionValue = condition->second;
+			}
+			render(conditionValue ? node.body : node.elseBody, _whiskers, _listElement, _output);
+			break;
+		}
+		}
+}
+
 Whiskers::Whiskers(std::string _template):
-	m_template(std::move(_template))
+	m_template(std::move(_template)),
+	m_parsedTemplate(parseTemplate(m_template))
 {
 	checkTemplateValid();
 }
@@ -71,25 +305,25 @@ Whiskers& Whiskers::operator()(
 
 std::string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	std::string result;
+	result.reserve(m_template.size());
+	Template::render(m_parsedTemplate->nodes, *this, nullptr, result);
+	return result;
 }
 
 void Whiskers::checkTemplateValid() const
 {
-	std::regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	std::smatch match;
 	assertThrow(
-		!regex_search(m_template, match, validTemplate),
+		!m_parsedTemplate->invalidTag.has_value(),
 		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
+		"Template contains an invalid/unclosed tag " + *m_parsedTemplate->invalidTag
 	);
 }
 
 void Whiskers::checkParameterValid(std::string const& _parameter) const
 {
-	static std::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && parameterLength(_parameter, 0) == _parameter.size(),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -127,117 +361,20 @@ void Whiskers::checkTemplateContainsTags(std::string const& _parameter, std::vec
 	}
 }
 
-namespace
+std::shared_ptr<Whiskers::Template const> Whiskers::parseTemplate(std::string const& _template)
 {
-template<class ReplaceCallback>
-std::string regex_replace(
-	std::string const& _source,
-	std::regex const& _pattern,
-	ReplaceCallback _replace,
-	std::regex_constants::match_flag_type _flags = std::regex_constants::match_default
-)
-{
-	std::sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	std::sregex_iterator matchEnd;
-	std::string::const_iterator lastMatchedPos(_source.cbegin());
-	std::string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
+	// Almost all templates are string literals, so the number of distinct templates is small.
+	// The limit only prevents unbounded growth in case of dynamically constructed templates.
+	static size_t constexpr maxCachedTemplates = 4096;
+	static std::mutex mutex;
+	static std::unordered_map<std::string, std::shared_ptr<Template const>> cache;
 
-std::string Whiskers::replace(
-	std::string const& _template,
-	StringMap const& _parameters,
-	std::map<std::string, bool> const& _conditions,
-	std::map<std::string, std::vector<StringMap>> const& _listParameters
-)
-{
-	static std::regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](std::match_results<std::string::const_iterator> _match) -> std::string
-	{
-		std::string tagName(_match[1]);
-		std::string listName(_match[2]);
-		std::string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			std::string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			std::string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				std::string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
-				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+	std::lock_guard lock(mutex);
+	if (auto it = cache.find(_template); it != cache.end())
+		return it->second;
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	auto parsedTemplate = std::make_shared<Template const>(_template);
+	cache.emplace(_template, parsedTemplate);
+	return parsedTemplate;
 }
-
@@ -26,8 +26,9 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +68,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Templates are parsed only once per distinct template string and the parsed form
+ * is shared between all instances using the same template.
  */
 class Whiskers
 {
@@ -90,6 +94,9 @@ public:
 	std::string render() const;
 
 private:
+	/// Template parsed into literal text and tags.
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkTemplateValid() const;
@@ -102,19 +109,11 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed form of @a _template, which is cached across instances.
+	static std::shared_ptr<Template const> parseTemplate(std::string const& _template);
 
 	std::string m_template;
+	std::shared_ptr<Template const> m_parsedTemplate;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
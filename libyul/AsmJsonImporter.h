@@ -47,9 +47,9 @@ private:
 	langutil::SourceLocation const createSourceLocation(Json const& _node);
 	template <class T>
 	T createAsmNode(Json const& _node);
-	/// helper function to access member functions of the JSON
-	/// and throw an error if it does not exist
-	Json member(Json const& _node, std::string const& _name);
+	/// helper function to access members of the JSON,
+	/// returns null if the member does not exist
+	Json const& member(Json const& _node, std::string const& _name);
 
 	yul::Statement createStatement(Json const& _node);
 	yul::Expression createExpression(Json const& _node);
@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
 
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace solidity::langutil;
 
@@ -51,8 +53,15 @@ bool Dialect::validTypeForLiteral(LiteralKind _kind, LiteralValue const&, YulNam
 
 Dialect const& Dialect::yulDeprecated()
 {
-	static std::unique_ptr<Dialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	// The dialect holds YulStrings, so it is stored in the repository of the current compilation.
+	struct Cache
+	{
+		std::mutex mutex;
+		std::unique_ptr<Dialect> dialect;
+	};
+	Cache& cache = YulStringRepository::instance().cache<Cache>();
+	std::lock_guard lock(cache.mutex);
+	std::unique_ptr<Dialect>& dialect = cache.dialect;
 
 	if (!dialect)
 	{
@@ -0,0 +1,245 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/OptimizedObjectCache.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Serializes a block in a way that cannot be ambiguous, so that the hash of the serialization
+ * can be used as a key: Every node starts with a tag, strings are prefixed by their length
+ * and lists by the number of their elements.
+ */
+class CodeSerializer: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+
+	std::string const& serialization() const { return m_data; }
+
+	void operator()(Literal const& _literal) override
+	{
+		tag('L', _literal.debugData);
+		appendNumber(static_cast<size_t>(_literal.kind));
+		appendNumber(_literal.value.unlimited() ? 1 : 0);
+		if (_literal.value.unlimited())
+			append(_literal.value.builtinStringLiteralValue());
+		else
+			append(_literal.value.value().str());
+		// The hint is used to print the literal in its original form.
+		appendOptional(_literal.value.hint().get());
+		append(_literal.type.str());
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		tag('I', _identifier.debugData);
+		append(_identifier.name.str());
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		tag('F', _funCall.debugData);
+		(*this)(_funCall.functionName);
+		appendNumber(_funCall.arguments.size());
+		for (auto const& argument: _funCall.arguments)
+			visit(argument);
+	}
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		tag('E', _statement.debugData);
+		visit(_statement.expression);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		tag('A', _assignment.debugData);
+		appendNumber(_assignment.variableNames.size());
+		for (auto const& name: _assignment.variableNames)
+			(*this)(name);
+		visit(*_assignment.value);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		tag('V', _varDecl.debugData);
+		appendTypedNames(_varDecl.variables);
+		appendNumber(_varDecl.value ? 1 : 0);
+		if (_varDecl.value)
+			visit(*_varDecl.value);
+	}
+	void operator()(If const& _if) override
+	{
+		tag('?', _if.debugData);
+		visit(*_if.condition);
+		(*this)(_if.body);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		tag('S', _switch.debugData);
+		visit(*_switch.expression);
+		appendNumber(_switch.cases.size());
+		for (auto const& _case: _switch.cases)
+		{
+			tag('C', _case.debugData);
+			appendNumber(_case.value ? 1 : 0);
+			if (_case.value)
+				(*this)(*_case.value);
+			(*this)(_case.body);
+		}
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		tag('D', _function.debugData);
+		append(_function.name.str());
+		appendTypedNames(_function.parameters);
+		appendTypedNames(_function.returnVariables);
+		(*this)(_function.body);
+	}
+	void operator()(ForLoop const& _forLoop) override
+	{
+		tag('O', _forLoop.debugData);
+		(*this)(_forLoop.pre);
+		visit(*_forLoop.condition);
+		(*this)(_forLoop.post);
+		(*this)(_forLoop.body);
+	}
+	void operator()(Break const& _break) override { tag('b', _break.debugData); }
+	void operator()(Continue const& _continue) override { tag('c', _continue.debugData); }
+	void operator()(Leave const& _leave) override { tag('l', _leave.debugData); }
+	void operator()(Block const& _block) override
+	{
+		tag('B', _block.debugData);
+		appendNumber(_block.statements.size());
+		walkVector(_block.statements);
+	}
+
+private:
+	/// Appends the tag of a node and its debug data. The native location is left out, because it
+	/// only refers to the Yul source the node was parsed from.
+	void tag(char _tag, DebugData::ConstPtr const& _debugData)
+	{
+		m_data += _tag;
+		if (!_debugData)
+		{
+			m_data += '-';
+			return;
+		}
+		m_data += '+';
+		SourceLocation const& location = _debugData->originLocation;
+		appendOptional(location.sourceName.get());
+		appendNumber(static_cast<size_t>(location.start + 1));
+		appendNumber(static_cast<size_t>(location.end + 1));
+		appendNumber(_debugData->astID.has_value() ? 1 : 0);
+		if (_debugData->astID.has_value())
+			append(std::to_string(*_debugData->astID));
+	}
+	void appendTypedNames(TypedNameList const& _names)
+	{
+		appendNumber(_names.size());
+		for (TypedName const& name: _names)
+		{
+			tag('T', name.debugData);
+			append(name.name.str());
+			append(name.type.str());
+		}
+	}
+	void appendOptional(std::string const* _string)
+	{
+		appendNumber(_string ? 1 : 0);
+		if (_string)
+			append(*_string);
+	}
+	void append(std::string const& _string)
+	{
+		appendNumber(_string.size());
+		m_data += _string;
+	}
+	void appendNumber(size_t _number)
+	{
+		m_data += std::to_string(_number);
+		m_data += ':';
+	}
+
+	std::string m_data;
+};
+
+}
+
+std::shared_ptr<Block const> OptimizedObjectCache::find(h256 const& _key) const
+{
+	std::lock_guard lock(m_mutex);
+	auto it = m_optimizedCode.find(_key);
+	if (it == m_optimizedCode.end())
+		return nullptr;
+	return it->second;
+}
+
+void OptimizedObjectCache::store(h256 const& _key, std::shared_ptr<Block const> _optimizedCode)
+{
+	std::lock_guard lock(m_mutex);
+	m_optimizedCode.emplace(_key, std::move(_optimizedCode));
+}
+
+std::shared_ptr<evmasm::Assembly> OptimizedObjectCache::findAssembly(h256 const& _key) const
+{
+	std::lock_guard lock(m_mutex);
+	auto it = m_assemblies.find(_key);
+	if (it == m_assemblies.end())
+		return nullptr;
+	return it->second;
+}
+
+void OptimizedObjectCache::storeAssembly(h256 const& _key, std::shared_ptr<evmasm::Assembly> _assembly)
+{
+	std::lock_guard lock(m_mutex);
+	m_assemblies.emplace(_key, std::move(_assembly));
+}
+
+size_t OptimizedObjectCache::size() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_optimizedCode.size();
+}
+
+size_t OptimizedObjectCache::numAssemblies() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_assemblies.size();
+}
+
+void OptimizedObjectCache::clear()
+{
+	std::lock_guard lock(m_mutex);
+	m_optimizedCode.clear();
+	m_assemblies.clear();
+}
+
+h256 OptimizedObjectCache::codeHash(Block const& _code)
+{
+	CodeSerializer serializer;
+	serializer(_code);
+	return keccak256(serializer.serialization());
+}
@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of optimized and assembled Yul objects that can be shared between multiple YulStacks.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace solidity::evmasm
+{
+class Assembly;
+}
+
+namespace solidity::yul
+{
+
+/**
+ * Thread-safe cache mapping a hash of the unoptimized code of a Yul object (including the hashes
+ * of its sub-objects) and of all the settings affecting the optimiser to its optimized code.
+ *
+ * This allows optimizing an object only once even if it is embedded in multiple contracts,
+ * e.g. a contract that is deployed using `new` from several other contracts.
+ * Entries are ASTs, which are copied when they are used, so that an object taken from the cache
+ * is identical to one that was optimized in place. Since the ASTs refer to YulStrings, the cache
+ * must not outlive the compilation that filled it.
+ *
+ * In the same way, the EVM assemblies of sub-objects are stored under a hash of their optimized
+ * code and of the settings of the code generator and the EVM assembly optimiser, so that they
+ * are generated, optimised and assembled only once. Assemblies are not copied, but shared between
+ * all the assemblies they are embedded in, which is why they are only stored once they are final.
+ */
+class OptimizedObjectCache
+{
+public:
+	/// @returns the optimized code stored under @a _key, or nullptr if there is none.
+	std::shared_ptr<Block const> find(util::h256 const& _key) const;
+	/// Stores @a _optimizedCode under @a _key. Existing entries are not overwritten.
+	void store(util::h256 const& _key, std::shared_ptr<Block const> _optimizedCode);
+
+	/// @returns the assembly stored under @a _key, or nullptr if there is none.
+	/// The assembly must not be modified.
+	std::shared_ptr<evmasm::Assembly> findAssembly(util::h256 const& _key) const;
+	/// Stores @a _assembly under @a _key. It has to be optimised and assembled already, since it
+	/// is used by other threads without synchronization. Existing entries are not overwritten.
+	void storeAssembly(util::h256 const& _key, std::shared_ptr<evmasm::Assembly> _assembly);
+
+	/// @returns the number of cached optimized objects.
+	size_t size() const;
+	/// @returns the number of cached assemblies.
+	size_t numAssemblies() const;
+	/// Removes all entries from the cache.
+	void clear();
+
+	/// @returns a hash of @a _code that is part of the keys of the cache. In contrast to the
+	/// BlockHasher, it is a cryptographic hash and takes all names, literals and debug data into
+	/// account, apart from the locations in the Yul source, which do not influence the result of
+	/// optimizing or compiling the code.
+	static util::h256 codeHash(Block const& _code);
+
+private:
+	std::mutex mutable m_mutex;
+	std::map<util::h256, std::shared_ptr<Block const>> m_optimizedCode;
+	std::map<util::h256, std::shared_ptr<evmasm::Assembly>> m_assemblies;
+};
+
+}
@@ -30,15 +30,18 @@
 #include <libyul/backends/evm/EVMObjectCompiler.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/Suite.h>
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 #include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string.hpp>
 
 #include <optional>
+#include <set>
 
 using namespace solidity;
 using namespace solidity::frontend;
@@ -62,6 +65,49 @@ Dialect const& languageToDialect(YulStack::Language _language, EVMVersion _versi
 	return Dialect::yulDeprecated();
 }
 
+/// Sets the IDs of the sub-objects nested in @a _object to those of the matching sub-assemblies
+/// of @a _assembly, which was generated from the same object.
+void setSubObjectIds(Object& _object, evmasm::Assembly const& _assembly)
+{
+	for (auto const& subNode: _object.subObjects)
+		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
+		{
+			std::optional<size_t> subId;
+			for (size_t i = 0; i < _assembly.numSubs(); ++i)
+				if (_assembly.sub(i).name() == subObject->name)
+					subId = i;
+			yulAssert(subId.has_value(), "Sub-assembly of object <" + subObject->name + "> not found.");
+			subObject->subId = *subId;
+			setSubObjectIds(*subObject, _assembly.sub(*subId));
+		}
+}
+
+/// Stores the assemblies of the sub-objects of @a _object that have a key and were not taken from
+/// the cache. Yul code cannot refer to the tags of sub-assemblies, so they are optimised
+/// independently of the assembly they are embedded in.
+void storeSubAssemblies(
+	OptimizedObjectCache& _cache,
+	Object const& _object,
+	evmasm::Assembly const& _assembly,
+	std::map<Object const*, h256> const& _keys,
+	std::set<Object const*> const& _reusedSubObjects
+)
+{
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+		{
+			if (_reusedSubObjects.count(subObject))
+				continue;
+			std::shared_ptr<evmasm::Assembly> const& subAssembly = _assembly.subPointer(subObject->subId);
+			storeSubAssemblies(_cache, *subObject, *subAssembly, _keys, _reusedSubObjects);
+			// Assembling fills the state that is read when the assembly is embedded again, so that the
+			// assembly is not modified after it was shared. Empty code would be assembled again each time.
+			if (h256 const* key = util::valueOrNullptr(_keys, subObject))
+				if (!subAssembly->assemble().bytecode.empty())
+					_cache.storeAssembly(*key, subAssembly);
+		}
+}
+
 }
 
 
@@ -172,7 +218,11 @@ bool YulStack::analyzeParsed(Object& _object)
 	return success;
 }
 
-void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
+void YulStack::compileEVM(
+	AbstractAssembly& _assembly,
+	bool _optimize,
+	EVMObjectCompiler::SubAssemblyLookup const& _lookupSubAssembly
+) const
 {
 	EVMDialect const* dialect = nullptr;
 	switch (m_language)
@@ -189,21 +239,49 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion, _lookupSubAssembly);
 }
 
-void YulStack::optimize(Object& _object, bool _isCreation)
+std::optional<h256> YulStack::optimize(Object& _object, bool _isCreation)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+
+	// The keys of the sub-objects are part of the key of this object. An object is only cached
+	// if all its sub-objects are.
+	bool cacheable = m_optimizedObjectCache && _object.debugData && _object.debugData->sourceNames;
+	std::string subObjectKeys;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			optimize(*subObject, isCreation);
+			std::optional<h256> subObjectKey = optimize(*subObject, isCreation);
+			if (subObjectKey)
+				subObjectKeys += "object " + subObject->name + " " + subObjectKey->hex() + "\n";
+			else
+				cacheable = false;
 		}
+		else
+			subObjectKeys += "data " + subNode->name + " " + keccak256(dynamic_cast<Data const&>(*subNode).data).hex() + "\n";
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+
+	// The cache is neither used nor filled while profiling, so that the steps are recorded for
+	// every object and not only for the one stack that happened to optimize it first.
+	std::optional<h256> cacheKey;
+	if (cacheable)
+	{
+		cacheKey = optimizedObjectCacheKey(_object, _isCreation, subObjectKeys);
+		if (!m_yulOptimiserProfile)
+			if (std::shared_ptr<Block const> optimizedCode = m_optimizedObjectCache->find(*cacheKey))
+			{
+				// Analysis information is recomputed for the whole tree after optimization.
+				_object.code = std::make_shared<Block>(std::get<Block>(ASTCopier{}(*optimizedCode)));
+				_object.analysisInfo = std::make_shared<AsmAnalysisInfo>();
+				return cacheKey;
+			}
+	}
+
 	std::unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
@@ -242,7 +320,87 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		yulOptimiserSteps,
 		yulOptimiserCleanupSteps,
 		_isCreation ? std::nullopt : std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		m_yulOptimiserProfile
+	);
+
+	// The stored copy is not modified later on and can be shared by the stacks of all threads.
+	if (cacheKey && !m_yulOptimiserProfile)
+		m_optimizedObjectCache->store(
+			*cacheKey,
+			std::make_shared<Block const>(std::get<Block>(ASTCopier{}(*_object.code)))
+		);
+	return cacheKey;
+}
+
+h256 YulStack::optimizedObjectCacheKey(
+	Object const& _object,
+	bool _isCreation,
+	std::string const& _subObjectKeys
+) const
+{
+	return objectCacheKey(
+		_object,
+		_subObjectKeys,
+		std::string("optimized:") +
+		(_isCreation ? "creation" : "runtime") + ":" +
+		(m_optimiserSettings.runYulOptimiser ? "1" : "0") +
+		(m_optimiserSettings.optimizeStackAllocation ? "1" : "0") + ":" +
+		std::to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + ":" +
+		m_optimiserSettings.yulOptimiserSteps + ":" +
+		m_optimiserSettings.yulOptimiserCleanupSteps
+	);
+}
+
+std::optional<h256> YulStack::assembledObjectCacheKey(
+	Object const& _object,
+	std::string const& _settings,
+	std::map<Object const*, h256>& _keys
+) const
+{
+	bool cacheable = _object.debugData && _object.debugData->sourceNames;
+	std::string subObjectKeys;
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+		{
+			std::optional<h256> subObjectKey = assembledObjectCacheKey(*subObject, _settings, _keys);
+			if (subObjectKey)
+				subObjectKeys += "object " + subObject->name + " " + subObjectKey->hex() + "\n";
+			else
+				cacheable = false;
+		}
+		else
+			subObjectKeys += "data " + subNode->name + " " + keccak256(dynamic_cast<Data const&>(*subNode).data).hex() + "\n";
+
+	if (!cacheable)
+		return std::nullopt;
+	h256 key = objectCacheKey(_object, subObjectKeys, _settings);
+	_keys[&_object] = key;
+	return key;
+}
+
+h256 YulStack::objectCacheKey(
+	Object const& _object,
+	std::string const& _subObjectKeys,
+	std::string const& _settings
+) const
+{
+	// The key has to cover everything the cached result depends on. The hash of the code includes
+	// the debug data, because it is preserved by the optimizer and ends up in the output.
+	// Sub-objects are only represented by their own keys, so that every object is hashed only once.
+	yulAssert(_object.debugData && _object.debugData->sourceNames);
+	std::string sourceNames;
+	for (auto const& [index, name]: *_object.debugData->sourceNames)
+		sourceNames += std::to_string(index) + ":" + util::escapeAndQuoteString(*name) + " ";
+	return keccak256(
+		"object " + _object.name + "\n" +
+		sourceNames + "\n" +
+		OptimizedObjectCache::codeHash(*_object.code).hex() + "\n" +
+		_subObjectKeys +
+		std::to_string(static_cast<int>(m_language)) + ":" +
+		m_evmVersion.name() + ":" +
+		(m_eofVersion.has_value() ? std::to_string(*m_eofVersion) : "") + ":" +
+		_settings
 	);
 }
 
@@ -322,9 +480,46 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
 	);
 	try
 	{
-		compileEVM(adapter, optimize);
-
-		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+		evmasm::Assembly::OptimiserSettings assemblyOptimiserSettings =
+			evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion);
+		assemblyOptimiserSettings.profile = m_evmasmOptimiserProfile;
+
+		// The assemblies of sub-objects are taken from the cache or stored in it once they are
+		// optimised and assembled. This is skipped while profiling, since the passes are not run
+		// again for cached assemblies, and for EOF.
+		std::map<Object const*, h256> subObjectKeys;
+		if (m_optimizedObjectCache && !m_evmasmOptimiserProfile && !m_eofVersion.has_value())
+		{
+			std::string settings =
+				std::string("assembled:") +
+				(optimize ? "1" : "0") + ":" +
+				(assemblyOptimiserSettings.runInliner ? "1" : "0") +
+				(assemblyOptimiserSettings.runJumpdestRemover ? "1" : "0") +
+				(assemblyOptimiserSettings.runPeephole ? "1" : "0") +
+				(assemblyOptimiserSettings.runDeduplicate ? "1" : "0") +
+				(assemblyOptimiserSettings.runCSE ? "1" : "0") +
+				(assemblyOptimiserSettings.runConstantOptimiser ? "1" : "0") + ":" +
+				std::to_string(assemblyOptimiserSettings.expectedExecutionsPerDeployment);
+			for (auto const& subNode: m_parserResult->subObjects)
+				if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+					assembledObjectCacheKey(*subObject, settings, subObjectKeys);
+		}
+		std::set<Object const*> reusedSubObjects;
+		compileEVM(adapter, optimize, [&](Object& _subObject, AbstractAssembly& _assembly) -> std::optional<AbstractAssembly::SubID> {
+			h256 const* key = util::valueOrNullptr(subObjectKeys, &_subObject);
+			if (!key)
+				return std::nullopt;
+			std::shared_ptr<evmasm::Assembly> subAssembly = m_optimizedObjectCache->findAssembly(*key);
+			if (!subAssembly)
+				return std::nullopt;
+			setSubObjectIds(_subObject, *subAssembly);
+			reusedSubObjects.insert(&_subObject);
+			return dynamic_cast<EthAssemblyAdapter&>(_assembly).appendSubAssembly(std::move(subAssembly));
+		});
+
+		assembly.optimise(assemblyOptimiserSettings);
+		if (!subObjectKeys.empty())
+			storeSubAssemblies(*m_optimizedObjectCache, *m_parserResult, assembly, subObjectKeys, reusedSubObjects);
 
 		std::optional<size_t> subIndex;
 
@@ -26,15 +26,20 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/StepProfile.h>
 
+#include <libyul/backends/evm/EVMObjectCompiler.h>
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/OptimizedObjectCache.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace solidity::evmasm
@@ -88,13 +93,15 @@ public:
 		std::optional<uint8_t> _eofVersion,
 		Language _language,
 		solidity::frontend::OptimiserSettings _optimiserSettings,
-		langutil::DebugInfoSelection const& _debugInfoSelection
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		std::shared_ptr<OptimizedObjectCache> _optimizedObjectCache = nullptr
 	):
 		m_language(_language),
 		m_evmVersion(_evmVersion),
 		m_eofVersion(_eofVersion),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_debugInfoSelection(_debugInfoSelection),
+		m_optimizedObjectCache(std::move(_optimizedObjectCache)),
 		m_errorReporter(m_errors)
 	{}
 
@@ -107,8 +114,20 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
+	/// If an optimized object cache was provided, objects found in the cache are not optimized
+	/// again and newly optimized objects are added to it. Only objects with a @use-src annotation
+	/// are cached. The result is the same whether or not a cache is used.
 	void optimize();
 
+	/// Enables recording the execution statistics of the Yul optimiser steps in @a _yulProfile and
+	/// of the EVM assembly optimiser passes in @a _evmasmProfile. Null pointers disable recording.
+	/// While recording, the optimized object cache is neither used nor filled.
+	void setOptimiserProfiles(util::StepProfile* _yulProfile, util::StepProfile* _evmasmProfile)
+	{
+		m_yulOptimiserProfile = _yulProfile;
+		m_evmasmOptimiserProfile = _evmasmProfile;
+	}
+
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine);
 
@@ -145,9 +164,41 @@ private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
 
-	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
+	void compileEVM(
+		yul::AbstractAssembly& _assembly,
+		bool _optimize,
+		EVMObjectCompiler::SubAssemblyLookup const& _lookupSubAssembly = {}
+	) const;
+
+	/// Optimizes @a _object and its sub-objects.
+	/// @returns the key of the object in the optimized object cache, if it was cached.
+	std::optional<util::h256> optimize(yul::Object& _object, bool _isCreation);
+
+	/// @returns the key under which the result of optimizing @a _object is stored in the optimized
+	/// object cache. @a _subObjectKeys has to list the keys of the sub-objects.
+	util::h256 optimizedObjectCacheKey(
+		yul::Object const& _object,
+		bool _isCreation,
+		std::string const& _subObjectKeys
+	) const;
+
+	/// Computes the keys under which the assemblies of @a _object and its sub-objects are stored in
+	/// the optimized object cache and adds them to @a _keys. @a _settings has to represent all
+	/// settings of the code generator and the EVM assembly optimiser.
+	/// @returns the key of @a _object, or nullopt if it or one of its sub-objects is not cached.
+	std::optional<util::h256> assembledObjectCacheKey(
+		yul::Object const& _object,
+		std::string const& _settings,
+		std::map<yul::Object const*, util::h256>& _keys
+	) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// @returns the key of @a _object in the optimized object cache for a given representation of
+	/// the keys of its sub-objects and of the settings the cached result depends on.
+	util::h256 objectCacheKey(
+		yul::Object const& _object,
+		std::string const& _subObjectKeys,
+		std::string const& _settings
+	) const;
 
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
@@ -156,6 +207,9 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	std::shared_ptr<OptimizedObjectCache> m_optimizedObjectCache;
+	util::StepProfile* m_yulOptimiserProfile = nullptr;
+	util::StepProfile* m_evmasmOptimiserProfile = nullptr;
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
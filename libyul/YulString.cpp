@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <cstring>
+
+using namespace solidity::yul;
+
+thread_local YulStringRepository* YulStringRepository::m_current = nullptr;
+
+namespace
+{
+
+std::uint64_t mix(std::uint64_t _value)
+{
+	_value ^= _value >> 32;
+	_value *= 0xd6e8feb86659fd93u;
+	_value ^= _value >> 32;
+	_value *= 0xd6e8feb86659fd93u;
+	_value ^= _value >> 32;
+	return _value;
+}
+
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(std::string const& _string)
+{
+	if (_string.empty())
+		return emptyHandle();
+
+	Key key{_string, lookupHash(_string)};
+	Shard& shard = m_shards[key.lookupHash % shardCount];
+	{
+		std::shared_lock lock(shard.mutex);
+		if (auto it = shard.handles.find(key); it != shard.handles.end())
+			return it->second;
+	}
+
+	std::unique_lock lock(shard.mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (auto it = shard.handles.find(key); it != shard.handles.end())
+		return it->second;
+	std::string const& inserted = shard.strings.emplace_back(_string);
+	// The stable hash is only computed once per distinct string.
+	Handle handle{&inserted, hash(inserted)};
+	key.string = inserted;
+	shard.handles.emplace(key, handle);
+	return handle;
+}
+
+void YulStringRepository::reset()
+{
+	instance().clear();
+}
+
+YulStringRepository::CompilationScope::CompilationScope():
+	CompilationScope(m_current ? m_current->shared_from_this() : create())
+{
+}
+
+YulStringRepository::CompilationScope::CompilationScope(std::shared_ptr<YulStringRepository> _repository):
+	m_repository(std::move(_repository)),
+	m_previous(m_current)
+{
+	m_current = m_repository.get();
+}
+
+YulStringRepository::CompilationScope::~CompilationScope()
+{
+	m_current = m_previous;
+}
+
+std::shared_ptr<YulStringRepository> YulStringRepository::create()
+{
+	return std::shared_ptr<YulStringRepository>(new YulStringRepository());
+}
+
+std::shared_ptr<YulStringRepository> YulStringRepository::currentCompilation()
+{
+	return m_current ? m_current->shared_from_this() : nullptr;
+}
+
+std::uint64_t YulStringRepository::lookupHash(std::string_view _string)
+{
+	// Processes eight bytes at a time.
+	std::uint64_t result = 0x9e3779b97f4a7c15u ^ _string.size();
+	size_t position = 0;
+	for (; position + 8 <= _string.size(); position += 8)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, _string.data() + position, 8);
+		result = mix(result ^ word);
+	}
+	std::uint64_t tail = 0;
+	std::memcpy(&tail, _string.data() + position, _string.size() - position);
+	return mix(result ^ tail);
+}
+
+void YulStringRepository::clear()
+{
+	{
+		// Cached objects might refer to the strings, so they are destroyed first.
+		std::lock_guard lock(m_cachesMutex);
+		m_caches.clear();
+	}
+	for (Shard& shard: m_shards)
+	{
+		std::unique_lock lock(shard.mutex);
+		shard.handles.clear();
+		shard.strings.clear();
+	}
+}
@@ -23,10 +23,18 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <typeindex>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace solidity::yul
@@ -34,43 +42,37 @@ namespace solidity::yul
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
-class YulStringRepository
+/// A Handle consists of a pointer to the owned string (which is unique per string content,
+/// but whose value depends on the insertion order and is potentially non-deterministic) and a
+/// deterministic string hash.
+/// Looking up and inserting strings is thread-safe, dereferencing a handle does not require
+/// access to the repository at all. The strings are distributed over several shards with
+/// separate locks, so that the threads of a compilation rarely wait for each other.
+/// Every compilation holding a CompilationScope has its own repository, all other code shares
+/// a global one.
+class YulStringRepository: public std::enable_shared_from_this<YulStringRepository>
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		std::string const* string;
 		std::uint64_t hash;
 	};
 
+	/// @returns the repository of the innermost compilation scope of the calling thread
+	/// or the global repository if there is none.
 	static YulStringRepository& instance()
 	{
-		static YulStringRepository inst;
-		return inst;
+		static YulStringRepository globalRepository;
+		return m_current ? *m_current : globalRepository;
 	}
 
-	Handle stringToHandle(std::string const& _string)
-	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
-	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
+	Handle stringToHandle(std::string const& _string);
 
+	/// Deterministic hash of the string contents. Determines the order of YulStrings.
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -81,45 +83,101 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
+	/// @returns the handle of the empty string, which does not depend on the repository state.
+	static Handle emptyHandle()
+	{
+		static std::string const emptyString;
+		return Handle{&emptyString, emptyHash()};
+	}
+	/// Clear the repository of the calling thread, i.e. the one returned by instance().
 	/// Use with care - there cannot be any dangling YulString references.
-	/// If references need to be cleared manually, register the callback via
-	/// resetCallback.
-	static void reset()
+	/// Objects stored via cache() are destroyed as well.
+	static void reset();
+
+	/// @returns the object of type @a T stored in this repository, which is default-constructed
+	/// on first use. Meant for objects that hold YulStrings and are shared by a compilation, like
+	/// the dialects. They are destroyed together with the strings, so they never refer to strings
+	/// of a different repository.
+	template <typename T>
+	T& cache()
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		std::lock_guard lock(m_cachesMutex);
+		std::shared_ptr<void>& cached = m_caches[std::type_index(typeid(T))];
+		if (!cached)
+			cached = std::make_shared<T>();
+		return *static_cast<T*>(cached.get());
 	}
-	/// Struct that registers a reset callback as a side-effect of its construction.
-	/// Useful as static local variable to register a reset callback once.
-	struct ResetCallback
+
+	/// Makes the calling thread use the repository of a compilation until the scope ends.
+	/// The default constructor continues the compilation of an enclosing scope on the same thread
+	/// or starts a new compilation with an empty repository. Worker threads of a compilation join
+	/// it by passing the result of currentCompilation() obtained on the starting thread.
+	/// A repository is released together with the last scope using it, so compilations that run
+	/// concurrently in the same process neither share nor clear each other's strings.
+	class CompilationScope
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+	public:
+		CompilationScope();
+		/// Uses @a _repository, or the global repository if it is null.
+		explicit CompilationScope(std::shared_ptr<YulStringRepository> _repository);
+		~CompilationScope();
+		CompilationScope(CompilationScope const&) = delete;
+		CompilationScope& operator=(CompilationScope const&) = delete;
+
+	private:
+		std::shared_ptr<YulStringRepository> m_repository;
+		YulStringRepository* m_previous;
 	};
 
+	/// @returns a new, empty repository, which can be used by a compilation via CompilationScope.
+	static std::shared_ptr<YulStringRepository> create();
+	/// @returns the repository of the innermost compilation scope of the calling thread
+	/// or a null pointer if there is none.
+	static std::shared_ptr<YulStringRepository> currentCompilation();
+
 private:
+	/// Hash used to locate strings in the repository.
+	/// Much faster than hash() on long strings, but not guaranteed to be stable.
+	static std::uint64_t lookupHash(std::string_view _string);
+
+	struct Key
+	{
+		std::string_view string;
+		std::uint64_t lookupHash;
+		bool operator==(Key const& _other) const { return string == _other.string; }
+	};
+	struct KeyHash
+	{
+		size_t operator()(Key const& _key) const { return static_cast<size_t>(_key.lookupHash); }
+	};
+	struct Shard
+	{
+		std::shared_mutex mutable mutex;
+		/// Storage of the strings. Elements of a deque are never moved on insertion,
+		/// so handles and keys can point into it.
+		std::deque<std::string> strings;
+		std::unordered_map<Key, Handle, KeyHash> handles;
+	};
+	static constexpr size_t shardCount = 16;
+
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
-	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+	/// Destroys the cached objects and clears all shards.
+	void clear();
+
+	std::array<Shard, shardCount> m_shards;
+
+	std::mutex m_cachesMutex;
+	/// Objects stored via cache(), by type. Guarded by m_cachesMutex.
+	std::map<std::type_index, std::shared_ptr<void>> m_caches;
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	static thread_local YulStringRepository* m_current;
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing the addresses of their owned strings.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -134,32 +192,29 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical handles (only identical strings have
+	/// identical handles and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.string == _other.m_handle.string) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the string handle.
+	bool operator==(YulString const& _other) const { return m_handle.string == _other.m_handle.string; }
+	bool operator!=(YulString const& _other) const { return m_handle.string != _other.m_handle.string; }
 
-	bool empty() const { return m_handle.id == 0; }
-	std::string const& str() const
-	{
-		return YulStringRepository::instance().idToString(m_handle.id);
-	}
+	bool empty() const { return m_handle.string->empty(); }
+	std::string const& str() const { return *m_handle.string; }
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string.
+	YulStringRepository::Handle m_handle = YulStringRepository::emptyHandle();
 };
 
 inline YulString operator "" _yulname(char const* _string, std::size_t _size)
@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std::string_literals;
@@ -393,8 +394,15 @@ bool EVMDialect::reservedIdentifier(YulName _name) const
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
-	static std::map<langutil::EVMVersion, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	// The dialects hold YulStrings, so they are stored in the repository of the current compilation.
+	struct Cache
+	{
+		std::mutex mutex;
+		std::map<langutil::EVMVersion, std::unique_ptr<EVMDialect const>> dialects;
+	};
+	Cache& cache = YulStringRepository::instance().cache<Cache>();
+	std::lock_guard lock(cache.mutex);
+	auto& dialects = cache.dialects;
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<EVMDialect>(_version, false);
 	return *dialects[_version];
@@ -402,8 +410,14 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
-	static std::map<langutil::EVMVersion, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	struct Cache
+	{
+		std::mutex mutex;
+		std::map<langutil::EVMVersion, std::unique_ptr<EVMDialect const>> dialects;
+	};
+	Cache& cache = YulStringRepository::instance().cache<Cache>();
+	std::lock_guard lock(cache.mutex);
+	auto& dialects = cache.dialects;
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<EVMDialect>(_version, true);
 	return *dialects[_version];
@@ -432,6 +446,7 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	std::pair<size_t, size_t> key{_arguments, _returnVariables};
+	std::lock_guard lock(m_verbatimFunctionsMutex);
 	std::shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -558,8 +573,14 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulName _type) co
 
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
-	static std::map<langutil::EVMVersion, std::unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	struct Cache
+	{
+		std::mutex mutex;
+		std::map<langutil::EVMVersion, std::unique_ptr<EVMDialectTyped const>> dialects;
+	};
+	Cache& cache = YulStringRepository::instance().cache<Cache>();
+	std::lock_guard lock(cache.mutex);
+	auto& dialects = cache.dialects;
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<EVMDialectTyped>(_version, true);
 	return *dialects[_version];
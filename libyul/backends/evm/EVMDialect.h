@@ -28,6 +28,7 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace solidity::yul
@@ -99,6 +100,8 @@ protected:
 	langutil::EVMVersion const m_evmVersion;
 	std::map<YulName, BuiltinFunctionForEVM> m_functions;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
+	/// Guards m_verbatimFunctions, since dialects are shared between concurrent compilations.
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::set<YulName> m_reserved;
 };
 
@@ -39,10 +39,11 @@ void EVMObjectCompiler::compile(
 	AbstractAssembly& _assembly,
 	EVMDialect const& _dialect,
 	bool _optimize,
-	std::optional<uint8_t> _eofVersion
+	std::optional<uint8_t> _eofVersion,
+	SubAssemblyLookup const& _lookupSubAssembly
 )
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion);
+	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion, _lookupSubAssembly);
 	compiler.run(_object, _optimize);
 }
 
@@ -55,11 +56,19 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	for (auto const& subNode: _object.subObjects)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
-			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
-			context.subIDs[subObject->name] = subAssemblyAndID.second;
-			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			std::optional<AbstractAssembly::SubID> subID;
+			if (m_lookupSubAssembly)
+				subID = m_lookupSubAssembly(*subObject, m_assembly);
+			if (!subID)
+			{
+				bool isCreation = !boost::ends_with(subObject->name, "_deployed");
+				auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
+				subID = subAssemblyAndID.second;
+				subObject->subId = subAssemblyAndID.second;
+				compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion, m_lookupSubAssembly);
+			}
+			context.subIDs[subObject->name] = *subID;
+			subObject->subId = *subID;
 		}
 		else
 		{
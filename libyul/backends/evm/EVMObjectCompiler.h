@@ -21,28 +21,42 @@
 
 #pragma once
 
+#include <libyul/backends/evm/AbstractAssembly.h>
+
+#include <functional>
 #include <optional>
 #include <cstdint>
 
 namespace solidity::yul
 {
 struct Object;
-class AbstractAssembly;
 struct EVMDialect;
 
 class EVMObjectCompiler
 {
 public:
+	/// Called for every sub-object before it is compiled, with the assembly it belongs to.
+	/// If an assembly of the sub-object is available already, it can be added to that assembly
+	/// and its ID returned, in which case the sub-object is not compiled again.
+	/// The IDs of the sub-objects nested in it then have to be set as well.
+	using SubAssemblyLookup = std::function<std::optional<AbstractAssembly::SubID>(Object& _subObject, AbstractAssembly& _assembly)>;
+
 	static void compile(
 		Object& _object,
 		AbstractAssembly& _assembly,
 		EVMDialect const& _dialect,
 		bool _optimize,
-		std::optional<uint8_t> _eofVersion
+		std::optional<uint8_t> _eofVersion,
+		SubAssemblyLookup const& _lookupSubAssembly = {}
 	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, std::optional<uint8_t> _eofVersion):
-		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		std::optional<uint8_t> _eofVersion,
+		SubAssemblyLookup const& _lookupSubAssembly
+	):
+		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion), m_lookupSubAssembly(_lookupSubAssembly)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -50,6 +64,7 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	std::optional<uint8_t> m_eofVersion;
+	SubAssemblyLookup const& m_lookupSubAssembly;
 };
 
 }
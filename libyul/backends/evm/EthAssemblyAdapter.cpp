@@ -128,6 +128,12 @@ std::pair<std::shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EthAssembl
 	return {std::make_shared<EthAssemblyAdapter>(*assembly), static_cast<size_t>(sub.data())};
 }
 
+AbstractAssembly::SubID EthAssemblyAdapter::appendSubAssembly(std::shared_ptr<evmasm::Assembly> _assembly)
+{
+	auto sub = m_assembly.newSub(std::move(_assembly));
+	return static_cast<size_t>(sub.data());
+}
+
 void EthAssemblyAdapter::appendDataOffset(std::vector<AbstractAssembly::SubID> const& _subPath)
 {
 	if (auto it = m_dataHashBySubId.find(_subPath[0]); it != m_dataHashBySubId.end())
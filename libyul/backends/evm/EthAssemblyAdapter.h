@@ -56,6 +56,8 @@ public:
 	void appendJumpToIf(LabelID _labelId, JumpType _jumpType) override;
 	void appendAssemblySize() override;
 	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(bool _creation, std::string _name = {}) override;
+	/// Adds @a _assembly, which was generated before, as a sub-assembly without copying it.
+	SubID appendSubAssembly(std::shared_ptr<evmasm::Assembly> _assembly);
 	void appendDataOffset(std::vector<SubID> const& _subPath) override;
 	void appendDataSize(std::vector<SubID> const& _subPath) override;
 	SubID appendData(bytes const& _data) override;
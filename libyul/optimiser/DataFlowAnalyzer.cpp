@@ -32,8 +32,9 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
+#include <algorithm>
+#include <iterator>
 #include <variant>
 
 #include <range/v3/view/reverse.hpp>
@@ -42,6 +43,57 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Erases the entries matching @a _predicate without copying @a _map if there are none.
+/// Evaluates the predicate only once per entry: If the value is shared, only the remaining
+/// entries are copied.
+template<typename Map, typename Predicate>
+void eraseIf(CopyOnWrite<Map>& _map, Predicate _predicate)
+{
+	auto it = std::find_if(_map->begin(), _map->end(), _predicate);
+	if (it == _map->end())
+		return;
+
+	if (_map.isShared())
+	{
+		Map remaining;
+		if constexpr (requires { remaining.reserve(0); })
+			remaining.reserve(_map->size());
+		remaining.insert(_map->begin(), it);
+		std::copy_if(std::next(it), _map->end(), std::inserter(remaining, remaining.end()), [&](auto const& _entry) {
+			return !_predicate(_entry);
+		});
+		_map = remaining.empty() ? CopyOnWrite<Map>{} : CopyOnWrite<Map>{std::move(remaining)};
+		return;
+	}
+
+	// Not shared, so writing does not copy and the iterator stays valid.
+	Map& map = _map.write();
+	for (it = map.erase(it); it != map.end();)
+		if (_predicate(*it))
+			it = map.erase(it);
+		else
+			++it;
+}
+
+template<typename Map, typename Key>
+void erase(CopyOnWrite<Map>& _map, Key const& _key)
+{
+	if (_map->count(_key))
+		_map.write().erase(_key);
+}
+
+template<typename Map>
+void clear(CopyOnWrite<Map>& _map)
+{
+	if (!_map->empty())
+		_map = CopyOnWrite<Map>{};
+}
+
+}
+
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
 	MemoryAndStorage _analyzeStores,
@@ -72,23 +124,23 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
+			eraseIf(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
 				return
 					!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
 					vars->second != value;
 			}));
-			m_state.environment.storage[vars->first] = vars->second;
+			m_state.environment.storage.write()[vars->first] = vars->second;
 			return;
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
+			eraseIf(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
 				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
 			}));
 			// TODO erase keccak knowledge, but in a more clever way
-			m_state.environment.keccak = {};
-			m_state.environment.memory[vars->first] = vars->second;
+			clear(m_state.environment.keccak);
+			m_state.environment.memory.write()[vars->first] = vars->second;
 			return;
 		}
 	}
@@ -224,7 +276,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.storage, _key))
+	if (YulName const* value = valueOrNullptr(*m_state.environment.storage, _key))
 		return *value;
 	else
 		return std::nullopt;
@@ -232,7 +284,7 @@ std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 
 std::optional<YulName> DataFlowAnalyzer::memoryValue(YulName _key) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.memory, _key))
+	if (YulName const* value = valueOrNullptr(*m_state.environment.memory, _key))
 		return *value;
 	else
 		return std::nullopt;
@@ -240,7 +292,7 @@ std::optional<YulName> DataFlowAnalyzer::memoryValue(YulName _key) const
 
 std::optional<YulName> DataFlowAnalyzer::keccakValue(YulName _start, YulName _length) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.keccak, std::make_pair(_start, _length)))
+	if (YulName const* value = valueOrNullptr(*m_state.environment.keccak, std::make_pair(_start, _length)))
 		return *value;
 	else
 		return std::nullopt;
@@ -274,16 +326,16 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
-			m_state.environment.storage.erase(name);
+			erase(m_state.environment.storage, name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			eraseIf(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
 			// assignment to slot denoted by "name"
-			m_state.environment.memory.erase(name);
+			erase(m_state.environment.memory, name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.keccak, [&name](auto&& _item) {
+			eraseIf(m_state.environment.keccak, [&name](auto&& _item) {
 				return _item.first.first == name || _item.first.second == name || _item.second == name;
 			});
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			eraseIf(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
 		}
 	}
 
@@ -296,11 +348,11 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.environment.memory[*key] = variable;
+				m_state.environment.memory.write()[*key] = variable;
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.environment.storage[*key] = variable;
+				m_state.environment.storage.write()[*key] = variable;
 			else if (auto arguments = isKeccak(*_value))
-				m_state.environment.keccak[*arguments] = variable;
+				m_state.environment.keccak.write()[*arguments] = variable;
 		}
 	}
 }
@@ -341,9 +393,9 @@ void DataFlowAnalyzer::clearValues(std::set<YulName> _variables)
 	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
 		return _variables.count(key) || _variables.count(value);
 	});
-	cxx20::erase_if(m_state.environment.storage, eraseCondition);
-	cxx20::erase_if(m_state.environment.memory, eraseCondition);
-	cxx20::erase_if(m_state.environment.keccak, [&_variables](auto&& _item) {
+	eraseIf(m_state.environment.storage, eraseCondition);
+	eraseIf(m_state.environment.memory, eraseCondition);
+	eraseIf(m_state.environment.keccak, [&_variables](auto&& _item) {
 		return
 			_variables.count(_item.first.first) ||
 			_variables.count(_item.first.second) ||
@@ -376,11 +428,11 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 		return;
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
+		clear(m_state.environment.storage);
 	if (sideEffects.invalidatesMemory())
 	{
-		m_state.environment.memory.clear();
-		m_state.environment.keccak.clear();
+		clear(m_state.environment.memory);
+		clear(m_state.environment.keccak);
 	}
 }
 
@@ -390,11 +442,11 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 		return;
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
+		clear(m_state.environment.storage);
 	if (sideEffects.invalidatesMemory())
 	{
-		m_state.environment.memory.clear();
-		m_state.environment.keccak.clear();
+		clear(m_state.environment.memory);
+		clear(m_state.environment.keccak);
 	}
 }
 
@@ -459,23 +511,27 @@ void DataFlowAnalyzer::joinKnowledge(Environment const& _olderEnvironment)
 		return;
 	joinKnowledgeHelper(m_state.environment.storage, _olderEnvironment.storage);
 	joinKnowledgeHelper(m_state.environment.memory, _olderEnvironment.memory);
-	cxx20::erase_if(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
-		YulName const* oldValue = valueOrNullptr(_olderEnvironment.keccak, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	if (!m_state.environment.keccak.sharesValueWith(_olderEnvironment.keccak))
+		eraseIf(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
+			YulName const* oldValue = valueOrNullptr(*_olderEnvironment.keccak, key);
+			return !oldValue || *oldValue != currentValue;
+		}));
 }
 
 void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulName, YulName>& _this,
-	std::unordered_map<YulName, YulName> const& _older
+	CopyOnWrite<std::unordered_map<YulName, YulName>>& _this,
+	CopyOnWrite<std::unordered_map<YulName, YulName>> const& _older
 )
 {
+	// Nothing has changed if the knowledge is still shared with the older version.
+	if (_this.sharesValueWith(_older))
+		return;
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_state.environment.memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_state.environment.memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulName const* oldValue = valueOrNullptr(_older, key);
+	eraseIf(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
+		YulName const* oldValue = valueOrNullptr(*_older, key);
 		return !oldValue || *oldValue != currentValue;
 	}));
 }
@@ -31,6 +31,7 @@
 
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Common.h>
+#include <libsolutil/CopyOnWrite.h>
 
 #include <map>
 #include <set>
@@ -168,12 +169,14 @@ protected:
 	std::map<YulName, SideEffects> m_functionSideEffects;
 
 private:
+	/// Knowledge about storage and memory. It is copied at every branch of the control-flow,
+	/// so the maps are only actually copied once a branch modifies them.
 	struct Environment
 	{
-		std::unordered_map<YulName, YulName> storage;
-		std::unordered_map<YulName, YulName> memory;
+		util::CopyOnWrite<std::unordered_map<YulName, YulName>> storage;
+		util::CopyOnWrite<std::unordered_map<YulName, YulName>> memory;
 		/// If keccak[s, l] = y then y := keccak256(s, l) occurs in the code.
-		std::map<std::pair<YulName, YulName>, YulName> keccak;
+		util::CopyOnWrite<std::map<std::pair<YulName, YulName>, YulName>> keccak;
 	};
 	struct State
 	{
@@ -192,8 +195,8 @@ private:
 	void joinKnowledge(Environment const& _olderEnvironment);
 
 	static void joinKnowledgeHelper(
-		std::unordered_map<YulName, YulName>& _thisData,
-		std::unordered_map<YulName, YulName> const& _olderData
+		util::CopyOnWrite<std::unordered_map<YulName, YulName>>& _thisData,
+		util::CopyOnWrite<std::unordered_map<YulName, YulName>> const& _olderData
 	);
 
 	State m_state;
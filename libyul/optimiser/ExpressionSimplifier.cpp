@@ -41,12 +41,12 @@ void ExpressionSimplifier::visit(Expression& _expression)
 {
 	ASTModifier::visit(_expression);
 
-	while (auto const* match = SimplificationRules::findFirstMatch(
+	while (auto match = SimplificationRules::findFirstMatch(
 		_expression,
 		m_dialect,
 		[this](YulName _var) { return variableValue(_var); }
 	))
-		_expression = match->action().toExpression(debugDataOf(_expression), evmVersionFromDialect(m_dialect));
+		_expression = match->replacement(debugDataOf(_expression), evmVersionFromDialect(m_dialect));
 
 	if (auto* functionCall = std::get_if<FunctionCall>(&_expression))
 		if (std::optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, functionCall->functionName.name))
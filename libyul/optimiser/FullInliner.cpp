@@ -35,9 +35,12 @@
 #include <libyul/Dialect.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/cxx20.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/action/remove.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/zip.hpp>
 
@@ -53,7 +56,6 @@ void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 
 FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
 	m_ast(_ast),
-	m_recursiveFunctions(CallGraphGenerator::callGraph(_ast).recursiveFunctions()),
 	m_nameDispenser(_dispenser),
 	m_dialect(_dialect)
 {
@@ -80,7 +82,12 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		if (references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
 		updateCodeSize(fun);
+		m_calls[fun.name] = ReferencesCounter::countReferences(fun);
 	}
+	// Only keep the calls to functions defined at the top level.
+	for (auto& calls: m_calls | ranges::views::values)
+		cxx20::erase_if(calls, [&](auto const& _call) { return !m_functions.count(_call.first); });
+	m_recursiveFunctions = callGraph().recursiveFunctions();
 
 	// Check for memory guard.
 	std::vector<FunctionCall*> memoryGuardCalls = findFunctionCalls(_ast, "memoryguard"_yulname);
@@ -115,7 +122,8 @@ void FullInliner::run(Pass _pass)
 	for (FunctionDefinition* fun: functions)
 	{
 		handleBlock(fun->name, fun->body);
-		updateCodeSize(*fun);
+		if (m_tentativeFunctionSizes.erase(fun->name))
+			updateCodeSize(*fun);
 	}
 
 	for (auto& statement: m_ast.statements)
@@ -123,18 +131,17 @@ void FullInliner::run(Pass _pass)
 			handleBlock({}, std::get<Block>(statement));
 }
 
+CallGraph FullInliner::callGraph() const
+{
+	CallGraph cg;
+	for (auto const& [function, calls]: m_calls)
+		cg.functionCalls[function] = calls | ranges::views::keys | ranges::to<std::vector<YulName>>;
+	return cg;
+}
+
 std::map<YulName, size_t> FullInliner::callDepths() const
 {
-	CallGraph cg = CallGraphGenerator::callGraph(m_ast);
-	cg.functionCalls.erase(""_yulname);
-
-	// Remove calls to builtin functions.
-	for (auto& call: cg.functionCalls)
-		for (auto it = call.second.begin(); it != call.second.end();)
-			if (m_dialect.builtin(*it))
-				it = call.second.erase(it);
-			else
-				++it;
+	CallGraph cg = callGraph();
 
 	std::map<YulName, size_t> depths;
 	size_t currentDepth = 0;
@@ -237,6 +244,20 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 void FullInliner::tentativelyUpdateCodeSize(YulName _function, YulName _callSite)
 {
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	m_tentativeFunctionSizes.insert(_callSite);
+}
+
+void FullInliner::updateCalls(YulName _function, YulName _callSite)
+{
+	// Calls from outside of functions are not tracked.
+	auto* callSiteCalls = util::valueOrNullptr(m_calls, _callSite);
+	if (!callSiteCalls)
+		return;
+	assertThrow(_function != _callSite, OptimizerException, "");
+	if (--callSiteCalls->at(_function) == 0)
+		callSiteCalls->erase(_function);
+	for (auto const& [callee, count]: m_calls.at(_function))
+		(*callSiteCalls)[callee] += count;
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
@@ -251,8 +272,7 @@ void FullInliner::handleBlock(YulName _currentFunctionName, Block& _block)
 
 bool FullInliner::recursive(FunctionDefinition const& _fun) const
 {
-	std::map<YulName, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	return m_calls.at(_fun.name).count(_fun.name) > 0;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -295,6 +315,7 @@ std::vector<Statement> InlineModifier::performInline(Statement& _statement, Func
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	m_driver.updateCalls(function->name, m_currentFunction);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -38,6 +38,7 @@ namespace solidity::yul
 {
 
 class NameCollector;
+struct CallGraph;
 
 
 /**
@@ -90,12 +91,18 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulName _function, YulName _callSite);
 
+	/// Updates the calls made by _callSite after a call to _function was replaced by its body.
+	void updateCalls(YulName _function, YulName _callSite);
+
 private:
 	enum Pass { InlineTiny, InlineRest };
 
 	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
 	void run(Pass _pass);
 
+	/// @returns the call graph of the functions defined at the top level, derived from m_calls.
+	CallGraph callGraph() const;
+
 	/// @returns a map containing the maximum depths of a call chain starting at each
 	/// function. For recursive functions, the value is one larger than for all others.
 	std::map<YulName, size_t> callDepths() const;
@@ -120,6 +127,11 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulName> m_constants;
 	std::map<YulName, size_t> m_functionSizes;
+	/// Functions whose entry in m_functionSizes is only an estimate since code was inlined into them.
+	std::set<YulName> m_tentativeFunctionSizes;
+	/// Number of calls to each function defined at the top level made by each of these functions.
+	/// Kept up to date during inlining, so that the AST does not have to be traversed again.
+	std::map<YulName, std::map<YulName, size_t>> m_calls;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
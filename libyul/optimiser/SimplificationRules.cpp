@@ -32,12 +32,14 @@
 #include <libevmasm/RuleList.h>
 #include <libsolutil/StringUtils.h>
 
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::yul;
 
-SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
+std::optional<SimplificationRules::Match> SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
 	std::function<AssignedValue const*(YulName)> const& _ssaValues
@@ -45,28 +47,59 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 {
 	auto instruction = instructionAndArguments(_dialect, _expr);
 	if (!instruction)
-		return nullptr;
-
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+		return std::nullopt;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
 		version = evmDialect->evmVersion();
 
-	if (!evmRules[version])
-		evmRules[version] = std::make_unique<SimplificationRules>(version);
-
-	SimplificationRules& rules = *evmRules[version];
+	// The rules are shared by all threads. Every thread remembers the ones it used,
+	// so that the lock is only taken once per thread and version.
+	thread_local std::map<std::optional<EVMVersion>, SimplificationRules const*> usedRules;
+	SimplificationRules const*& rulesForVersion = usedRules[version];
+	if (!rulesForVersion)
+	{
+		static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules const>> evmRules;
+		static std::mutex mutex;
+		std::lock_guard lock(mutex);
+		if (!evmRules[version])
+			evmRules[version] = std::make_unique<SimplificationRules const>(version);
+		rulesForVersion = evmRules[version].get();
+	}
+	SimplificationRules const& rules = *rulesForVersion;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	DecisionTable const& table = rules.m_decisionTables[uint8_t(instruction->first)];
+	if (table.candidates.empty())
+		return std::nullopt;
+
+	std::vector<Expression> const& arguments = *instruction->second;
+	assertThrow(arguments.size() == table.arguments.size(), OptimizerException, "");
+	size_t index = 0;
+	for (size_t i = 0; i < arguments.size(); ++i)
 	{
-		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		// Patterns never match arguments that are function calls, see Pattern::matches.
+		if (std::holds_alternative<FunctionCall>(arguments[i]))
+			return std::nullopt;
+		index = index * table.arguments[i].size() + table.arguments[i].classOf(arguments[i], _dialect, _ssaValues);
 	}
-	return nullptr;
+
+	for (Rule const* rule: table.candidates[index])
+	{
+		MatchGroups matchGroups;
+		if (rule->pattern.matches(_expr, _dialect, _ssaValues, matchGroups))
+			if (!rule->feasible || rule->feasible(matchGroups))
+				return Match{rule, std::move(matchGroups)};
+	}
+	return std::nullopt;
+}
+
+Expression SimplificationRules::Match::replacement(
+	langutil::DebugData::ConstPtr const& _debugData,
+	langutil::EVMVersion _evmVersion
+) const
+{
+	return rule->action(matchGroups).toExpression(matchGroups, _debugData, _evmVersion);
 }
 
 bool SimplificationRules::isInitialized() const
@@ -97,6 +130,103 @@ void SimplificationRules::addRule(Rule const& _rule)
 	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
 }
 
+SimplificationRules::DecisionTable SimplificationRules::buildDecisionTable(std::vector<Rule> const& _rules)
+{
+	DecisionTable table;
+	if (_rules.empty())
+		return table;
+
+	std::vector<std::vector<Pattern>> ruleArguments;
+	for (Rule const& rule: _rules)
+		ruleArguments.emplace_back(rule.pattern.arguments());
+
+	table.arguments.resize(ruleArguments.front().size());
+	size_t tableSize = 1;
+	for (size_t i = 0; i < table.arguments.size(); ++i)
+	{
+		ArgumentClasses& classes = table.arguments[i];
+		for (std::vector<Pattern> const& arguments: ruleArguments)
+		{
+			assertThrow(arguments.size() == table.arguments.size(), OptimizerException, "");
+			Pattern const& argument = arguments[i];
+			if (argument.kind() == PatternKind::Constant && argument.constantValue())
+				classes.constants.emplace(*argument.constantValue(), 0);
+			else if (argument.kind() == PatternKind::Operation)
+				classes.instructions.emplace(argument.instruction(), 0);
+		}
+		size_t nextClass = 2;
+		for (auto& [value, valueClass]: classes.constants)
+			valueClass = nextClass++;
+		for (auto& [instruction, instructionClass]: classes.instructions)
+			instructionClass = nextClass++;
+		tableSize *= classes.size();
+	}
+
+	table.candidates.resize(tableSize);
+	for (size_t index = 0; index < tableSize; ++index)
+	{
+		std::vector<size_t> argumentClasses(table.arguments.size());
+		size_t remainder = index;
+		for (size_t i = table.arguments.size(); i-- > 0;)
+		{
+			argumentClasses[i] = remainder % table.arguments[i].size();
+			remainder /= table.arguments[i].size();
+		}
+
+		for (size_t ruleIndex = 0; ruleIndex < _rules.size(); ++ruleIndex)
+		{
+			bool candidate = true;
+			for (size_t i = 0; i < table.arguments.size() && candidate; ++i)
+				candidate = table.arguments[i].matches(ruleArguments[ruleIndex][i], argumentClasses[i]);
+			if (candidate)
+				table.candidates[index].push_back(&_rules[ruleIndex]);
+		}
+	}
+	return table;
+}
+
+size_t SimplificationRules::ArgumentClasses::classOf(
+	Expression const& _argument,
+	Dialect const& _dialect,
+	std::function<AssignedValue const*(YulName)> const& _ssaValues
+) const
+{
+	// Resolve the variable like Pattern::matches does for patterns that are not "Any".
+	Expression const* value = &_argument;
+	if (Identifier const* identifier = std::get_if<Identifier>(&_argument))
+		if (AssignedValue const* assignedValue = _ssaValues(identifier->name))
+			if (assignedValue->value)
+				value = assignedValue->value;
+
+	if (Literal const* literal = std::get_if<Literal>(value))
+	{
+		if (literal->kind != LiteralKind::Number)
+			return 0;
+		auto it = constants.find(literal->value.value());
+		return it == constants.end() ? 1 : it->second;
+	}
+	if (auto instructionAndArguments = SimplificationRules::instructionAndArguments(_dialect, *value))
+		if (auto it = instructions.find(instructionAndArguments->first); it != instructions.end())
+			return it->second;
+	return 0;
+}
+
+bool SimplificationRules::ArgumentClasses::matches(Pattern const& _pattern, size_t _class) const
+{
+	switch (_pattern.kind())
+	{
+	case PatternKind::Any:
+		return true;
+	case PatternKind::Constant:
+		if (_pattern.constantValue())
+			return _class == constants.at(*_pattern.constantValue());
+		return _class >= 1 && _class < 2 + constants.size();
+	case PatternKind::Operation:
+		return _class == instructions.at(_pattern.instruction());
+	}
+	util::unreachable();
+}
+
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
 {
 	// Multiple occurrences of one of these inside one rule must match the same equivalence class.
@@ -109,16 +239,19 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
+
+	for (size_t instruction = 0; instruction < 256; ++instruction)
+		m_decisionTables[instruction] = buildDecisionTable(m_rules[instruction]);
 }
 
 yul::Pattern::Pattern(evmasm::Instruction _instruction, std::initializer_list<Pattern> _arguments):
@@ -128,16 +261,11 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, std::initializer_list<Pa
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups)
-{
-	m_matchGroup = _group;
-	m_matchGroups = &_matchGroups;
-}
-
 bool Pattern::matches(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	std::function<AssignedValue const*(YulName)> const& _ssaValues
+	std::function<AssignedValue const*(YulName)> const& _ssaValues,
+	MatchGroups& _matchGroups
 ) const
 {
 	Expression const* expr = &_expr;
@@ -178,7 +306,7 @@ bool Pattern::matches(
 			// arbitrarily modifying the code.
 			if (
 				std::holds_alternative<FunctionCall>(arg) ||
-				!m_arguments[i].matches(arg, _dialect, _ssaValues)
+				!m_arguments[i].matches(arg, _dialect, _ssaValues, _matchGroups)
 			)
 				return false;
 		}
@@ -202,10 +330,10 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if (_matchGroups.count(m_matchGroup))
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
+			Expression const* firstMatch = _matchGroups[m_matchGroup];
 			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
 			assertThrow(
 				!std::holds_alternative<FunctionCall>(_expr) &&
@@ -217,12 +345,12 @@ bool Pattern::matches(
 			return SyntacticallyEqual{}(*firstMatch, _expr);
 		}
 		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
+			_matchGroups[m_matchGroup] = &_expr;
 		else
 		{
 			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
 			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			_matchGroups[m_matchGroup] = expr;
 		}
 	}
 	return true;
@@ -234,10 +362,14 @@ evmasm::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
-Expression Pattern::toExpression(langutil::DebugData::ConstPtr const& _debugData, langutil::EVMVersion _evmVersion) const
+Expression Pattern::toExpression(
+	MatchGroups const& _matchGroups,
+	langutil::DebugData::ConstPtr const& _debugData,
+	langutil::EVMVersion _evmVersion
+) const
 {
 	if (matchGroup())
-		return ASTCopier().translate(matchGroupValue());
+		return ASTCopier().translate(matchGroupValue(_matchGroups));
 	if (m_kind == PatternKind::Constant)
 	{
 		assertThrow(m_data, OptimizerException, "No match group and no constant value given.");
@@ -247,7 +379,7 @@ Expression Pattern::toExpression(langutil::DebugData::ConstPtr const& _debugData
 	{
 		std::vector<Expression> arguments;
 		for (auto const& arg: m_arguments)
-			arguments.emplace_back(arg.toExpression(_debugData, _evmVersion));
+			arguments.emplace_back(arg.toExpression(_matchGroups, _debugData, _evmVersion));
 
 		std::string name = util::toLower(instructionInfo(m_instruction, _evmVersion).name);
 
@@ -259,15 +391,15 @@ Expression Pattern::toExpression(langutil::DebugData::ConstPtr const& _debugData
 	assertThrow(false, OptimizerException, "Pattern of kind 'any', but no match group.");
 }
 
-u256 Pattern::d() const
+u256 Pattern::d(MatchGroups const& _matchGroups) const
 {
-	return std::get<Literal>(matchGroupValue()).value.value();
+	return std::get<Literal>(matchGroupValue(_matchGroups)).value.value();
 }
 
-Expression const& Pattern::matchGroupValue() const
+Expression const& Pattern::matchGroupValue(MatchGroups const& _matchGroups) const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	auto it = _matchGroups.find(m_matchGroup);
+	assertThrow(it != _matchGroups.end() && it->second, OptimizerException, "");
+	return *it->second;
 }
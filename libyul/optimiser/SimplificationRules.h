@@ -33,6 +33,7 @@
 #include <liblangutil/DebugData.h>
 
 #include <functional>
+#include <map>
 #include <optional>
 #include <vector>
 
@@ -44,6 +45,9 @@ class Pattern;
 
 using DebugData = langutil::DebugData;
 
+/// Expressions bound to the match groups of a rule by matching it, indexed by match group.
+using MatchGroups = std::map<unsigned, Expression const*>;
+
 /**
  * Container for all simplification rules.
  */
@@ -58,10 +62,20 @@ public:
 
 	explicit SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion = std::nullopt);
 
-	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// Rule that matched an expression, together with the expressions bound to its match groups.
+	struct Match
+	{
+		Rule const* rule = nullptr;
+		MatchGroups matchGroups;
+
+		/// @returns the expression the matched one is replaced with, as given by the action of the rule.
+		Expression replacement(langutil::DebugData::ConstPtr const& _debugData, langutil::EVMVersion _evmVersion) const;
+	};
+
+	/// @returns the first matching rule and the expressions bound to its match groups, or nullopt
+	/// if no rule matches. The rules are not modified, so this can be called concurrently.
 	/// @param _ssaValues values of variables that are assigned exactly once.
-	static Rule const* findFirstMatch(
+	static std::optional<Match> findFirstMatch(
 		Expression const& _expr,
 		Dialect const& _dialect,
 		std::function<AssignedValue const*(YulName)> const& _ssaValues
@@ -75,13 +89,40 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
+	/// Partitions the expressions at one argument position of an instruction into the classes
+	/// the top-level argument patterns of its rules can distinguish: class 0 contains the
+	/// expressions only "Any" patterns match, class 1 the number literals that do not have one
+	/// of the listed values, followed by one class for every listed value and instruction.
+	struct ArgumentClasses
+	{
+		std::map<u256, size_t> constants;
+		std::map<evmasm::Instruction, size_t> instructions;
+
+		size_t size() const { return 2 + constants.size() + instructions.size(); }
+		size_t classOf(
+			Expression const& _argument,
+			Dialect const& _dialect,
+			std::function<AssignedValue const*(YulName)> const& _ssaValues
+		) const;
+		bool matches(Pattern const& _pattern, size_t _class) const;
+	};
+
+	/// Decision table for the rules of one instruction. Only the rules listed for the
+	/// classes of the actual arguments have to be tried.
+	struct DecisionTable
+	{
+		std::vector<ArgumentClasses> arguments;
+		/// Candidate rules in their original order, for every combination of argument classes,
+		/// indexed with the class of the first argument being the most significant digit.
+		std::vector<std::vector<Rule const*>> candidates;
+	};
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
+	static DecisionTable buildDecisionTable(std::vector<Rule> const& _rules);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
-
-	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	DecisionTable m_decisionTables[256];
 };
 
 enum class PatternKind
@@ -93,13 +134,14 @@ enum class PatternKind
 
 /**
  * Pattern to match against an expression.
- * Also stores matched expressions to retrieve them later, for constructing new expressions using
- * ExpressionTemplate.
+ * Matching binds the expressions matched by the match groups, which are used to retrieve them
+ * later, for constructing new expressions.
  */
 class Pattern
 {
 public:
 	using Builtins = evmasm::EVMBuiltins<Pattern>;
+	using MatchGroups = yul::MatchGroups;
 	static constexpr size_t WordSize = 256;
 	using Word = u256;
 
@@ -116,34 +158,43 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group) { m_matchGroup = _group; }
 	unsigned matchGroup() const { return m_matchGroup; }
+	PatternKind kind() const { return m_kind; }
+	/// @returns the value matched by a constant pattern, or nullptr if it matches any constant.
+	u256 const* constantValue() const { return m_data.get(); }
+	/// @returns true if the pattern matches @a _expr and, in that case, binds the expressions
+	/// matched by its match groups in @a _matchGroups.
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::function<AssignedValue const*(YulName)> const& _ssaValues
+		std::function<AssignedValue const*(YulName)> const& _ssaValues,
+		MatchGroups& _matchGroups
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 d() const;
+	u256 d(MatchGroups const& _matchGroups) const;
 
 	evmasm::Instruction instruction() const;
 
 	/// Turns this pattern into an actual expression. Should only be called
-	/// for patterns resulting from an action, i.e. with match groups assigned.
-	Expression toExpression(langutil::DebugData::ConstPtr const& _debugData, langutil::EVMVersion _evmVersion) const;
+	/// for patterns resulting from an action, with the match groups bound by the match.
+	Expression toExpression(
+		MatchGroups const& _matchGroups,
+		langutil::DebugData::ConstPtr const& _debugData,
+		langutil::EVMVersion _evmVersion
+	) const;
 
 private:
-	Expression const& matchGroupValue() const;
+	Expression const& matchGroupValue(MatchGroups const& _matchGroups) const;
 
 	PatternKind m_kind = PatternKind::Any;
 	evmasm::Instruction m_instruction; ///< Only valid if m_kind is Operation
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
 }
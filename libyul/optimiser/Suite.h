@@ -27,6 +27,8 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/StepProfile.h>
+
 #include <set>
 #include <string>
 #include <string_view>
@@ -59,9 +61,13 @@ public:
 		PrintStep,
 		PrintChanges
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
+	/// @param _profile if not null, the execution statistics of every step are recorded in it.
+	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None, util::StepProfile* _profile = nullptr):
+		m_context(_context), m_debug(_debug), m_profile(_profile)
+	{}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If `_profile` is not null, the execution statistics of all steps are recorded in it.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +76,8 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulName> const& _externallyUsedIdentifiers = {}
+		std::set<YulName> const& _externallyUsedIdentifiers = {},
+		util::StepProfile* _profile = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -91,9 +98,7 @@ public:
 private:
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	util::StepProfile* m_profile = nullptr;
 };
 
 }
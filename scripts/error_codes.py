@@ -205,6 +205,9 @@ def examine_id_coverage(top_dir, source_id_to_file_names, new_ids_only=False):
         "7053", # Unimplemented feature error (parsing stage), currently has no tests
         "2339", # SMTChecker, covered by CL tests
         "6240", # SMTChecker, covered by CL tests
+        "5021", # SMTChecker, solving times are not deterministic
+        "7048", # SMTChecker, solving times are not deterministic
+        "3154", # SMTChecker, requires a solver invoked as an external program
     }
     assert len(test_ids & white_ids) == 0, "The sets are not supposed to intersect"
     test_ids |= white_ids
@@ -42,6 +42,7 @@
 #include <libsolidity/lsp/Transport.h>
 
 #include <libyul/YulStack.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Disassemble.h>
 
@@ -154,7 +155,8 @@ static bool needsHumanTargetedStdout(CommandLineOptions const& _options)
 		_options.compiler.outputs.natspecDev ||
 		_options.compiler.outputs.opcodes ||
 		_options.compiler.outputs.signatureHashes ||
-		_options.compiler.outputs.storageLayout;
+		_options.compiler.outputs.storageLayout ||
+		_options.compiler.outputs.optimizerProfile;
 }
 
 static bool coloredOutput(CommandLineOptions const& _options)
@@ -420,6 +422,20 @@ void CommandLineInterface::handleStorageLayout(std::string const& _contract)
 		sout() << "Contract Storage Layout:" << std::endl << data << std::endl;
 }
 
+void CommandLineInterface::handleOptimizerProfile(std::string const& _contract)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.outputs.optimizerProfile)
+		return;
+
+	std::string data = jsonPrint(m_compiler->optimiserProfile(_contract), m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_optimizer_profile.json", data);
+	else
+		sout() << "Optimizer Profile:" << std::endl << data << std::endl;
+}
+
 void CommandLineInterface::handleNatspec(bool _natspecDev, std::string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -732,6 +748,9 @@ bool CommandLineInterface::parseArguments(int _argc, char const* const* _argv)
 
 void CommandLineInterface::processInput()
 {
+	// Outputs are produced within this function, so the Yul strings are not needed afterwards.
+	yul::YulStringRepository::CompilationScope yulStringScope;
+
 	if (m_options.output.evmVersion < EVMVersion::constantinople())
 		report(
 			Error::Severity::Warning,
@@ -754,6 +773,10 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+		if (!m_options.output.cacheDir.empty())
+			compiler.setCacheDirectory(m_options.output.cacheDir.string());
+		if (m_options.modelChecker.settings.cacheDirectory)
+			compiler.setModelCheckerCacheDirectory(*m_options.modelChecker.settings.cacheDirectory);
 		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
 		m_standardJsonInput.reset();
 		break;
@@ -844,6 +867,7 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.jobs);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -856,8 +880,10 @@ void CommandLineInterface::compile()
 			m_options.compiler.outputs.irAstJson ||
 			m_options.compiler.outputs.irOptimizedAstJson
 		);
+		m_compiler->enableOptimiserProfiling(m_options.compiler.outputs.optimizerProfile);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
+			m_options.compiler.outputs.optimizerProfile ||
 			m_options.compiler.outputs.asm_ ||
 			m_options.compiler.outputs.asmJson ||
 			m_options.compiler.outputs.opcodes ||
@@ -1299,6 +1325,7 @@ void CommandLineInterface::outputCompilationResults()
 			handleMetadata(contract);
 			handleABI(contract);
 			handleStorageLayout(contract);
+			handleOptimizerProfile(contract);
 			handleNatspec(true, contract);
 			handleNatspec(false, contract);
 		} // end of contracts iteration
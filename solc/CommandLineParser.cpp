@@ -50,6 +50,7 @@ static std::string const g_strEVMVersion = "evm-version";
 static std::string const g_strEOFVersion = "experimental-eof-version";
 static std::string const g_strViaIR = "via-ir";
 static std::string const g_strExperimentalViaIR = "experimental-via-ir";
+static std::string const g_strJobs = "jobs";
 static std::string const g_strGas = "gas";
 static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
@@ -74,11 +75,15 @@ static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static std::string const g_strModelCheckerInvariants = "model-checker-invariants";
 static std::string const g_strModelCheckerPrintQuery = "model-checker-print-query";
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
+static std::string const g_strModelCheckerShowTimings = "model-checker-show-timings";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static std::string const g_strModelCheckerShowUnsupported = "model-checker-show-unsupported";
 static std::string const g_strModelCheckerSolvers = "model-checker-solvers";
 static std::string const g_strModelCheckerTargets = "model-checker-targets";
 static std::string const g_strModelCheckerTimeout = "model-checker-timeout";
+static std::string const g_strModelCheckerVerifyAgreement = "model-checker-verify-agreement";
+static std::string const g_strModelCheckerPersistentSolvers = "model-checker-persistent-solvers";
+static std::string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static std::string const g_strModelCheckerBMCLoopIterations = "model-checker-bmc-loop-iterations";
 static std::string const g_strNone = "none";
 static std::string const g_strNoOptimizeYul = "no-optimize-yul";
@@ -89,6 +94,7 @@ static std::string const g_strOptimizeYul = "optimize-yul";
 static std::string const g_strYulOptimizations = "yul-optimizations";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
+static std::string const g_strCacheDir = "cache-dir";
 static std::string const g_strRevertStrings = "revert-strings";
 static std::string const g_strStopAfter = "stop-after";
 static std::string const g_strParsing = "parsing";
@@ -233,8 +239,10 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.noImportCallback == _other.input.noImportCallback &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
+		output.cacheDir == _other.output.cacheDir &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.jobs == _other.output.jobs &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -601,6 +609,12 @@ General Information)").c_str(),
 			g_strOverwrite.c_str(),
 			"Overwrite existing files (used together with -o)."
 		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Directory used to cache the output of contracts between compiler invocations "
+			"(used together with --standard-json)."
+		)
 		(
 			g_strEVMVersion.c_str(),
 			po::value<std::string>()->value_name("version")->default_value(EVMVersion{}.name()),
@@ -627,6 +641,14 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Maximal number of threads used to parse sources, to optimize and assemble contracts "
+			"in parallel and to solve the SMT-LIB2 queries of the SMTChecker concurrently. "
+			"Contracts are only optimized and assembled in parallel when compiling via the IR. "
+			"The output does not depend on this setting."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -760,6 +782,7 @@ General Information)").c_str(),
 		(CompilerOutputs::componentName(&CompilerOutputs::natspecDev).c_str(), "Natspec developer documentation of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::metadata).c_str(), "Combined Metadata JSON whose IPFS hash is stored on-chain.")
 		(CompilerOutputs::componentName(&CompilerOutputs::storageLayout).c_str(), "Slots, offsets and types of the contract's state variables.")
+		(CompilerOutputs::componentName(&CompilerOutputs::optimizerProfile).c_str(), "Time spent in, number of invocations and code size change of each optimizer step, per contract.")
 	;
 	desc.add(outputComponents);
 
@@ -867,6 +890,10 @@ General Information)").c_str(),
 			g_strModelCheckerShowProvedSafe.c_str(),
 			"Show all targets that were proved safe separately."
 		)
+		(
+			g_strModelCheckerShowTimings.c_str(),
+			"Show how long solving took for every verification target."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
@@ -894,6 +921,23 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit."
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerVerifyAgreement.c_str(),
+			"Wait for the answers of all BMC solvers and warn if they disagree."
+			" By default the first definitive answer is used."
+		)
+		(
+			g_strModelCheckerPersistentSolvers.c_str(),
+			"Keep cvc5 running between BMC queries and send the queries incrementally"
+			" instead of starting it for every query."
+		)
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Cache the results of the SMT solvers that are invoked as external programs (cvc5, Eldarica) in the given"
+			" directory and reuse them in later runs. Results are not reused after the solver version or the timeout changed."
+			" Queries answered by z3 via its library are not cached."
+		)
 		(
 			g_strModelCheckerBMCLoopIterations.c_str(),
 			po::value<unsigned>(),
@@ -992,6 +1036,8 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::StandardJson}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1001,10 +1047,14 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerPrintQuery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerShowTimings, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnsupported, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerVerifyAgreement, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerPersistentSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
@@ -1130,6 +1180,23 @@ void CommandLineParser::processArgs()
 
 	m_options.output.overwriteFiles = (m_args.count(g_strOverwrite) > 0);
 
+	if (m_args.count(g_strCacheDir))
+	{
+		std::string cacheDir = m_args.at(g_strCacheDir).as<std::string>();
+		if (cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty path given to --" + g_strCacheDir + ".");
+		m_options.output.cacheDir = cacheDir;
+	}
+
+	// Also used in Standard JSON mode, where the input cannot set the directory.
+	if (m_args.count(g_strModelCheckerCacheDir))
+	{
+		std::string cacheDir = m_args[g_strModelCheckerCacheDir].as<std::string>();
+		if (cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty path given to --" + g_strModelCheckerCacheDir + ".");
+		m_options.modelChecker.settings.cacheDirectory = cacheDir;
+	}
+
 	if (m_args.count(g_strPrettyJson) > 0)
 	{
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
@@ -1378,6 +1445,9 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerShowProvedSafe))
 		m_options.modelChecker.settings.showProvedSafe = true;
 
+	if (m_args.count(g_strModelCheckerShowTimings))
+		m_options.modelChecker.settings.showTimings = true;
+
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
@@ -1412,6 +1482,12 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_strModelCheckerVerifyAgreement))
+		m_options.modelChecker.settings.verifyAgreement = true;
+
+	if (m_args.count(g_strModelCheckerPersistentSolvers))
+		m_options.modelChecker.settings.persistentSolvers = true;
+
 	if (m_args.count(g_strModelCheckerBMCLoopIterations))
 	{
 		if (!m_options.modelChecker.settings.engine.bmc)
@@ -1427,13 +1503,24 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
+		m_args.count(g_strModelCheckerShowTimings) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
-		m_args.count(g_strModelCheckerTimeout);
+		m_args.count(g_strModelCheckerTimeout) ||
+		m_args.count(g_strModelCheckerVerifyAgreement) ||
+		m_args.count(g_strModelCheckerPersistentSolvers) ||
+		m_args.count(g_strModelCheckerCacheDir);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	if (m_args.count(g_strJobs))
+	{
+		m_options.output.jobs = m_args[g_strJobs].as<unsigned>();
+		if (m_options.output.jobs == 0)
+			solThrow(CommandLineValidationError, "Invalid option for --" + g_strJobs + ": the number of jobs must be positive.");
+	}
+
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
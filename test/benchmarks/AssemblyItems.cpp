@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measures the size of evmasm::AssemblyItem and the time it takes to create, copy and compare
+ * many items. Only uses the part of the interface that did not change with the compact item
+ * layout, so that assembly-items.sh can build it against different source trees.
+ */
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns a mix of items similar to that of optimised assembly: mostly operations and pushes
+/// of small constants, some tags and a few large constants such as function selector masks.
+std::vector<AssemblyItem> createItems(size_t _count)
+{
+	static Instruction const instructions[] = {
+		Instruction::ADD, Instruction::MUL, Instruction::DUP1, Instruction::SWAP1, Instruction::POP,
+		Instruction::MLOAD, Instruction::MSTORE, Instruction::JUMP, Instruction::JUMPI, Instruction::CALLDATALOAD
+	};
+
+	std::vector<AssemblyItem> items;
+	items.reserve(_count);
+	for (size_t i = 0; i < _count; ++i)
+		switch (i % 20)
+		{
+		case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8: case 9:
+			items.emplace_back(instructions[(i / 20 + i) % 10]);
+			break;
+		case 10: case 11: case 12: case 13: case 14:
+			items.emplace_back(u256(i % 1024));
+			break;
+		case 15:
+			items.emplace_back(PushTag, u256(i / 20));
+			break;
+		case 16:
+			items.emplace_back(Tag, u256(i / 20));
+			break;
+		default:
+			items.emplace_back((u256(1) << 255) | u256(i));
+			break;
+		}
+	return items;
+}
+
+template <typename Function>
+double measureMilliseconds(Function&& _function)
+{
+	auto const start = std::chrono::steady_clock::now();
+	_function();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	size_t const count = argc > 1 ? std::stoul(argv[1]) : 2000000;
+	size_t const rounds = argc > 2 ? std::stoul(argv[2]) : 10;
+
+	std::vector<AssemblyItem> items;
+	double const creation = measureMilliseconds([&]() { items = createItems(count); });
+
+	// Copying and comparing neighbours is what the peephole optimiser, the common subexpression
+	// eliminator and the block deduplicator do most with the items.
+	size_t checksum = 0;
+	double const copyAndCompare = measureMilliseconds([&]() {
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			std::vector<AssemblyItem> copy = items;
+			for (size_t i = 1; i < copy.size(); ++i)
+				checksum += (copy[i] == copy[i - 1]) + (copy[i] < copy[i - 1]);
+		}
+	});
+
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+
+	std::cout << "sizeof(AssemblyItem): " << sizeof(AssemblyItem) << " bytes" << std::endl;
+	std::cout << "Creating " << count << " items: " << creation << " ms" << std::endl;
+	std::cout << rounds << " rounds of copying and comparing: " << copyAndCompare << " ms" << std::endl;
+	// ru_maxrss is in kilobytes on Linux, but in bytes on macOS.
+	std::cout << "Maximum resident set size: " << usage.ru_maxrss << std::endl;
+	std::cout << "Checksum: " << checksum << std::endl;
+	return EXIT_SUCCESS;
+}
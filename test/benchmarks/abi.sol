@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+// Contract with a large external interface using many different ABI types.
+// Most of the generated code consists of ABI encoding and decoding functions,
+// which makes it a good benchmark for IR generation.
+contract ABIHeavy {
+    enum Status { Pending, Active, Closed }
+
+    struct Point {
+        int64 x;
+        int64 y;
+    }
+
+    struct Order {
+        address owner;
+        uint128 amount;
+        bytes32 id;
+        Status status;
+        Point[] path;
+        string note;
+    }
+
+    struct Batch {
+        Order[][] orders;
+        bytes[] payloads;
+        uint16[3][] triples;
+        bool[] flags;
+    }
+
+    event OrderPlaced(address indexed owner, Order order, Point[2] bounds);
+    event BatchProcessed(bytes32 indexed id, Batch batch, string[] tags);
+    error InvalidOrder(Order order, string reason);
+
+    bytes32[] public orderIds;
+    mapping(bytes32 => Point[]) public paths;
+    bytes[] public payloads;
+    string[] public tags;
+
+    function placeOrder(Order memory _order, Point[2] memory _bounds) public returns (uint) {
+        if (_order.amount == 0)
+            revert InvalidOrder(_order, "zero amount");
+        orderIds.push(_order.id);
+        for (uint i = 0; i < _order.path.length; ++i)
+            paths[_order.id].push(_order.path[i]);
+        emit OrderPlaced(_order.owner, _order, _bounds);
+        return orderIds.length;
+    }
+
+    function placeOrders(Order[] memory _orders) public returns (Order[] memory) {
+        Point[2] memory bounds;
+        for (uint i = 0; i < _orders.length; ++i)
+            placeOrder(_orders[i], bounds);
+        return _orders;
+    }
+
+    function processBatch(Batch memory _batch, string[] memory _tags) public returns (bytes32 id) {
+        id = keccak256(abi.encode(_batch));
+        for (uint i = 0; i < _batch.payloads.length; ++i)
+            payloads.push(_batch.payloads[i]);
+        for (uint i = 0; i < _tags.length; ++i)
+            tags.push(_tags[i]);
+        emit BatchProcessed(id, _batch, _tags);
+    }
+
+    function roundTrip(Batch memory _batch) public pure returns (Batch memory, bytes memory) {
+        return (_batch, abi.encode(_batch));
+    }
+
+    function setPath(bytes32 _id, Point[] calldata _path) external {
+        delete paths[_id];
+        for (uint i = 0; i < _path.length; ++i)
+            paths[_id].push(_path[i]);
+    }
+
+    function getPath(bytes32 _id) external view returns (Point[] memory) {
+        return paths[_id];
+    }
+
+    function getPayloads() external view returns (bytes[] memory, string[] memory) {
+        return (payloads, tags);
+    }
+
+    function encodeOrders(Order[] memory _orders) public pure returns (bytes memory) {
+        return abi.encode(_orders, _orders.length);
+    }
+
+    function decodeOrders(bytes memory _data) public pure returns (Order[] memory decoded, uint length) {
+        (decoded, length) = abi.decode(_data, (Order[], uint));
+    }
+
+    function decodeBatch(bytes calldata _data) external pure returns (Batch memory batch, string[] memory batchTags) {
+        (batch, batchTags) = abi.decode(_data, (Batch, string[]));
+    }
+
+    function encodePacked(
+        uint8 _a,
+        int24 _b,
+        bytes7 _c,
+        address _d,
+        string memory _e,
+        bytes memory _f,
+        uint[] memory _g
+    ) public pure returns (bytes memory) {
+        return abi.encodePacked(_a, _b, _c, _d, _e, _f, _g);
+    }
+
+    function encodeWithSelector(Point[] memory _points, Status _status) public view returns (bytes memory) {
+        return abi.encodeWithSelector(this.setPath.selector, bytes32(uint(_status)), _points);
+    }
+
+    function encodeCall(Order memory _order, Point[2] memory _bounds) public view returns (bytes memory) {
+        return abi.encodeCall(this.placeOrder, (_order, _bounds));
+    }
+
+    function nested(
+        uint[][] memory _a,
+        bytes32[2][] memory _b,
+        string[][2] memory _c,
+        Point[][] memory _d
+    ) public pure returns (uint[][] memory, bytes32[2][] memory, string[][2] memory, Point[][] memory) {
+        return (_a, _b, _c, _d);
+    }
+
+    function scalars(
+        uint8 a, uint16 b, uint24 c, uint32 d, uint40 e, uint48 f, uint56 g,
+        int8 h, int16 i, int32 j, int64 k, int128 l, int256 m
+    ) external pure returns (bytes memory) {
+        return abi.encode(a, b, c, d, e, f, g, h, i, j, k, l, m);
+    }
+
+    function fixedBytes(
+        bytes1 a, bytes2 b, bytes3 c, bytes4 d, bytes8 e, bytes16 f, bytes20 g, bytes31 h, bytes32 i
+    ) external pure returns (bytes memory) {
+        return abi.encode(a, b, c, d, e, f, g, h, i);
+    }
+
+    function functionPointer(function (uint) external returns (uint) _f) external pure returns (bytes memory) {
+        return abi.encode(_f);
+    }
+}
+
+contract ABIHeavyFactory {
+    event Created(ABIHeavy instance, ABIHeavy.Order[] initialOrders);
+
+    function create(ABIHeavy.Order[] memory _orders) public returns (ABIHeavy instance) {
+        instance = new ABIHeavy();
+        instance.placeOrders(_orders);
+        emit Created(instance, _orders);
+    }
+
+    function forward(ABIHeavy _target, ABIHeavy.Batch memory _batch, string[] memory _tags) public returns (bytes32) {
+        return _target.processBatch(_batch, _tags);
+    }
+}
@@ -0,0 +1,70 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script comparing the layout of evmasm::AssemblyItem in different source trees.
+#
+# Builds AssemblyItems.cpp against the libevmasm headers of every given source tree
+# (the current one by default) and runs it. To compare two versions, pass e.g. the
+# current tree and a worktree of the other version:
+#
+#     git worktree add /tmp/solidity-before <commit>
+#     test/benchmarks/assembly-items.sh /tmp/solidity-before .
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2026 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -euo pipefail
+
+REPO_ROOT=$(cd "$(dirname "$0")/../../" && pwd)
+CXX=${CXX:-c++}
+ITEM_COUNT=${ITEM_COUNT:-2000000}
+ROUNDS=${ROUNDS:-10}
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+command_available "$CXX" --version
+
+source_dirs=("$@")
+(( ${#source_dirs[@]} > 0 )) || source_dirs=("$REPO_ROOT")
+
+output_dir=$(mktemp -d -t solc-assembly-items-XXXXXX)
+
+function cleanup() {
+    rm -r "${output_dir}"
+    exit
+}
+
+trap cleanup SIGINT SIGTERM
+
+for source_dir in "${source_dirs[@]}"
+do
+    [[ -f "${source_dir}/libevmasm/AssemblyItem.h" ]] || fail "Not a source tree: ${source_dir}"
+
+    "$CXX" -std=c++20 -O2 -DNDEBUG \
+        -I"${source_dir}" \
+        "${REPO_ROOT}/test/benchmarks/AssemblyItems.cpp" \
+        "${source_dir}/libsolutil/Exceptions.cpp" \
+        -o "${output_dir}/assembly-items"
+
+    echo "${source_dir} ($(git -C "${source_dir}" rev-parse --short HEAD 2> /dev/null || echo "not a git repository")):"
+    "${output_dir}/assembly-items" "$ITEM_COUNT" "$ROUNDS"
+    echo
+done
+
+cleanup
@@ -35,6 +35,7 @@ source "${REPO_ROOT}/scripts/common_cmdline.sh"
 
 solc="${1:-${SOLIDITY_BUILD_DIR}/solc/solc}"
 command_available "$solc" --version
+command_available jq --version
 
 output_dir=$(mktemp -d -t solc-benchmark-XXXXXX)
 
@@ -67,7 +68,79 @@ function benchmark_contract {
         "$(< "${output_dir}/time-and-status-${pipeline}.txt")"
 }
 
-benchmarks=("verifier.sol" "OptimizorClub.sol" "chains.sol")
+function benchmark_ir_generation {
+    local input_path="$1"
+
+    # Only requesting the unoptimized IR skips both the Yul optimizer and bytecode generation.
+    "$time_bin_path" \
+        --output "${output_dir}/time-and-status-ir.txt" --quiet --format '%e s |         %x' \
+        "${solc}" --ir "${input_path}" \
+        > /dev/null \
+        2>> "${output_dir}/benchmark-warn-err.txt"
+
+    printf '| %-20s | %20s |\n' \
+        '`'"$input_file"'`' \
+        "$(< "${output_dir}/time-and-status-ir.txt")"
+}
+
+function benchmark_ast_import {
+    local input_path="$1"
+    local ast_path="${output_dir}/ast-${input_file%.sol}.json"
+
+    "${solc}" --combined-json ast "${input_path}" > "${ast_path}" 2>> "${output_dir}/benchmark-warn-err.txt"
+
+    # Both runs analyze the sources and export the AST again, so they only differ in
+    # whether the AST is parsed from the Solidity sources or imported from its JSON.
+    "$time_bin_path" \
+        --output "${output_dir}/time-and-status-source.txt" --quiet --format '%e s |         %x' \
+        "${solc}" --combined-json ast "${input_path}" \
+        > /dev/null \
+        2>> "${output_dir}/benchmark-warn-err.txt"
+    "$time_bin_path" \
+        --output "${output_dir}/time-and-status-import.txt" --quiet --format '%e s |         %x' \
+        "${solc}" --import-ast --combined-json ast "${ast_path}" \
+        > /dev/null \
+        2>> "${output_dir}/benchmark-warn-err.txt"
+
+    printf '| %-20s | %20s | %20s |\n' \
+        '`'"$input_file"'`' \
+        "$(< "${output_dir}/time-and-status-source.txt")" \
+        "$(< "${output_dir}/time-and-status-import.txt")"
+}
+
+function benchmark_optimizer_steps {
+    local input_path="$1"
+
+    # The optimizer profile reports the time spent in each Yul optimizer step. Only steps based on
+    # the DataFlowAnalyzer are listed, since they spend much of their time joining its knowledge at
+    # control flow joins. The ExpressionSimplifier also spends most of its time matching
+    # simplification rules.
+    jq --null-input --rawfile content "$input_path" '{
+        language: "Solidity",
+        sources: {"input.sol": {content: $content}},
+        settings: {
+            viaIR: true,
+            optimizer: {enabled: true},
+            outputSelection: {"*": {"*": ["optimizerProfile"]}}
+        }
+    }' > "${output_dir}/input-optimizer-steps.json"
+    "${solc}" --standard-json "${output_dir}/input-optimizer-steps.json" \
+        > "${output_dir}/output-optimizer-steps.json" \
+        2>> "${output_dir}/benchmark-warn-err.txt"
+
+    local step
+    for step in ExpressionSimplifier CommonSubexpressionEliminator LoadResolver Rematerialiser EqualStoreEliminator
+    do
+        local profiles="[.contracts[][].optimizerProfile.yul.${step} | select(. != null)]"
+        printf '| %-20s | %-29s | %11d | %10.3f s |\n' \
+            '`'"$input_file"'`' \
+            "$step" \
+            "$(jq "${profiles} | map(.invocations) | add // 0" "${output_dir}/output-optimizer-steps.json")" \
+            "$(jq "${profiles} | map(.durationMicroseconds) | add // 0 | . / 1000000" "${output_dir}/output-optimizer-steps.json")"
+    done
+}
+
+benchmarks=("verifier.sol" "OptimizorClub.sol" "chains.sol" "abi.sol")
 time_bin_path=$(type -P time)
 
 echo "| File                 | Pipeline | Bytecode size | Time     | Exit code |"
@@ -79,6 +152,33 @@ do
     benchmark_contract via-ir "${REPO_ROOT}/test/benchmarks/${input_file}"
 done
 
+echo
+echo "| File                 | IR generation time | Exit code |"
+echo "|----------------------|-------------------:|----------:|"
+
+for input_file in "${benchmarks[@]}"
+do
+    benchmark_ir_generation "${REPO_ROOT}/test/benchmarks/${input_file}"
+done
+
+echo
+echo "| File                 | From source | Exit code | AST import | Exit code |"
+echo "|----------------------|------------:|----------:|-----------:|----------:|"
+
+for input_file in "${benchmarks[@]}"
+do
+    benchmark_ast_import "${REPO_ROOT}/test/benchmarks/${input_file}"
+done
+
+echo
+echo "| File                 | Optimizer step                | Invocations |       Time |"
+echo "|----------------------|-------------------------------|------------:|-----------:|"
+
+for input_file in "${benchmarks[@]}"
+do
+    benchmark_optimizer_steps "${REPO_ROOT}/test/benchmarks/${input_file}"
+done
+
 echo
 echo "======================================================="
 echo "Warnings and errors generated during run:"
@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+SOLTMPDIR=$(mktemp -d -t "cmdline-test-artifact-cache-XXXXXX")
+CACHEDIR="${SOLTMPDIR}/cache"
+
+function standard_json_input
+{
+    local source="$1"
+    echo "{
+        \"language\": \"Solidity\",
+        \"sources\": {\"A.sol\": {\"content\": \"${source}\"}},
+        \"settings\": {\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\", \"abi\"]}}}
+    }"
+}
+
+function compile_with_cache
+{
+    standard_json_input "$1" | msg_on_error --no-stderr "$SOLC" --standard-json --cache-dir "$CACHEDIR"
+}
+
+function strip_cache_statistics
+{
+    sed -E -e 's/,?"cache":\{[^}]*\}//'
+}
+
+source1='contract A { function f() public pure returns (uint) { return 1; } } contract B { A a = new A(); }'
+source2='contract A { function f() public pure returns (uint) { return 2; } } contract B { A a = new A(); }'
+
+# The first run fills the cache.
+output_miss=$(compile_with_cache "$source1")
+[[ $output_miss == *'"cache":{"hits":0,"misses":2}'* ]] || fail "Expected two cache misses: ${output_miss}"
+(( $(find "$CACHEDIR" -name '*.json' | wc -l) == 2 )) || fail "Expected two cache entries in ${CACHEDIR}."
+
+# The second run is served from the cache and its output is the same.
+output_hit=$(compile_with_cache "$source1")
+[[ $output_hit == *'"cache":{"hits":2,"misses":0}'* ]] || fail "Expected two cache hits: ${output_hit}"
+(( $(find "$CACHEDIR" -name '*.json' | wc -l) == 2 )) || fail "Cache hits must not add entries to ${CACHEDIR}."
+diff_values "$(echo "$output_miss" | strip_cache_statistics)" "$(echo "$output_hit" | strip_cache_statistics)"
+
+# Changing the source invalidates the entries of all contracts depending on it.
+output_changed=$(compile_with_cache "$source2")
+[[ $output_changed == *'"cache":{"hits":0,"misses":2}'* ]] || fail "Expected two cache misses after a change: ${output_changed}"
+[[ "$(echo "$output_changed" | strip_cache_statistics)" != "$(echo "$output_miss" | strip_cache_statistics)" ]] || \
+    fail "Output was not updated after the source changed."
+
+rm -r "$SOLTMPDIR"
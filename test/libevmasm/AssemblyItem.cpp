@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the comparison of assembly items whose data is stored inline or shared.
+ */
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <vector>
+
+using namespace solidity::evmasm;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+u256 const maxInline = std::numeric_limits<uint64_t>::max();
+
+}
+
+BOOST_AUTO_TEST_SUITE(AssemblyItemData)
+
+BOOST_AUTO_TEST_CASE(equal_after_switching_representation)
+{
+	for (u256 value: {u256(0), u256(5), maxInline - 1, maxInline})
+	{
+		AssemblyItem inlineItem(PushTag, value);
+		AssemblyItem switched(PushTag, u256(1) << 200);
+		switched.setData(value);
+		BOOST_CHECK(inlineItem == switched);
+		BOOST_CHECK(switched == inlineItem);
+		BOOST_CHECK(!(inlineItem < switched));
+		BOOST_CHECK(!(switched < inlineItem));
+		BOOST_CHECK_EQUAL(switched.data(), value);
+	}
+	for (u256 value: {maxInline + 1, u256(1) << 128, ~u256(0)})
+	{
+		AssemblyItem sharedItem(PushTag, value);
+		AssemblyItem switched(PushTag, 7);
+		switched.setData(value);
+		BOOST_CHECK(sharedItem == switched);
+		BOOST_CHECK(switched == sharedItem);
+		BOOST_CHECK(!(sharedItem < switched));
+		BOOST_CHECK(!(switched < sharedItem));
+		BOOST_CHECK_EQUAL(switched.data(), value);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(equal_foreign_push_tags)
+{
+	AssemblyItem constructed(PushTag, (u256(3) << 64) | 9);
+	AssemblyItem assigned(PushTag, 9);
+	assigned.setPushTagSubIdAndTag(2, 9);
+	BOOST_CHECK(constructed == assigned);
+	BOOST_CHECK(!(constructed < assigned));
+	BOOST_CHECK(!(assigned < constructed));
+	BOOST_CHECK(assigned.splitForeignPushTag() == std::make_pair(size_t(2), size_t(9)));
+
+	assigned.setPushTagSubIdAndTag(std::numeric_limits<size_t>::max(), 9);
+	BOOST_CHECK(assigned == AssemblyItem(PushTag, 9));
+	BOOST_CHECK(assigned != constructed);
+	BOOST_CHECK(assigned < constructed);
+}
+
+BOOST_AUTO_TEST_CASE(order_across_inline_boundary)
+{
+	std::vector<u256> values{
+		u256(0),
+		u256(1),
+		maxInline - 1,
+		maxInline,
+		maxInline + 1,
+		maxInline + 2,
+		u256(1) << 128,
+		~u256(0)
+	};
+	for (size_t i = 0; i < values.size(); ++i)
+		for (size_t j = 0; j < values.size(); ++j)
+		{
+			AssemblyItem a(Push, values[i]);
+			AssemblyItem b(Push, values[j]);
+			BOOST_CHECK_EQUAL(a == b, i == j);
+			BOOST_CHECK_EQUAL(a != b, i != j);
+			BOOST_CHECK_EQUAL(a < b, i < j);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(type_takes_precedence_over_data)
+{
+	AssemblyItem smallTag(PushTag, 1);
+	AssemblyItem largePush(Push, ~u256(0));
+	BOOST_CHECK_EQUAL(largePush < smallTag, Push < PushTag);
+	BOOST_CHECK_EQUAL(smallTag < largePush, PushTag < Push);
+	BOOST_CHECK(smallTag != AssemblyItem(Tag, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
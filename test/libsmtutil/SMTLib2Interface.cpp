@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+
+/// Unit tests for the printing of expressions in libsmtutil/SMTLib2Interface.h
+
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+Expression variable(std::string _name)
+{
+	return Expression(std::move(_name), {}, SortProvider::sintSort);
+}
+
+std::string withLetBindings(Expression const& _expr)
+{
+	SMTLib2Interface interface;
+	interface.enableLetBindings();
+	return interface.toSExpr(_expr);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTLib2LetBindingsTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(without_shared_subterms)
+{
+	Expression x = variable("x");
+	Expression y = variable("y");
+	BOOST_CHECK_EQUAL(withLetBindings(x), "x");
+	BOOST_CHECK_EQUAL(withLetBindings((x + y) * (x - y)), "(* (+ x y) (- x y))");
+	// Leaves are not bound.
+	BOOST_CHECK_EQUAL(withLetBindings(x * x), "(* x x)");
+}
+
+BOOST_AUTO_TEST_CASE(disabled_by_default)
+{
+	Expression sum = variable("x") + variable("y");
+	BOOST_CHECK_EQUAL(SMTLib2Interface{}.toSExpr(sum * sum), "(* (+ x y) (+ x y))");
+}
+
+BOOST_AUTO_TEST_CASE(shared_subterm)
+{
+	Expression sum = variable("x") + variable("y");
+	BOOST_CHECK_EQUAL(withLetBindings(sum * sum), "(let ((|let 0| (+ x y))) (* |let 0| |let 0|))");
+}
+
+BOOST_AUTO_TEST_CASE(shared_subterms_of_same_height)
+{
+	Expression x = variable("x");
+	Expression y = variable("y");
+	Expression sum = x + y;
+	Expression product = x * y;
+	BOOST_CHECK_EQUAL(
+		withLetBindings((sum + product) * (sum - product)),
+		"(let ((|let 0| (+ x y))(|let 1| (* x y))) (* (+ |let 0| |let 1|) (- |let 0| |let 1|)))"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(nested_shared_subterms)
+{
+	Expression sum = variable("x") + variable("y");
+	Expression square = sum * sum;
+	BOOST_CHECK_EQUAL(
+		withLetBindings(square + square),
+		"(let ((|let 0| (+ x y))) (let ((|let 1| (* |let 0| |let 0|))) (+ |let 1| |let 1|)))"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(quantifiers_are_not_shared)
+{
+	Expression sum = variable("x") + variable("y");
+	Expression quantified("forall", {sum * sum}, SortProvider::boolSort);
+	BOOST_CHECK_EQUAL(
+		withLetBindings(quantified && sum > Expression(size_t(0))),
+		"(and (forall (* (+ x y) (+ x y))) (> (+ x y) 0))"
+	);
+	BOOST_CHECK_EQUAL(
+		withLetBindings(quantified && sum > sum),
+		"(let ((|let 0| (+ x y))) (and (forall (* (+ x y) (+ x y))) (> |let 0| |let 0|)))"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
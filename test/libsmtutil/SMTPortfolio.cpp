@@ -0,0 +1,213 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the solver race in libsmtutil/SMTPortfolio.h
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+/// A solver that gives a fixed answer after a delay, unless it is interrupted before.
+class FakeSolver: public SolverInterface
+{
+public:
+	/// @param _ignoreInterruptsFor how long after the start of check() interrupts are ignored,
+	/// like a solver that is not ready to be interrupted yet.
+	FakeSolver(
+		CheckResult _result,
+		std::vector<std::string> _values,
+		std::chrono::milliseconds _delay,
+		std::chrono::milliseconds _ignoreInterruptsFor = 0ms
+	):
+		m_result(_result),
+		m_values(std::move(_values)),
+		m_delay(_delay),
+		m_ignoreInterruptsFor(_ignoreInterruptsFor)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const&) override
+	{
+		std::unique_lock lock(m_mutex);
+		m_checkStart = std::chrono::steady_clock::now();
+		m_interrupted = false;
+		if (m_interruptedDuringCheck.wait_until(lock, *m_checkStart + m_delay, [&]() { return m_interrupted; }))
+		{
+			m_checkStart.reset();
+			return {CheckResult::UNKNOWN, {}};
+		}
+		m_checkStart.reset();
+		return {m_result, m_values};
+	}
+
+	void interrupt() override
+	{
+		std::lock_guard lock(m_mutex);
+		if (m_checkStart && std::chrono::steady_clock::now() - *m_checkStart >= m_ignoreInterruptsFor)
+		{
+			m_interrupted = true;
+			m_interruptedDuringCheck.notify_all();
+		}
+	}
+
+private:
+	CheckResult m_result;
+	std::vector<std::string> m_values;
+	std::chrono::milliseconds m_delay;
+	std::chrono::milliseconds m_ignoreInterruptsFor;
+
+	std::mutex m_mutex;
+	std::condition_variable m_interruptedDuringCheck;
+	std::optional<std::chrono::steady_clock::time_point> m_checkStart;
+	bool m_interrupted = false;
+};
+
+/// Long enough that a test fails if it waits for it.
+std::chrono::milliseconds const forever = 20s;
+
+std::vector<std::unique_ptr<SolverInterface>> solvers(std::vector<FakeSolver*> _solvers)
+{
+	std::vector<std::unique_ptr<SolverInterface>> result;
+	for (FakeSolver* solver: _solvers)
+		result.emplace_back(solver);
+	return result;
+}
+
+/// Races the solvers and checks that the race finishes long before @a forever.
+std::pair<CheckResult, std::vector<std::string>> race(
+	std::vector<FakeSolver*> _solvers,
+	std::vector<Expression> const& _expressionsToEvaluate = {Expression(true)}
+)
+{
+	SMTPortfolio portfolio(solvers(std::move(_solvers)), std::nullopt, false);
+	auto const start = std::chrono::steady_clock::now();
+	auto result = portfolio.check(_expressionsToEvaluate);
+	BOOST_CHECK(std::chrono::steady_clock::now() - start < forever / 2);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioRaceTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(uses_first_unsat_answer)
+{
+	auto [result, values] = race({
+		new FakeSolver(CheckResult::SATISFIABLE, {"0"}, forever),
+		new FakeSolver(CheckResult::UNSATISFIABLE, {}, 0ms)
+	});
+	BOOST_CHECK(result == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(uses_first_sat_answer_without_values)
+{
+	auto [result, values] = race(
+		{
+			new FakeSolver(CheckResult::UNSATISFIABLE, {}, forever),
+			new FakeSolver(CheckResult::SATISFIABLE, {}, 0ms)
+		},
+		{}
+	);
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(takes_model_from_first_solver)
+{
+	auto [result, values] = race({
+		new FakeSolver(CheckResult::SATISFIABLE, {"0"}, 200ms),
+		new FakeSolver(CheckResult::SATISFIABLE, {"1"}, 0ms)
+	});
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"0"});
+}
+
+BOOST_AUTO_TEST_CASE(takes_model_from_next_solver_if_first_does_not_answer)
+{
+	for (CheckResult firstResult: {CheckResult::UNKNOWN, CheckResult::ERROR})
+	{
+		auto [result, values] = race({
+			new FakeSolver(firstResult, {}, 100ms),
+			new FakeSolver(CheckResult::SATISFIABLE, {"1"}, 0ms)
+		});
+		BOOST_CHECK(result == CheckResult::SATISFIABLE);
+		BOOST_CHECK(values == std::vector<std::string>{"1"});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(does_not_wait_for_later_solvers_after_sat)
+{
+	auto [result, values] = race({
+		new FakeSolver(CheckResult::SATISFIABLE, {"0"}, 0ms),
+		new FakeSolver(CheckResult::SATISFIABLE, {"1"}, forever)
+	});
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"0"});
+}
+
+BOOST_AUTO_TEST_CASE(conflict_while_waiting_for_model)
+{
+	auto [result, values] = race({
+		new FakeSolver(CheckResult::UNSATISFIABLE, {}, 100ms),
+		new FakeSolver(CheckResult::SATISFIABLE, {"1"}, 0ms)
+	});
+	BOOST_CHECK(result == CheckResult::CONFLICTING);
+	BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(no_answer)
+{
+	auto [result, values] = race({
+		new FakeSolver(CheckResult::ERROR, {}, 0ms),
+		new FakeSolver(CheckResult::UNKNOWN, {}, 50ms)
+	});
+	BOOST_CHECK(result == CheckResult::UNKNOWN);
+	BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(repeats_interrupts_until_solver_returns)
+{
+	// The first solver is interrupted before it is ready for it.
+	auto [result, values] = race({
+		new FakeSolver(CheckResult::SATISFIABLE, {"0"}, forever, 200ms),
+		new FakeSolver(CheckResult::UNSATISFIABLE, {}, 0ms)
+	});
+	BOOST_CHECK(result == CheckResult::UNSATISFIABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
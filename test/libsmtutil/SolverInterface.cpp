@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+
+/// Unit tests for the hash-consing of expressions in libsmtutil/SolverInterface.h
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <unordered_set>
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+Expression variable(std::string _name, SortPointer _sort = SortProvider::sintSort)
+{
+	return Expression(std::move(_name), {}, std::move(_sort));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTExpressionHashConsingTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(equal_expressions_share_node)
+{
+	Expression a = variable("x") + variable("y") * Expression(size_t(2));
+	Expression b = variable("x") + variable("y") * Expression(size_t(2));
+	BOOST_CHECK(a.identical(b));
+	BOOST_CHECK_EQUAL(a.hash(), b.hash());
+	BOOST_CHECK(a.arguments()[1].identical(b.arguments()[1]));
+
+	Expression copy = a;
+	BOOST_CHECK(copy.identical(a));
+}
+
+BOOST_AUTO_TEST_CASE(different_expressions_do_not_share_node)
+{
+	Expression x = variable("x");
+	Expression y = variable("y");
+	BOOST_CHECK(!(x + y).identical(y + x));
+	BOOST_CHECK(!(x + y).identical(x - y));
+	BOOST_CHECK(!(x + y).identical(x + y + y));
+	BOOST_CHECK(!x.identical(y));
+}
+
+BOOST_AUTO_TEST_CASE(distinguishes_sorts)
+{
+	BOOST_CHECK(!variable("x", SortProvider::sintSort).identical(variable("x", SortProvider::uintSort)));
+	BOOST_CHECK(!variable("x", SortProvider::sintSort).identical(variable("x", SortProvider::boolSort)));
+	BOOST_CHECK(!variable("x", SortProvider::bitVectorSort).identical(variable("x", std::make_shared<BitVectorSort>(8))));
+	// Sorts that are equal but not the same object still share the node.
+	BOOST_CHECK(variable("x", std::make_shared<BitVectorSort>(8)).identical(variable("x", std::make_shared<BitVectorSort>(8))));
+	// A plain Int sort is not an IntSort, even though Sort::operator== considers them equal.
+	BOOST_CHECK(!variable("x", std::make_shared<Sort>(Kind::Int)).identical(variable("x", SortProvider::uintSort)));
+}
+
+BOOST_AUTO_TEST_CASE(recreates_released_expressions)
+{
+	std::size_t hash = 0;
+	{
+		Expression a = variable("released") * variable("released");
+		hash = a.hash();
+	}
+	Expression b = variable("released") * variable("released");
+	BOOST_CHECK_EQUAL(b.hash(), hash);
+	BOOST_CHECK(b.identical(variable("released") * variable("released")));
+	BOOST_CHECK_EQUAL(b.arguments()[0].name(), "released");
+}
+
+BOOST_AUTO_TEST_CASE(unordered_containers)
+{
+	std::unordered_set<Expression, ExpressionHash, ExpressionIdentical> expressions;
+	expressions.insert(variable("x") + variable("y"));
+	expressions.insert(variable("x") + variable("y"));
+	expressions.insert(variable("y") + variable("x"));
+	BOOST_CHECK_EQUAL(expressions.size(), 2);
+	BOOST_CHECK(expressions.count(variable("y") + variable("x")));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_creation)
+{
+	// Every thread builds the same terms, so that nodes are created and released concurrently.
+	auto build = [](size_t _round) {
+		Expression sum = variable("x");
+		for (size_t i = 0; i < 100; ++i)
+			sum = sum + Expression(i % 10 + _round % 3);
+		return sum;
+	};
+	std::vector<Expression> results(8, Expression(false));
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < results.size(); ++thread)
+		threads.emplace_back([&, thread]() {
+			for (size_t round = 0; round < 100; ++round)
+				results[thread] = build(round);
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (Expression const& result: results)
+		BOOST_CHECK(result.identical(build(99)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -33,6 +33,7 @@
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/analysis/Scoper.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/CompilerContext.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/analysis/SyntaxChecker.h>
@@ -40,6 +41,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <iostream>
 
@@ -150,6 +153,41 @@ void checkAssemblyLocations(AssemblyItems const& _items, std::vector<SourceLocat
 	}
 }
 
+/// Appends @a _snippet as inline assembly at each of @a _locations and @returns the source locations
+/// of the resulting assembly items. With @a _shareContext, all snippets are appended to the same
+/// compiler context and thus reuse its cached parse result, otherwise each one is parsed anew.
+std::vector<SourceLocation> inlineAssemblyLocations(
+	std::string const& _snippet,
+	std::vector<SourceLocation> const& _locations,
+	OptimiserSettings const& _optimiserSettings,
+	bool _shareContext
+)
+{
+	std::vector<SourceLocation> result;
+	std::unique_ptr<CompilerContext> context;
+	auto collectLocations = [&]()
+	{
+		if (context)
+			for (AssemblyItem const& item: context->assembly().items())
+				result.push_back(item.location());
+	};
+	for (SourceLocation const& location: _locations)
+	{
+		if (!context || !_shareContext)
+		{
+			collectLocations();
+			context = std::make_unique<CompilerContext>(
+				solidity::test::CommonOptions::get().evmVersion(),
+				RevertStrings::Default
+			);
+		}
+		Break node(1, location, nullptr);
+		CompilerContext::LocationSetter locationSetter(*context, node);
+		context->appendInlineAssembly(_snippet, {}, {}, false, _optimiserSettings);
+	}
+	collectLocations();
+	return result;
+}
 
 } // end anonymous namespace
 
@@ -216,6 +254,32 @@ BOOST_AUTO_TEST_CASE(jump_type)
 		BOOST_CHECK_EQUAL(jumpTypes, "[in]\n[out]\n[in]\n[out]\n");
 }
 
+BOOST_AUTO_TEST_CASE(cached_inline_assembly_locations)
+{
+	std::shared_ptr<std::string> sourceName = std::make_shared<std::string>("a.sol");
+	std::shared_ptr<std::string> otherSourceName = std::make_shared<std::string>("b.sol");
+	std::vector<SourceLocation> locations{
+		SourceLocation{10, 20, sourceName},
+		SourceLocation{30, 45, sourceName},
+		SourceLocation{10, 20, sourceName},
+		SourceLocation{5, 8, otherSourceName}
+	};
+	std::string snippet = R"({
+		let x := calldataload(4)
+		if iszero(x) { revert(0, 0) }
+		mstore(0x40, add(mload(0x40), x))
+	})";
+
+	for (OptimiserSettings const& optimiserSettings: {OptimiserSettings::none(), OptimiserSettings::standard()})
+	{
+		std::vector<SourceLocation> uncached = inlineAssemblyLocations(snippet, locations, optimiserSettings, false);
+		std::vector<SourceLocation> cached = inlineAssemblyLocations(snippet, locations, optimiserSettings, true);
+		BOOST_CHECK(cached == uncached);
+		// The snippet has to end up at every location, so that the comparison covers retargeting.
+		for (SourceLocation const& location: locations)
+			BOOST_CHECK(std::find(cached.begin(), cached.end(), location) != cached.end());
+	}
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
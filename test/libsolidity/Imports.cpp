@@ -25,6 +25,8 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
@@ -112,6 +114,42 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(parallel_parsing)
+{
+	// The sources that are not supplied initially are parsed in later batches.
+	std::map<std::string, std::string> const files{
+		{"lib/c.sol", "import \"lib/d.sol\"; contract C is D {} pragma solidity >=0.0;"},
+		{"lib/d.sol", "import \"lib/e.sol\"; contract D is E { uint x; } pragma solidity >=0.0;"},
+		{"lib/e.sol", "contract E { function f() public pure returns (uint) { return 1; } } pragma solidity >=0.0;"},
+		{"lib/f.sol", "contract F { function g() public { assembly { let y := 2 } } } pragma solidity >=0.0;"}
+	};
+	ReadCallback::Callback readFile = [&](std::string const&, std::string const& _path) {
+		if (files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "not found"};
+	};
+	auto parseAndAnalyze = [&](size_t _parallelism, std::string const& _brokenSource) {
+		CompilerStack c(readFile);
+		c.setParallelism(_parallelism);
+		c.setSources({
+			{"a.sol", "import \"lib/c.sol\"; import \"lib/f.sol\"; contract A is C, F {} pragma solidity >=0.0;"},
+			{"b.sol", "import \"lib/d.sol\"; contract B is D {} pragma solidity >=0.0;"},
+			{"c.sol", _brokenSource}
+		});
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		std::string result;
+		if (c.parseAndAnalyze())
+			for (std::string const& sourceName: c.sourceNames())
+				result += util::jsonCompactPrint(ASTJsonExporter(c.state(), c.sourceIndices()).toJson(c.ast(sourceName)));
+		return result + langutil::SourceReferenceFormatter::formatErrorInformation(c.errors(), c);
+	};
+
+	std::string const validSource = "contract G { uint public z; } pragma solidity >=0.0;";
+	std::string const brokenSource = "contract G { uint z = ; function } pragma solidity >=0.0;";
+	BOOST_CHECK_EQUAL(parseAndAnalyze(4, validSource), parseAndAnalyze(1, validSource));
+	BOOST_CHECK_EQUAL(parseAndAnalyze(4, brokenSource), parseAndAnalyze(1, brokenSource));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -22,6 +22,10 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libyul/YulStack.h>
+
+#include <libevmasm/Assembly.h>
+
 #include <boost/test/unit_test.hpp>
 
 
@@ -68,6 +72,101 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(via_ir_code_matches_reparsed_optimized_ir)
+{
+	// The EVM code and source mappings have to be the same as those generated from the printed
+	// optimized IR, also for loops, which the optimizer rewrites using nodes without debug data.
+	char const* sourceCode = R"(
+		contract C {
+			uint[] a;
+			function f(uint x) public returns (uint s) {
+				for (uint i = 0; i < x; ++i) { a.push(i); s += i * x; }
+				if (s > 100) revert("too large");
+			}
+			function g(uint x) public pure returns (uint) {
+				return x == 0 ? 1 : x * 2;
+			}
+		}
+	)";
+	auto evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	auto eofVersion = solidity::test::CommonOptions::get().eofVersion();
+	for (bool optimize: {false, true})
+		for (langutil::DebugInfoSelection debugInfo: {
+			langutil::DebugInfoSelection::Default(),
+			langutil::DebugInfoSelection::All(),
+			langutil::DebugInfoSelection::None()
+		})
+		{
+			CompilerStack compiler;
+			compiler.setSources({{"a.sol", sourceCode}});
+			compiler.setEVMVersion(evmVersion);
+			compiler.setEOFVersion(eofVersion);
+			compiler.setViaIR(true);
+			compiler.setOptimiserSettings(optimize);
+			compiler.selectDebugInfo(debugInfo);
+			BOOST_REQUIRE(compiler.compile());
+
+			yul::YulStack stack(
+				evmVersion,
+				eofVersion,
+				yul::YulStack::Language::StrictAssembly,
+				optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal(),
+				debugInfo
+			);
+			BOOST_REQUIRE(stack.parseAndAnalyze("", compiler.yulIROptimized("C")));
+			auto [creationAssembly, runtimeAssembly] = stack.assembleEVMWithDeployed(std::nullopt);
+			BOOST_REQUIRE(creationAssembly && runtimeAssembly);
+
+			BOOST_CHECK(creationAssembly->assemble().bytecode == compiler.object("C").bytecode);
+			BOOST_CHECK(runtimeAssembly->assemble().bytecode == compiler.runtimeObject("C").bytecode);
+			BOOST_CHECK_EQUAL(
+				evmasm::AssemblyItem::computeSourceMapping(creationAssembly->items(), compiler.sourceIndices()),
+				*compiler.sourceMapping("C")
+			);
+			BOOST_CHECK_EQUAL(
+				evmasm::AssemblyItem::computeSourceMapping(runtimeAssembly->items(), compiler.sourceIndices()),
+				*compiler.runtimeSourceMapping("C")
+			);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_code_independent_of_requested_contracts)
+{
+	// When "A" is requested as well, the optimized objects of "B" are shared through a cache.
+	// This must not change the code and source mappings of "B".
+	char const* sourceCode = R"(
+		contract B {
+			uint x;
+			function f(uint y) public returns (uint) {
+				for (uint i = 0; i < y; ++i) x += i;
+				return x;
+			}
+		}
+		contract A {
+			function g() public returns (address) { return address(new B()); }
+		}
+	)";
+	auto compile = [&](std::set<std::string> const& _contracts) {
+		auto compiler = std::make_unique<CompilerStack>();
+		compiler->setSources({{"a.sol", sourceCode}});
+		compiler->setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler->setEOFVersion(solidity::test::CommonOptions::get().eofVersion());
+		compiler->setViaIR(true);
+		compiler->setOptimiserSettings(true);
+		compiler->selectDebugInfo(langutil::DebugInfoSelection::All());
+		compiler->setRequestedContractNames({{"a.sol", _contracts}});
+		BOOST_REQUIRE(compiler->compile());
+		return compiler;
+	};
+	auto alone = compile({"B"});
+	auto shared = compile({"A", "B"});
+	BOOST_CHECK(alone->object("B").bytecode == shared->object("B").bytecode);
+	BOOST_CHECK(alone->runtimeObject("B").bytecode == shared->runtimeObject("B").bytecode);
+	BOOST_CHECK_EQUAL(*alone->sourceMapping("B"), *shared->sourceMapping("B"));
+	BOOST_CHECK_EQUAL(*alone->runtimeSourceMapping("B"), *shared->runtimeSourceMapping("B"));
+	BOOST_CHECK_EQUAL(alone->yulIROptimized("B"), shared->yulIROptimized("B"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
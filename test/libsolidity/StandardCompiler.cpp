@@ -23,14 +23,17 @@
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/filesystem.hpp>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TemporaryDirectory.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
+#include <mutex>
 #include <set>
 
 using namespace solidity::evmasm;
@@ -1060,6 +1063,363 @@ BOOST_AUTO_TEST_CASE(evm_version)
 	BOOST_CHECK(result["errors"][0]["message"].get<std::string>() == "Invalid EVM version requested.");
 }
 
+BOOST_AUTO_TEST_CASE(parallelism)
+{
+	auto inputForParallelism = [](std::string const& _parallelism)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"fileA": { "content": "contract B { uint x = 42; } contract A { function f() public { new B(); } } contract C { }" }
+				},
+				"settings": {
+					)" + _parallelism + R"(
+					"viaIR": true,
+					"optimizer": { "enabled": true },
+					"outputSelection": {
+						"fileA": {
+							"*": [ "evm.bytecode.object", "irOptimized" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	Json serialResult = compile(inputForParallelism(""));
+	BOOST_REQUIRE(serialResult.contains("contracts"));
+	BOOST_CHECK(!serialResult.contains("errors"));
+	for (std::string const parallelism: {"1", "2", "16"})
+	{
+		Json result = compile(inputForParallelism("\"parallelism\": " + parallelism + ","));
+		BOOST_CHECK(!result.contains("errors"));
+		BOOST_CHECK(result["contracts"] == serialResult["contracts"]);
+	}
+
+	for (std::string const parallelism: {"0", "-1", "\"4\"", "true"})
+	{
+		Json result = compile(inputForParallelism("\"parallelism\": " + parallelism + ","));
+		BOOST_REQUIRE(result.contains("errors"));
+		BOOST_CHECK(result["errors"][0]["message"].get<std::string>() == "\"settings.parallelism\" must be a positive integer.");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_parallelism)
+{
+	std::string const source =
+		"contract C {\n"
+		"	uint x;\n"
+		"	function g(uint a) internal pure returns (uint) { assert(a != 7); return a + 1; }\n"
+		"	function f1(uint a) public { x = g(a); assert(x > 2); }\n"
+		"	function f2(uint a) public { x = g(a) * 2; assert(x != 4); }\n"
+		"	function f3(uint a, uint b) public pure returns (uint) { assert(a > b); return a - b; }\n"
+		"	function f4(uint a) public pure { require(a > 3); }\n"
+		"}\n";
+	auto input = [&](std::string const& _engine, std::string const& _parallelism, bool _printQuery)
+	{
+		Json input{
+			{"language", "Solidity"},
+			{"sources", {{"A.sol", {{"content", source}}}}},
+			{"settings", {
+				{"modelChecker", {
+					{"engine", _engine},
+					{"solvers", {"smtlib2"}},
+					{"showUnproved", true},
+					{"showProvedSafe", true},
+					{"printQuery", _printQuery}
+				}}
+			}}
+		};
+		if (!_parallelism.empty())
+			input["settings"]["parallelism"] = std::stoul(_parallelism);
+		return util::jsonCompactPrint(input);
+	};
+
+	// Answers every CHC query depending on its text, so that different queries lead to different results.
+	// BMC queries are all answered the same way, which is either no result or a violation.
+	auto compileAndRecordQueries = [](std::string const& _input, std::string const& _bmcResponse)
+	{
+		std::mutex mutex;
+		std::vector<std::string> queries;
+		frontend::StandardCompiler compiler([&](std::string const& _kind, std::string const& _query) {
+			if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+				return ReadCallback::Result{false, "Unexpected callback kind."};
+			std::lock_guard lock(mutex);
+			queries.push_back(_query);
+			if (_query.find("(set-logic HORN)") == std::string::npos)
+				return ReadCallback::Result{true, _bmcResponse};
+			return ReadCallback::Result{true, std::hash<std::string>{}(_query) % 2 ? "sat\n" : "unsat\n"};
+		});
+		std::string output = compiler.compile(_input);
+		std::sort(queries.begin(), queries.end());
+		return std::make_pair(output, queries);
+	};
+
+	// The constant condition check of ``require`` is only done by BMC, so BMC always sends queries.
+	// With the BMC engine alone, every target is checked by BMC and a ``sat`` answer reports a violation.
+	for (std::string const engine: {"all", "bmc"})
+		for (std::string const bmcResponse: {"unknown\n", "sat\n"})
+			for (bool printQuery: {false, true})
+			{
+				auto [serialOutput, serialQueries] = compileAndRecordQueries(input(engine, "", printQuery), bmcResponse);
+				BOOST_REQUIRE(!serialQueries.empty());
+				BOOST_CHECK_EQUAL(serialOutput.find("BMC: Requested query") != std::string::npos, printQuery);
+				if (engine == "bmc")
+					BOOST_CHECK_EQUAL(
+						serialOutput.find("BMC: Assertion violation happens here") != std::string::npos,
+						bmcResponse == "sat\n"
+					);
+				for (std::string const parallelism: {"1", "2", "4"})
+				{
+					auto [output, queries] = compileAndRecordQueries(input(engine, parallelism, printQuery), bmcResponse);
+					BOOST_CHECK_EQUAL(output, serialOutput);
+					BOOST_CHECK(queries == serialQueries);
+				}
+			}
+}
+
+BOOST_AUTO_TEST_CASE(cache_directory)
+{
+	util::TemporaryDirectory cacheDirectory("solc-cache-test");
+	auto inputWithSources = [&](std::string const& _sourceB, std::string const& _sourceC)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"a.sol": { "content": "import \"b.sol\"; contract A { function f() public { new B(); } }" },
+					"b.sol": { "content": ")" + _sourceB + R"(" },
+					"c.sol": { "content": ")" + _sourceC + R"(" }
+				},
+				"settings": {
+					"outputSelection": {
+						"*": { "*": [ "abi", "evm.bytecode", "evm.deployedBytecode" ] }
+					}
+				}
+			}
+		)";
+	};
+	auto compileWithCache = [&](std::string const& _input)
+	{
+		frontend::StandardCompiler compiler;
+		compiler.setCacheDirectory(cacheDirectory.path().generic_string());
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(_input), result));
+		return result;
+	};
+	auto checkCacheStatistics = [](Json const& _result, size_t _hits, size_t _misses)
+	{
+		BOOST_REQUIRE(_result.contains("cache"));
+		BOOST_CHECK(_result["cache"]["hits"] == _hits);
+		BOOST_CHECK(_result["cache"]["misses"] == _misses);
+	};
+
+	Json result = compileWithCache(inputWithSources("contract B { uint x = 42; }", "contract C { }"));
+	BOOST_CHECK(!result.contains("errors"));
+	checkCacheStatistics(result, 0, 3);
+
+	Json cachedResult = compileWithCache(inputWithSources("contract B { uint x = 42; }", "contract C { }"));
+	BOOST_CHECK(!cachedResult.contains("errors"));
+	checkCacheStatistics(cachedResult, 3, 0);
+	BOOST_CHECK(cachedResult["contracts"] == result["contracts"]);
+
+	// A depends on B and has to be recompiled together with it, C does not.
+	Json modifiedResult = compileWithCache(inputWithSources("contract B { uint x = 43; }", "contract C { }"));
+	BOOST_CHECK(!modifiedResult.contains("errors"));
+	checkCacheStatistics(modifiedResult, 1, 2);
+	BOOST_CHECK(modifiedResult["contracts"]["c.sol"] == result["contracts"]["c.sol"]);
+	BOOST_CHECK(modifiedResult["contracts"]["b.sol"] != result["contracts"]["b.sol"]);
+
+	// Only C changed, so A is served from the cache even though it depends on B.
+	Json partiallyCachedResult = compileWithCache(inputWithSources("contract B { uint x = 43; }", "contract C { uint y; }"));
+	BOOST_CHECK(!partiallyCachedResult.contains("errors"));
+	checkCacheStatistics(partiallyCachedResult, 2, 1);
+	BOOST_CHECK(partiallyCachedResult["contracts"]["a.sol"] == modifiedResult["contracts"]["a.sol"]);
+	BOOST_CHECK(partiallyCachedResult["contracts"]["b.sol"] == modifiedResult["contracts"]["b.sol"]);
+
+	// If code generation fails for C, the cached bytecode of A and B is not returned either.
+	std::string parameters;
+	std::string sum = "0";
+	for (size_t i = 0; i < 20; ++i)
+	{
+		parameters += (i > 0 ? ", uint a" : "uint a") + std::to_string(i);
+		sum += " + a" + std::to_string(i);
+	}
+	Json failedResult = compileWithCache(inputWithSources(
+		"contract B { uint x = 43; }",
+		"contract C { function f(" + parameters + ") public pure returns (uint) { return " + sum + "; } }"
+	));
+	BOOST_REQUIRE(failedResult.contains("errors"));
+	BOOST_CHECK(failedResult["errors"][0]["message"].get<std::string>().find("Stack too deep") != std::string::npos);
+	checkCacheStatistics(failedResult, 2, 1);
+	BOOST_REQUIRE(failedResult.contains("contracts"));
+	for (auto const& [file, contracts]: failedResult["contracts"].items())
+		for (auto const& [name, contract]: contracts.items())
+		{
+			BOOST_CHECK(contract.contains("abi"));
+			BOOST_CHECK(!contract.contains("evm"));
+		}
+
+	// Without a cache directory set by the caller, the cache is not used.
+	BOOST_CHECK(!compile(inputWithSources("contract B { }", "contract C { }")).contains("cache"));
+}
+
+BOOST_AUTO_TEST_CASE(cache_directory_not_accepted_from_input)
+{
+	util::TemporaryDirectory directory("solc-cache-test");
+	boost::filesystem::path const cachePath = directory.path() / "cache";
+	Json input = {
+		{"language", "Solidity"},
+		{"sources", {{"a.sol", {{"content", "contract A { }"}}}}},
+		{"settings", {
+			{"cacheDirectory", cachePath.generic_string()},
+			{"outputSelection", {{"*", {{"*", {"evm.bytecode"}}}}}}
+		}}
+	};
+	Json result = compile(util::jsonCompactPrint(input));
+	BOOST_REQUIRE(result.contains("errors"));
+	BOOST_CHECK(result["errors"][0]["message"].get<std::string>() == "Unknown key \"cacheDirectory\"");
+	BOOST_CHECK(!result.contains("cache"));
+	BOOST_CHECK(!boost::filesystem::exists(cachePath));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache_directory_not_accepted_from_input)
+{
+	util::TemporaryDirectory directory("solc-smt-cache-test");
+	boost::filesystem::path const cachePath = directory.path() / "cache";
+	Json input = {
+		{"language", "Solidity"},
+		{"sources", {{"a.sol", {{"content", "contract A { function f(uint x) public pure { assert(x > 0); } }"}}}}},
+		{"settings", {
+			{"modelChecker", {
+				{"engine", "chc"},
+				{"cacheDirectory", cachePath.generic_string()}
+			}}
+		}}
+	};
+	Json result = compile(util::jsonCompactPrint(input));
+	BOOST_REQUIRE(result.contains("errors"));
+	BOOST_CHECK(result["errors"][0]["message"].get<std::string>() == "Unknown key \"cacheDirectory\"");
+	BOOST_CHECK(!boost::filesystem::exists(cachePath));
+}
+
+BOOST_AUTO_TEST_CASE(written_output_matches_json_output)
+{
+	// compile(std::string) writes the ASTs and contract outputs directly into the output, which has to be
+	// identical to the output of compile(Json) printed as a whole.
+	Json const sources = {
+		{"a.sol", {{"content",
+			"// SPDX-License-Identifier: GPL-3.0\n"
+			"pragma solidity >=0.0;\n"
+			"/// @title A \"quoted\" title with a \\ backslash and é\n"
+			"contract A {\n"
+			"\tstring constant s = unicode\"é\\n\\t\\\"\";\n"
+			"\tfunction f() external pure returns (string memory) { return s; }\n"
+			"}\n"
+			"contract Empty {}\n"
+		}}},
+		{"b.sol", {{"content", "import \"a.sol\";\ncontract B is A { function g() public {} }\n"}}},
+		{"c.sol", {{"content", "contract C {}\n"}}}
+	};
+	std::vector<Json> const inputs{
+		{
+			{"language", "Solidity"},
+			{"sources", sources},
+			{"settings", {{"outputSelection", {{"*", {{"", {"ast"}}, {"*", {"abi", "devdoc", "userdoc", "evm.methodIdentifiers"}}}}}}}}
+		},
+		// ASTs of only some sources.
+		{
+			{"language", "Solidity"},
+			{"sources", sources},
+			{"settings", {{"outputSelection", {{"b.sol", {{"", {"ast"}}, {"*", {"abi"}}}}, {"c.sol", {{"*", {"abi"}}}}}}}}
+		},
+		// Contract outputs only, including code, but none for some of the contracts.
+		{
+			{"language", "Solidity"},
+			{"sources", sources},
+			{"settings", {
+				{"viaIR", true},
+				{"optimizer", {{"enabled", true}}},
+				{"outputSelection", {
+					{"a.sol", {{"A", {"evm.bytecode", "evm.deployedBytecode", "evm.assembly", "evm.gasEstimates", "ir", "irOptimized", "metadata", "storageLayout"}}}},
+					{"b.sol", {{"*", {"evm.legacyAssembly", "irOptimizedAst"}}}}
+				}}
+			}}
+		},
+		// No output at all, which results in empty objects.
+		{
+			{"language", "Solidity"},
+			{"sources", {{"c.sol", sources.at("c.sol")}}},
+			{"settings", {{"outputSelection", Json::object()}}}
+		},
+		// Analysis errors.
+		{
+			{"language", "Solidity"},
+			{"sources", {{"d.sol", {{"content", "contract D { function f() public { x = \"\\\"\"; } }"}}}}},
+			{"settings", {{"outputSelection", {{"*", {{"", {"ast"}}}}}}}}
+		},
+	};
+
+	for (util::JsonFormat const& format: {
+		util::JsonFormat{util::JsonFormat::Compact},
+		util::JsonFormat{util::JsonFormat::Pretty},
+		util::JsonFormat{util::JsonFormat::Pretty, 4}
+	})
+		for (Json const& input: inputs)
+		{
+			std::string const written = frontend::StandardCompiler({}, format).compile(util::jsonCompactPrint(input));
+			std::string const printed = util::jsonPrint(frontend::StandardCompiler({}, format).compile(input), format);
+			BOOST_CHECK_EQUAL(written, printed);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_profile)
+{
+	auto inputWithSelection = [](std::string const& _viaIR, std::string const& _outputSelection)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"fileA": { "content": "contract A { uint x; function f(uint a) public { x = a * 2 + 1; } }" }
+				},
+				"settings": {
+					"viaIR": )" + _viaIR + R"(,
+					"optimizer": { "enabled": true },
+					"outputSelection": {
+						"fileA": { "A": [ )" + _outputSelection + R"( ] }
+					}
+				}
+			}
+		)";
+	};
+
+	for (std::string const viaIR: {"false", "true"})
+	{
+		Json result = compile(inputWithSelection(viaIR, "\"optimizerProfile\""));
+		BOOST_CHECK(!result.contains("errors"));
+		Json const& profile = result["contracts"]["fileA"]["A"]["optimizerProfile"];
+		BOOST_REQUIRE(profile.is_object());
+		BOOST_REQUIRE(profile.contains("yul"));
+		BOOST_REQUIRE(profile.contains("evmasm"));
+		BOOST_REQUIRE(profile["evmasm"].contains("PeepholeOptimiser"));
+		for (std::string const optimizer: {"yul", "evmasm"})
+			for (auto const& [step, statistics]: profile[optimizer].items())
+			{
+				BOOST_CHECK(statistics["invocations"].get<size_t>() > 0);
+				BOOST_CHECK(statistics["durationMicroseconds"].is_number_integer());
+				BOOST_CHECK(statistics["sizeDelta"].is_number_integer());
+			}
+		if (viaIR == "true")
+			BOOST_CHECK(profile["yul"].contains("UnusedPruner"));
+	}
+
+	// The profile is not selected by the wildcard.
+	Json result = compile(inputWithSelection("false", "\"*\""));
+	BOOST_CHECK(!result.contains("errors"));
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"].contains("optimizerProfile"));
+}
+
 BOOST_AUTO_TEST_CASE(optimizer_settings_default_disabled)
 {
 	char const* input = R"(
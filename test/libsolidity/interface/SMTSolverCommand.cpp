@@ -0,0 +1,282 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/SMTSolverCommand.h
+
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::frontend::test
+{
+
+#ifndef _WIN32
+
+namespace
+{
+
+/// A fake solver that answers every (check-sat) with the number of checks it has answered so far,
+/// answers (slow) after a second, never answers (hang), exits after the next (echo) following
+/// (exit-after-echo) and supports (echo).
+std::string const stubSolver = R"SCRIPT(#!/bin/sh
+checks=0
+exitAfterEcho=
+while IFS= read -r line; do
+	case "$line" in
+		"(check-sat)"*) checks=$((checks + 1)); echo "sat $checks";;
+		"(slow)"*) sleep 1; echo slow;;
+		"(hang)"*) exec sleep 10;;
+		"(exit-after-echo)"*) exitAfterEcho=1;;
+		"(echo "*)
+			argument="${line#(echo }"; echo "${argument%)}"
+			if [ -n "$exitAfterEcho" ]; then exit 0; fi;;
+	esac
+done
+)SCRIPT";
+
+/// A fake cvc5 that answers every query with sat and counts how often it was run.
+std::string const countingSolver = R"SCRIPT(#!/bin/sh
+if [ "$1" = "--version" ]; then
+	echo "counting solver 1.0"
+	exit 0
+fi
+echo run >> "${0%/*}/runs"
+echo sat
+# Stay alive until the response has been read.
+sleep 0.1
+)SCRIPT";
+
+/// A fake cvc5 that answers every query with sat after a second.
+std::string const slowSolver = R"SCRIPT(#!/bin/sh
+if [ "$1" = "--version" ]; then
+	echo "slow solver 1.0"
+	exit 0
+fi
+sleep 1
+echo sat
+)SCRIPT";
+
+boost::filesystem::path createStubSolver(
+	TemporaryDirectory const& _directory,
+	std::string const& _script = stubSolver,
+	std::string const& _name = "solver.sh"
+)
+{
+	boost::filesystem::path solverPath = _directory.path() / _name;
+	boost::filesystem::ofstream(solverPath) << _script;
+	boost::filesystem::permissions(solverPath, boost::filesystem::owner_all);
+	return solverPath;
+}
+
+size_t countRuns(TemporaryDirectory const& _directory)
+{
+	boost::filesystem::ifstream runs(_directory.path() / "runs");
+	size_t count = 0;
+	for (std::string line; std::getline(runs, line);)
+		++count;
+	return count;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTSolverSessionTest)
+
+BOOST_AUTO_TEST_CASE(answers_queries)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverSession session(createStubSolver(tempDir).string(), {}, std::chrono::milliseconds(1000));
+
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+	BOOST_CHECK(!session.failed());
+}
+
+BOOST_AUTO_TEST_CASE(keeps_solver_running)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverSession session(createStubSolver(tempDir).string(), {}, std::chrono::milliseconds(1000));
+
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+	BOOST_CHECK(session.run("(push 1)\n(check-sat)\n(pop 1)") == "sat 2");
+	BOOST_CHECK(session.run("(check-sat)\n(check-sat)") == "sat 3\nsat 4");
+}
+
+BOOST_AUTO_TEST_CASE(restarts_solver_after_timeout)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverSession session(createStubSolver(tempDir).string(), {}, std::chrono::milliseconds(100));
+
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+	BOOST_CHECK(session.run("(hang)") == std::nullopt);
+	BOOST_CHECK(!session.failed());
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+}
+
+BOOST_AUTO_TEST_CASE(keeps_solver_running_after_interrupt)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverSession session(createStubSolver(tempDir).string(), {}, std::chrono::milliseconds(5000));
+
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+	// Interrupt the query the way a solver is interrupted that lost the race against another one.
+	std::atomic<bool> answered = false;
+	std::thread interrupter([&]() {
+		while (!answered)
+		{
+			session.interrupt();
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	});
+	BOOST_CHECK(session.run("(slow)\n(check-sat)") == std::nullopt);
+	answered = true;
+	interrupter.join();
+	BOOST_CHECK(session.running());
+
+	// The solver completed the interrupted query in the background.
+	BOOST_CHECK(session.run("(check-sat)") == "sat 3");
+	BOOST_CHECK(!session.failed());
+}
+
+BOOST_AUTO_TEST_CASE(ignores_interrupt_without_query)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverSession session(createStubSolver(tempDir).string(), {}, std::chrono::milliseconds(1000));
+
+	session.interrupt();
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+	session.interrupt();
+	BOOST_CHECK(session.run("(check-sat)") == "sat 2");
+	BOOST_CHECK(!session.failed());
+}
+
+BOOST_AUTO_TEST_CASE(restarts_solver_after_exit)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverSession session(createStubSolver(tempDir).string(), {}, std::chrono::milliseconds(1000));
+
+	BOOST_CHECK(session.run("(check-sat)\n(exit-after-echo)") == "sat 1");
+	// Give the solver time to exit, so that the next query is written to a closed pipe.
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	BOOST_CHECK(session.run("(check-sat)") == std::nullopt);
+	BOOST_CHECK(!session.failed());
+	BOOST_CHECK(session.run("(check-sat)") == "sat 1");
+}
+
+BOOST_AUTO_TEST_CASE(unavailable_solver)
+{
+	SMTSolverSession session("solc-test-solver-that-does-not-exist", {}, std::nullopt);
+
+	BOOST_CHECK(session.run("(check-sat)") == std::nullopt);
+	BOOST_CHECK(session.failed());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(SMTSolverCommandTest)
+
+BOOST_AUTO_TEST_CASE(query_cache)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createStubSolver(tempDir, countingSolver, "cvc5");
+
+	// The solver is looked up in PATH.
+	char const* originalPath = std::getenv("PATH");
+	std::string const savedPath = originalPath ? originalPath : "";
+	ScopeGuard restorePath([&]() { setenv("PATH", savedPath.c_str(), 1); });
+	setenv("PATH", (tempDir.path().string() + ":" + savedPath).c_str(), 1);
+
+	std::string const kind = ReadCallback::kindString(ReadCallback::Kind::SMTQuery);
+	SMTSolverCommand command;
+	command.setQueryCache(tempDir.path() / "cache");
+	command.setCvc5(1000);
+
+	BOOST_CHECK_EQUAL(command.solve(kind, "(check-sat)").responseOrErrorMessage, "sat");
+	BOOST_CHECK_EQUAL(command.solve(kind, "(check-sat)").responseOrErrorMessage, "sat");
+	BOOST_CHECK_EQUAL(countRuns(tempDir), 1);
+	BOOST_CHECK_EQUAL(command.queryCacheStats().hits, 1);
+	BOOST_CHECK_EQUAL(command.queryCacheStats().misses, 1);
+
+	BOOST_CHECK_EQUAL(command.solve(kind, "(assert true)\n(check-sat)").responseOrErrorMessage, "sat");
+	BOOST_CHECK_EQUAL(countRuns(tempDir), 2);
+
+	// A different timeout invalidates the cached results.
+	command.setCvc5(2000);
+	BOOST_CHECK_EQUAL(command.solve(kind, "(check-sat)").responseOrErrorMessage, "sat");
+	BOOST_CHECK_EQUAL(countRuns(tempDir), 3);
+
+	// The cache is persistent.
+	SMTSolverCommand otherCommand;
+	otherCommand.setQueryCache(tempDir.path() / "cache");
+	otherCommand.setCvc5(1000);
+	BOOST_CHECK_EQUAL(otherCommand.solve(kind, "(check-sat)").responseOrErrorMessage, "sat");
+	BOOST_CHECK_EQUAL(countRuns(tempDir), 3);
+}
+
+BOOST_AUTO_TEST_CASE(interrupts_only_the_query_of_the_given_thread)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createStubSolver(tempDir, slowSolver, "cvc5");
+
+	char const* originalPath = std::getenv("PATH");
+	std::string const savedPath = originalPath ? originalPath : "";
+	ScopeGuard restorePath([&]() { setenv("PATH", savedPath.c_str(), 1); });
+	setenv("PATH", (tempDir.path().string() + ":" + savedPath).c_str(), 1);
+
+	std::string const kind = ReadCallback::kindString(ReadCallback::Kind::SMTQuery);
+	SMTSolverCommand command;
+	command.setCvc5(5000);
+
+	ReadCallback::Result interruptedResult;
+	ReadCallback::Result otherResult;
+	std::atomic<bool> interruptedAnswered = false;
+	std::thread interruptedQuery([&]() {
+		interruptedResult = command.solve(kind, "(check-sat)");
+		interruptedAnswered = true;
+	});
+	std::thread otherQuery([&]() { otherResult = command.solve(kind, "(check-sat)"); });
+	while (!interruptedAnswered)
+	{
+		command.interrupt(interruptedQuery.get_id());
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	interruptedQuery.join();
+	otherQuery.join();
+
+	BOOST_CHECK_EQUAL(interruptedResult.responseOrErrorMessage, "");
+	BOOST_CHECK(otherResult.success);
+	BOOST_CHECK_EQUAL(otherResult.responseOrErrorMessage, "sat");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
+
+}
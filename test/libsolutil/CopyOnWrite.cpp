@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/CopyOnWrite.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(CopyOnWriteTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(default_constructed_is_empty)
+{
+	CopyOnWrite<std::map<int, int>> map;
+	BOOST_CHECK(map->empty());
+	BOOST_CHECK(map.sharesValueWith(CopyOnWrite<std::map<int, int>>{}));
+}
+
+BOOST_AUTO_TEST_CASE(copies_share_value_until_written)
+{
+	CopyOnWrite<std::map<int, int>> map(std::map<int, int>{{1, 2}});
+	CopyOnWrite<std::map<int, int>> copy = map;
+	BOOST_CHECK(copy.sharesValueWith(map));
+	BOOST_CHECK(map.isShared());
+	BOOST_CHECK(copy.isShared());
+
+	copy.write()[3] = 4;
+	BOOST_CHECK(!copy.sharesValueWith(map));
+	BOOST_CHECK(!map.isShared());
+	BOOST_CHECK(!copy.isShared());
+	BOOST_CHECK((*map == std::map<int, int>{{1, 2}}));
+	BOOST_CHECK((*copy == std::map<int, int>{{1, 2}, {3, 4}}));
+}
+
+BOOST_AUTO_TEST_CASE(unshared_value_is_written_in_place)
+{
+	CopyOnWrite<std::map<int, int>> map;
+	map.write()[1] = 2;
+	std::map<int, int> const* value = &*map;
+	map.write()[3] = 4;
+	BOOST_CHECK_EQUAL(&*map, value);
+
+	{
+		CopyOnWrite<std::map<int, int>> copy = map;
+	}
+	map.write()[5] = 6;
+	BOOST_CHECK_EQUAL(&*map, value);
+	BOOST_CHECK_EQUAL(map->size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
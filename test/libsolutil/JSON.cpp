@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -331,6 +333,151 @@ BOOST_AUTO_TEST_CASE(json_range_checks)
 	BOOST_CHECK_THROW(get<float>(underflow["v"]), InvalidType);
 }
 
+namespace
+{
+
+/// Formats in which the JsonWriter is compared against jsonPrint().
+std::vector<JsonFormat> const jsonFormats{
+	JsonFormat{JsonFormat::Compact},
+	JsonFormat{JsonFormat::Pretty},
+	JsonFormat{JsonFormat::Pretty, 1},
+	JsonFormat{JsonFormat::Pretty, 4},
+};
+
+/// Writes @a _value the way StandardCompiler writes its output: objects and arrays member by member,
+/// and only the leaves as a whole.
+void writeRecursively(JsonWriter& _writer, Json const& _value)
+{
+	if (_value.is_object())
+	{
+		_writer.beginObject();
+		for (auto const& [key, member]: _value.items())
+		{
+			_writer.key(key);
+			writeRecursively(_writer, member);
+		}
+		_writer.endObject();
+	}
+	else if (_value.is_array())
+	{
+		_writer.beginArray();
+		for (Json const& element: _value)
+			writeRecursively(_writer, element);
+		_writer.endArray();
+	}
+	else
+		_writer.value(_value);
+}
+
+Json const jsonWriterTestValue = {
+	{"empty object", Json::object()},
+	{"empty array", Json::array()},
+	{"null", Json()},
+	{"numbers", {0, -1, 18446744073709551615u, 1.5}},
+	{"escaping", {
+		"\"quoted\"",
+		"back\\slash",
+		"line\nbreak\ttab",
+		"\x01\x1f\x7f",
+		"\u4e2d \u0911",
+		"\xf0\x9f\x98\x80",
+	}},
+	{"\"key\"\n", "escaped key"},
+	{"nested", {
+		{"a", {{"b", Json::array({Json::object(), Json::array(), {{"c", true}}})}}},
+		{"d", Json::array({Json::array({Json::array()})})},
+	}},
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_values)
+{
+	for (JsonFormat const& format: jsonFormats)
+		for (Json const& value: {
+			jsonWriterTestValue,
+			Json(),
+			Json::object(),
+			Json::array(),
+			Json("\"\\\u0010"),
+			Json::array({Json::object()}),
+			Json{{"a", Json::object()}},
+		})
+		{
+			std::string written;
+			JsonWriter(written, format).value(value);
+			BOOST_CHECK_EQUAL(written, jsonPrint(value, format));
+
+			std::stringstream stream;
+			JsonWriter(stream, format).value(value);
+			BOOST_CHECK_EQUAL(stream.str(), jsonPrint(value, format));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_piece_by_piece)
+{
+	for (JsonFormat const& format: jsonFormats)
+		for (Json const& value: {jsonWriterTestValue, Json::object(), Json::array(), Json::array({Json::array()})})
+		{
+			std::string written;
+			JsonWriter writer(written, format);
+			writeRecursively(writer, value);
+			BOOST_CHECK_EQUAL(written, jsonPrint(value, format));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_member_writers)
+{
+	Json const expectation = {
+		{"a", 1},
+		{"b", {{"written", true}}},
+		{"c", Json::array({Json::object()})},
+		{"d", "\"d\""},
+		{"e", Json::object()},
+	};
+	// "b" and "d" replace members of the object, "e" and "c" are added.
+	Json const object = {{"a", 1}, {"b", "replaced"}, {"d", "replaced"}};
+	std::map<std::string, JsonWriter::MemberWriter> const memberWriters{
+		{"b", [](JsonWriter& _writer) { _writer.beginObject(); _writer.key("written"); _writer.value(true); _writer.endObject(); }},
+		{"c", [](JsonWriter& _writer) { _writer.beginArray(); _writer.value(Json::object()); _writer.endArray(); }},
+		{"d", [](JsonWriter& _writer) { _writer.value("\"d\""); }},
+		{"e", [](JsonWriter& _writer) { _writer.beginObject(); _writer.endObject(); }},
+	};
+
+	for (JsonFormat const& format: jsonFormats)
+	{
+		std::string written;
+		JsonWriter(written, format).object(object, memberWriters);
+		BOOST_CHECK_EQUAL(written, jsonPrint(expectation, format));
+
+		// Nested in an array and only consisting of member writers.
+		written.clear();
+		JsonWriter writer(written, format);
+		writer.beginArray();
+		writer.object(object, memberWriters);
+		writer.object(Json::object(), {{"e", memberWriters.at("e")}});
+		writer.object(Json::object(), {});
+		writer.endArray();
+		BOOST_CHECK_EQUAL(written, jsonPrint(Json::array({expectation, {{"e", Json::object()}}, Json::object()}), format));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_key_order)
+{
+	std::string written;
+	JsonWriter writer(written, JsonFormat{JsonFormat::Compact});
+	writer.beginObject();
+	writer.key("b");
+	writer.value(1);
+	BOOST_CHECK_THROW(writer.key("a"), Exception);
+	BOOST_CHECK_THROW(writer.key("b"), Exception);
+	writer.key("c");
+	BOOST_CHECK_THROW(writer.endObject(), Exception);
+	writer.value(2);
+	writer.endObject();
+	BOOST_CHECK_EQUAL(written, R"({"b":1,"c":2})");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(no_tasks)
+{
+	BOOST_CHECK(parallelFor(0, 4, [](size_t) { BOOST_REQUIRE(false); }).empty());
+}
+
+BOOST_AUTO_TEST_CASE(runs_every_task_once)
+{
+	for (size_t threads: std::vector<size_t>{0, 1, 2, 8, 200})
+	{
+		std::vector<size_t> results(100, 0);
+		std::vector<std::exception_ptr> exceptions = parallelFor(results.size(), threads, [&](size_t _index) {
+			results[_index] += _index + 1;
+		});
+		BOOST_REQUIRE_EQUAL(exceptions.size(), results.size());
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL(results[i], i + 1);
+			BOOST_CHECK(!exceptions[i]);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(first_failure_is_deterministic)
+{
+	for (size_t threads: std::vector<size_t>{1, 2, 8})
+	{
+		std::vector<int> started(50, 0);
+		std::vector<std::exception_ptr> exceptions = parallelFor(started.size(), threads, [&](size_t _index) {
+			started[_index] = 1;
+			if (_index == 10 || _index == 20)
+				throw std::runtime_error("failure at " + std::to_string(_index));
+		});
+		for (size_t i = 0; i < 10; ++i)
+		{
+			BOOST_CHECK(started[i]);
+			BOOST_CHECK(!exceptions[i]);
+		}
+		BOOST_REQUIRE(exceptions[10]);
+		BOOST_CHECK_EXCEPTION(
+			std::rethrow_exception(exceptions[10]),
+			std::runtime_error,
+			[](std::runtime_error const& _error) { return std::string(_error.what()) == "failure at 10"; }
+		);
+		if (threads == 1)
+			for (size_t i = 11; i < started.size(); ++i)
+				BOOST_CHECK(!started[i]);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
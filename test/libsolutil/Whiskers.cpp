@@ -240,6 +240,32 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(reused_template)
+{
+	std::string templ = "<?c><a><!c><#l><a><b></l></c>";
+	std::vector<std::map<std::string, std::string>> list(2);
+	list[0]["b"] = "1";
+	list[1]["b"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "X")("c", true)("l", list).render(), "X");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "Y")("c", false)("l", list).render(), "Y1Y2");
+	BOOST_CHECK_THROW(Whiskers{templ}("c", false)("l", list).render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(nested_conditions)
+{
+	std::string templ = "<?a>[<?b>ab<!b>a</b>]<!a><?b>b</b></a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", true)("b", true).render(), "[ab]");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", true)("b", false).render(), "[a]");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", false)("b", true).render(), "b");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", false)("b", false).render(), "");
+}
+
+BOOST_AUTO_TEST_CASE(unclosed_tags_rendered)
+{
+	std::string templ = "<#l> </x> <!y> <a";
+	BOOST_CHECK_EQUAL(Whiskers(templ).render(), templ);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -26,11 +26,14 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/Scanner.h>
 
+#include <libyul/OptimizedObjectCache.h>
 #include <libyul/YulStack.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <libsolutil/StepProfile.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -183,6 +186,224 @@ BOOST_AUTO_TEST_CASE(to_string)
 	BOOST_CHECK_EQUAL(asmStack.print(), expectation);
 }
 
+BOOST_AUTO_TEST_CASE(optimized_object_cache)
+{
+	std::string inner = R"(
+		/// @use-src 0:"source"
+		object "B" {
+			code { sstore(0, add(calldataload(0), 1)) }
+			/// @use-src 0:"source"
+			object "B_deployed" {
+				code { let x := calldataload(0) sstore(x, mul(x, 2)) }
+			}
+		}
+	)";
+	std::string outer = R"(
+		/// @use-src 0:"source"
+		object "A" {
+			code { sstore(1, calldataload(32)) }
+	)" + inner + R"(
+		}
+	)";
+	auto optimize = [](std::string const& _source, std::shared_ptr<OptimizedObjectCache> _cache) {
+		YulStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion(),
+			YulStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::standard(),
+			DebugInfoSelection::All(),
+			std::move(_cache)
+		);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", _source));
+		asmStack.optimize();
+		return asmStack.print();
+	};
+
+	auto cache = std::make_shared<OptimizedObjectCache>();
+	BOOST_CHECK_EQUAL(optimize(inner, cache), optimize(inner, nullptr));
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+	// The embedded object "B" is taken from the cache, only "A" itself is optimized.
+	BOOST_CHECK_EQUAL(optimize(outer, cache), optimize(outer, nullptr));
+	BOOST_CHECK_EQUAL(cache->size(), 3);
+	BOOST_CHECK_EQUAL(optimize(outer, cache), optimize(outer, nullptr));
+	BOOST_CHECK_EQUAL(cache->size(), 3);
+
+	// Objects without @use-src are not cached, and neither are the objects containing them.
+	std::string unannotated = R"(
+		/// @use-src 0:"source"
+		object "C" {
+			code { sstore(2, calldataload(64)) }
+			object "C_deployed" {
+				code { sstore(3, calldataload(96)) }
+			}
+		}
+	)";
+	BOOST_CHECK_EQUAL(optimize(unannotated, cache), optimize(unannotated, nullptr));
+	BOOST_CHECK_EQUAL(cache->size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(optimized_object_cache_hit_and_miss_assemble_identically)
+{
+	std::string inner = R"(
+		/// @use-src 0:"source"
+		object "B" {
+			code {
+				/// @src 0:10:20
+				function f(a) -> r {
+					/// @src 0:12:18
+					r := add(a, calldataload(a))
+				}
+				/// @src 0:30:40
+				sstore(0, f(calldataload(0)))
+			}
+			/// @use-src 0:"source"
+			object "B_deployed" {
+				code {
+					/// @src 0:50:60
+					let x := calldataload(0)
+					/// @src 0:62:70
+					switch x
+					case 0 { sstore(x, 1) }
+					default { sstore(x, mul(x, 2)) }
+				}
+			}
+		}
+	)";
+	std::string outer = R"(
+		/// @use-src 0:"source"
+		object "A" {
+			code {
+				/// @src 0:80:90
+				sstore(1, calldataload(32))
+			}
+	)" + inner + R"(
+		}
+	)";
+	auto assemble = [](std::string const& _source, std::shared_ptr<OptimizedObjectCache> _cache) {
+		YulStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion(),
+			YulStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::standard(),
+			DebugInfoSelection::All(),
+			std::move(_cache)
+		);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", _source));
+		asmStack.optimize();
+		MachineAssemblyObject object = asmStack.assemble(YulStack::Machine::EVM);
+		BOOST_REQUIRE(object.bytecode && object.sourceMappings);
+		return std::make_pair(object.bytecode->bytecode, *object.sourceMappings);
+	};
+
+	// "B" is optimized by whichever stack gets to it first. Its code and source mappings have to be
+	// the same if it is then taken from the cache.
+	auto innerFirst = std::make_shared<OptimizedObjectCache>();
+	auto innerMiss = assemble(inner, innerFirst);
+	auto outerHit = assemble(outer, innerFirst);
+	auto outerFirst = std::make_shared<OptimizedObjectCache>();
+	auto outerMiss = assemble(outer, outerFirst);
+	auto innerHit = assemble(inner, outerFirst);
+	BOOST_CHECK(innerHit.first == innerMiss.first);
+	BOOST_CHECK_EQUAL(innerHit.second, innerMiss.second);
+	BOOST_CHECK(outerHit.first == outerMiss.first);
+	BOOST_CHECK_EQUAL(outerHit.second, outerMiss.second);
+}
+
+BOOST_AUTO_TEST_CASE(optimized_object_cache_reuses_sub_assemblies)
+{
+	// Assemblies are not cached for EOF.
+	if (solidity::test::CommonOptions::get().eofVersion().has_value())
+		return;
+
+	std::string source = R"(
+		/// @use-src 0:"source"
+		object "A" {
+			code {
+				/// @src 0:0:10
+				sstore(datasize("B"), dataoffset("B.B_deployed"))
+			}
+			/// @use-src 0:"source"
+			object "B" {
+				code {
+					/// @src 0:10:20
+					sstore(0, add(calldataload(0), datasize("B_deployed")))
+				}
+				/// @use-src 0:"source"
+				object "B_deployed" {
+					code {
+						/// @src 0:20:30
+						let x := calldataload(0)
+						sstore(x, mul(x, 2))
+					}
+				}
+			}
+		}
+	)";
+	auto assemble = [&](std::shared_ptr<OptimizedObjectCache> _cache) {
+		YulStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion(),
+			YulStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::standard(),
+			DebugInfoSelection::All(),
+			std::move(_cache)
+		);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", source));
+		asmStack.optimize();
+		MachineAssemblyObject object = asmStack.assemble(YulStack::Machine::EVM);
+		BOOST_REQUIRE(object.bytecode && object.sourceMappings);
+		return std::make_tuple(object.bytecode->bytecode, *object.sourceMappings, object.assembly);
+	};
+
+	auto uncached = assemble(nullptr);
+	auto cache = std::make_shared<OptimizedObjectCache>();
+	BOOST_CHECK(assemble(cache) == uncached);
+	BOOST_CHECK_EQUAL(cache->numAssemblies(), 2);
+	// Now "B" is taken from the cache, together with its sub-assembly. The reference to
+	// "B.B_deployed" has to point into the cached assembly.
+	BOOST_CHECK(assemble(cache) == uncached);
+	BOOST_CHECK_EQUAL(cache->numAssemblies(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(optimized_object_cache_bypassed_while_profiling)
+{
+	std::string source = R"(
+		/// @use-src 0:"source"
+		object "B" {
+			code { sstore(0, add(calldataload(0), 1)) }
+			/// @use-src 0:"source"
+			object "B_deployed" {
+				code { let x := calldataload(0) sstore(x, mul(x, 2)) }
+			}
+		}
+	)";
+	auto cache = std::make_shared<OptimizedObjectCache>();
+	auto profile = [&]() {
+		solidity::util::StepProfile yulProfile;
+		YulStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion(),
+			YulStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::standard(),
+			DebugInfoSelection::All(),
+			cache
+		);
+		asmStack.setOptimiserProfiles(&yulProfile, nullptr);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", source));
+		asmStack.optimize();
+		size_t invocations = 0;
+		for (auto const& [step, statistics]: yulProfile)
+			invocations += statistics.invocations;
+		return invocations;
+	};
+
+	size_t invocations = profile();
+	BOOST_CHECK(invocations > 0);
+	// Both stacks run all steps themselves instead of sharing the result.
+	BOOST_CHECK_EQUAL(profile(), invocations);
+	BOOST_CHECK_EQUAL(cache->size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(use_src_empty)
 {
 	auto const [mapping, _] = tryGetSourceLocationMapping("");
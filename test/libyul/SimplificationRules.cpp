@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for matching Yul simplification rules.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/SimplificationRules.h>
+
+#include <liblangutil/ErrorReporter.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+EVMDialect const& evmDialect()
+{
+	static EVMDialect const dialect{EVMVersion{}, true};
+	return dialect;
+}
+
+std::shared_ptr<Block> parseCode(std::string const& _source)
+{
+	ErrorList errors;
+	auto [object, analysisInfo] = yul::test::parse(_source, evmDialect(), errors);
+	BOOST_REQUIRE(object && errors.empty() && object->code);
+	return object->code;
+}
+
+/// @returns the arguments of the call in the first statement of @a _block.
+std::vector<Expression> const& callArguments(Block const& _block)
+{
+	return std::get<FunctionCall>(std::get<ExpressionStatement>(_block.statements.front()).expression).arguments;
+}
+
+/// @returns the value of the literal the matched expression is replaced with.
+u256 simplifiedValue(SimplificationRules::Match const& _match)
+{
+	Expression replacement = _match.replacement(nullptr, EVMVersion{});
+	BOOST_REQUIRE(std::holds_alternative<Literal>(replacement));
+	return std::get<Literal>(replacement).value.value();
+}
+
+AssignedValue const* noSSAValues(YulName)
+{
+	return nullptr;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulSimplificationRules, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(no_match)
+{
+	std::shared_ptr<Block> ast = parseCode("{ sstore(calldataload(0), add(calldataload(1), calldataload(2))) }");
+	for (Expression const& argument: callArguments(*ast))
+		BOOST_CHECK(!SimplificationRules::findFirstMatch(argument, evmDialect(), noSSAValues));
+}
+
+BOOST_AUTO_TEST_CASE(matches_keep_their_match_groups)
+{
+	std::shared_ptr<Block> ast = parseCode("{ sstore(add(1, 2), mul(3, 4)) }");
+	std::vector<Expression> const& arguments = callArguments(*ast);
+
+	auto sum = SimplificationRules::findFirstMatch(arguments[0], evmDialect(), noSSAValues);
+	auto product = SimplificationRules::findFirstMatch(arguments[1], evmDialect(), noSSAValues);
+	BOOST_REQUIRE(sum && product);
+	BOOST_CHECK(sum->rule != product->rule);
+	// Finding the second match does not overwrite the expressions bound by the first one.
+	BOOST_CHECK_EQUAL(simplifiedValue(*sum), 3);
+	BOOST_CHECK_EQUAL(simplifiedValue(*product), 12);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_matches)
+{
+	size_t const threadCount = 4;
+	std::vector<std::shared_ptr<Block>> asts;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		asts.emplace_back(parseCode("{ sstore(0, add(" + std::to_string(thread) + ", 100)) }"));
+
+	// Boost.Test assertions are not thread-safe, so they are only used outside of the threads.
+	for (size_t thread = 0; thread < threadCount; ++thread)
+	{
+		auto match = SimplificationRules::findFirstMatch(callArguments(*asts[thread])[1], evmDialect(), noSSAValues);
+		BOOST_REQUIRE(match);
+		BOOST_CHECK_EQUAL(simplifiedValue(*match), thread + 100);
+	}
+
+	// One element per thread. Unlike std::vector<bool>, the elements do not share memory.
+	std::vector<char> correct(threadCount, true);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		threads.emplace_back([&, thread]() {
+			Expression const& expression = callArguments(*asts[thread])[1];
+			for (size_t i = 0; i < 1000; ++i)
+			{
+				auto match = SimplificationRules::findFirstMatch(expression, evmDialect(), noSSAValues);
+				if (!match)
+				{
+					correct[thread] = false;
+					return;
+				}
+				Expression replacement = match->replacement(nullptr, EVMVersion{});
+				if (
+					!std::holds_alternative<Literal>(replacement) ||
+					std::get<Literal>(replacement).value.value() != thread + 100
+				)
+					correct[thread] = false;
+			}
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		BOOST_CHECK(correct[thread]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
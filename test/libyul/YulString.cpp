@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a("abc");
+	YulString b(std::string("ab") + "c");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(&a.str() == &b.str());
+	BOOST_CHECK(a != YulString("abd"));
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString("") == YulString());
+
+	std::string const longName = "usr$abi_encode_tuple_t_struct$_Order_$42_memory_ptr__to_t_struct$_Order_$42_memory_ptr__fromStack";
+	BOOST_CHECK(YulString(longName) == YulString(longName));
+	BOOST_CHECK(YulString(longName) != YulString(longName + "_"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 8;
+	size_t const nameCount = 2000;
+	std::vector<std::vector<YulString>> names(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		threads.emplace_back([&, thread]() {
+			for (size_t i = 0; i < nameCount; ++i)
+				names[thread].emplace_back("name_" + std::to_string((i * (thread + 1)) % nameCount));
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		for (size_t i = 0; i < nameCount; ++i)
+		{
+			YulString const& name = names[thread][i];
+			BOOST_CHECK_EQUAL(name.str(), "name_" + std::to_string((i * (thread + 1)) % nameCount));
+			BOOST_CHECK(name == YulString(name.str()));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(compilations_have_separate_repositories)
+{
+	std::string const content = "compilations_have_separate_repositories";
+	YulString const global(content);
+	{
+		YulStringRepository::CompilationScope scope;
+		YulString name(content);
+		BOOST_CHECK(&name.str() != &global.str());
+		{
+			// A nested scope continues the compilation.
+			YulStringRepository::CompilationScope nestedScope;
+			BOOST_CHECK(name == YulString(content));
+		}
+		auto repository = YulStringRepository::currentCompilation();
+		std::thread([&]() {
+			// Another thread starts a compilation of its own and resets it.
+			{
+				YulStringRepository::CompilationScope otherScope;
+				YulString other(content);
+				BOOST_CHECK(&other.str() != &name.str());
+				YulStringRepository::reset();
+			}
+			// Worker threads join the compilation explicitly.
+			YulStringRepository::CompilationScope workerScope(repository);
+			BOOST_CHECK(name == YulString(content));
+		}).join();
+		BOOST_CHECK_EQUAL(name.str(), content);
+		BOOST_CHECK(name == YulString(content));
+	}
+	BOOST_CHECK(YulStringRepository::currentCompilation() == nullptr);
+	BOOST_CHECK(global == YulString(content));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -10,6 +10,8 @@ import os
 import re
 import subprocess
 import sys
+import tempfile
+import time
 import traceback
 from collections import namedtuple
 from copy import deepcopy
@@ -1423,6 +1425,73 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(last_report['diagnostics']), 0, "no diagnostics")
 
 
+    def test_analyze_project_file_rewritten_with_same_size_and_time(self, solc: JsonRpcProcess) -> None:
+        """
+        Project files are only read again from disk if their modification time or size changed.
+        Here, a file is rewritten with the same size and modification time and we expect the
+        change to be picked up anyway: if the file was modified no earlier than it was last read,
+        or if the client reports the change via workspace/didChangeWatchedFiles.
+        """
+        VALID = (
+            '// SPDX-License-Identifier: UNLICENSED\n'
+            'pragma solidity >=0.8.0;\n'
+            'contract A { }\n'
+        )
+        INVALID = VALID.replace('{ }', '{ ]')
+
+        with tempfile.TemporaryDirectory(dir=self.project_root_dir) as project_dir:
+            SUBDIR = os.path.basename(project_dir)
+            FILE_A_PATH = f'{project_dir}/A.sol'
+            FILE_A_URI = self.get_test_file_uri('A', SUBDIR)
+            FILE_B_URI = self.get_test_file_uri('B', SUBDIR)
+
+            def write_file_a(content, modification_time):
+                with open(FILE_A_PATH, mode='w', encoding='utf-8', newline='') as f:
+                    f.write(content)
+                os.utime(FILE_A_PATH, (modification_time, modification_time))
+
+            def expect_diagnostics_for_file_a(reports, codes, description):
+                self.expect_equal(reports[0]['uri'], FILE_A_URI, "Correct file URI")
+                self.expect_equal([diagnostic['code'] for diagnostic in reports[0]['diagnostics']], codes, description)
+
+            # A modification time in the future is never before the time the file is read.
+            future = time.time() + 3600
+            write_file_a(VALID, future)
+            self.setup_lsp(solc, file_load_strategy=FileLoadStrategy.ProjectDirectory, project_root_subdir=SUBDIR)
+            reports = self.wait_for_diagnostics(solc)
+            self.expect_equal(len(reports), 1, "Diagnostic reports for 1 file")
+            expect_diagnostics_for_file_a(reports, [], "no diagnostics")
+
+            write_file_a(INVALID, future)
+            solc.send_message('textDocument/didOpen', {
+                'textDocument': {
+                    'uri': FILE_B_URI,
+                    'languageId': 'Solidity',
+                    'version': 1,
+                    'text': VALID.replace('A', 'B')
+                }
+            })
+            reports = self.wait_for_diagnostics(solc)
+            self.expect_equal(len(reports), 2, "Diagnostic reports for 2 files")
+            expect_diagnostics_for_file_a(reports, [2314], "modified file read again")
+
+            # With a modification time in the past, the content is only read again after a notification.
+            past = time.time() - 3600
+            write_file_a(VALID, past)
+            solc.send_message('textDocument/didChange', {
+                'textDocument': {'uri': FILE_B_URI, 'version': 2},
+                'contentChanges': [{'text': VALID.replace('A', 'B') + '\n'}]
+            })
+            reports = self.wait_for_diagnostics(solc)
+            expect_diagnostics_for_file_a(reports, [], "file with new modification time read again")
+
+            write_file_a(INVALID, past)
+            solc.send_message('workspace/didChangeWatchedFiles', {
+                'changes': [{'uri': FILE_A_URI, 'type': 2}]
+            })
+            reports = self.wait_for_diagnostics(solc)
+            expect_diagnostics_for_file_a(reports, [2314], "reported file read again")
+
     def test_publish_diagnostics_errors_multiline(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc)
         TEST_NAME = 'publish_diagnostics_3'
@@ -1610,6 +1679,63 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report['diagnostics']), 0)
         # The warning went away because the compiler aborts further processing after the error.
 
+    def test_didChange_only_analyzes_files_importing_the_changed_one(self, solc: JsonRpcProcess) -> None:
+        """
+        Only the changed file and the files importing it are analyzed again. The other files keep their
+        diagnostics, and requests on them are answered from the analysis they were part of last.
+        """
+        self.setup_lsp(solc)
+        LIB_URI = f'{self.project_root_uri}/closure_lib.sol'
+        A_URI = f'{self.project_root_uri}/closure_a.sol'
+        B_URI = f'{self.project_root_uri}/closure_b.sol'
+        HEADER = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+        FILES = {
+            LIB_URI: HEADER + 'function g() pure returns (uint) { return 1; }\n',
+            A_URI: HEADER + 'import "./closure_lib.sol";\ncontract A { function f() public pure returns (uint) { return g(); } }\n',
+            B_URI: HEADER + 'import "./closure_lib.sol";\ncontract B { function f() public pure returns (uint) { uint x; return g(); } }\n',
+        }
+        for uri, content in FILES.items():
+            solc.send_message('textDocument/didOpen', {
+                'textDocument': {'uri': uri, 'languageId': 'Solidity', 'version': 1, 'text': content}
+            })
+            self.wait_for_diagnostics(solc)
+
+        # Neither the library nor B import A.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': A_URI, 'version': 2},
+            'contentChanges': [{
+                'range': {'start': {'line': 0, 'character': 0}, 'end': {'line': 0, 'character': 0}},
+                'text': '\n'
+            }]
+        })
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal([report['uri'] for report in reports], sorted(FILES.keys()), "reports for all files")
+        diagnostics = {report['uri']: report['diagnostics'] for report in reports}
+        self.expect_equal(len(diagnostics[A_URI]), 0, "no diagnostics in A")
+        self.expect_equal(len(diagnostics[LIB_URI]), 0, "no diagnostics in the library")
+        self.expect_equal(len(diagnostics[B_URI]), 1, "unused variable in B")
+        self.expect_equal(diagnostics[B_URI][0]['code'], 2072, "unused variable in B")
+
+        call_column = FILES[B_URI].splitlines()[3].index('g()')
+        response = solc.call_method('textDocument/definition', {
+            'textDocument': {'uri': B_URI},
+            'position': {'line': 3, 'character': call_column}
+        })
+        self.expect_equal(len(response['result']), 1, "Goto definition of g")
+        self.expect_location(response['result'][0], LIB_URI, 2, (9, 10))
+
+        # A was analyzed separately from the library and B, but its call is renamed as well.
+        response = solc.call_method('textDocument/rename', {
+            'textDocument': {'uri': LIB_URI},
+            'position': {'line': 2, 'character': 9},
+            'newName': 'h'
+        })
+        changes = response['result']['changes']
+        self.expect_equal(sorted(changes.keys()), sorted(FILES.keys()), "changes in all files")
+        for uri, line in ((LIB_URI, 2), (A_URI, 4), (B_URI, 3)):
+            self.expect_equal(len(changes[uri]), 1, "one change per file")
+            self.expect_equal(changes[uri][0]['range']['start']['line'], line, "renamed line")
+
     def test_textDocument_didOpen_with_relative_import_without_project_url(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc, expose_project_root=False)
         TEST_NAME = 'didOpen_with_import'
@@ -1871,6 +1997,102 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(reports[0]['uri'], f'{self.project_root_uri}/goto/lib.sol', "")
         self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
 
+    def test_requests_are_answered_from_last_completed_analysis(self, solc: JsonRpcProcess) -> None:
+        """
+        Diagnostics are only updated once no further edits arrive for a while and the analysis
+        runs in the background. Requests that refer to positions are answered right away, based on
+        the last completed analysis, unless the file was not analyzed at all yet.
+        Rename requests always wait for the pending analysis, since the client applies the
+        returned edits to its current buffer.
+        Here, two lines are inserted at the top of the file right before a request.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = f'{self.project_root_uri}/a.sol'
+        OTHER_FILE_URI = f'{self.project_root_uri}/b.sol'
+        CONTENT = (
+            '// SPDX-License-Identifier: UNLICENSED\n'
+            'pragma solidity >=0.8.0;\n'
+            'contract C {\n'
+            '    function f() public pure returns (uint) { return g(); }\n'
+            '    function g() public pure returns (uint) { return 1; }\n'
+            '}\n'
+        )
+        CALL_COLUMN = CONTENT.splitlines()[3].index('g()')
+
+        def open_file(uri):
+            solc.send_message('textDocument/didOpen', {
+                'textDocument': {
+                    'uri': uri,
+                    'languageId': 'Solidity',
+                    'version': 1,
+                    'text': CONTENT
+                }
+            })
+
+        def goto_g(line):
+            solc.send_message('textDocument/definition', {
+                'textDocument': {'uri': FILE_URI},
+                'position': {'line': line, 'character': CALL_COLUMN}
+            })
+
+        open_file(FILE_URI)
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
+        tokens_before = solc.call_method('textDocument/semanticTokens/full', {'textDocument': {'uri': FILE_URI}})
+
+        # The request is answered before the edit is analyzed, so it refers to the previous content.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': FILE_URI, 'version': 2},
+            'contentChanges': [{
+                'range': {'start': {'line': 0, 'character': 0}, 'end': {'line': 0, 'character': 0}},
+                'text': '\n\n'
+            }]
+        })
+        goto_g(3)
+        response = solc.receive_message()
+        self.expect_equal(len(response['result']), 1, "Goto definition of g")
+        self.expect_location(response['result'][0], FILE_URI, 4, (13, 14))
+
+        self.wait_for_diagnostics(solc)
+        goto_g(3 + 2)
+        response = solc.receive_message()
+        self.expect_equal(len(response['result']), 1, "Goto definition of g")
+        self.expect_location(response['result'][0], FILE_URI, 4 + 2, (13, 14))
+
+        # A file that was not analyzed yet is answered once the analysis completed.
+        open_file(OTHER_FILE_URI)
+        solc.send_message('textDocument/semanticTokens/full', {'textDocument': {'uri': OTHER_FILE_URI}})
+        self.wait_for_diagnostics(solc)
+        tokens_other = solc.receive_message()
+        self.expect_equal(tokens_other['result']['data'], tokens_before['result']['data'], "same tokens")
+
+        tokens_after = solc.call_method('textDocument/semanticTokens/full', {'textDocument': {'uri': FILE_URI}})
+        # Tokens are encoded relative to the previous one, so only the line of the first token changes.
+        self.expect_equal(tokens_after['result']['data'][0], tokens_before['result']['data'][0] + 2, "first token moved")
+        self.expect_equal(tokens_after['result']['data'][1:], tokens_before['result']['data'][1:], "other tokens unchanged")
+
+        # The rename is answered only after the edit was analyzed, so the edits refer to the new content.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': FILE_URI, 'version': 3},
+            'contentChanges': [{
+                'range': {'start': {'line': 0, 'character': 0}, 'end': {'line': 0, 'character': 0}},
+                'text': '\n\n'
+            }]
+        })
+        solc.send_message('textDocument/rename', {
+            'textDocument': {'uri': FILE_URI},
+            'position': {'line': 3 + 4, 'character': CALL_COLUMN},
+            'newName': 'h'
+        })
+        self.wait_for_diagnostics(solc)
+        response = solc.receive_message()
+        changes = response['result']['changes'][FILE_URI]
+        self.expect_equal(
+            sorted(change['range']['start']['line'] for change in changes),
+            [3 + 4, 4 + 4],
+            "renamed lines"
+        )
+
     def test_textDocument_didChange_at_eol(self, solc: JsonRpcProcess) -> None:
         """
         Append at one line and insert a new one below.
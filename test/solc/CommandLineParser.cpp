@@ -120,6 +120,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -131,6 +132,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
+			"--optimizer-profile",
 			"--gas",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
@@ -149,6 +151,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--model-checker-invariants=contract,reentrancy",
 			"--model-checker-show-proved-safe",
 			"--model-checker-show-unproved",
+			"--model-checker-show-timings",
+			"--model-checker-verify-agreement",
+			"--model-checker-persistent-solvers",
+			"--model-checker-cache-dir=/tmp/smt-cache",
 			"--model-checker-show-unsupported",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
@@ -179,6 +185,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.jobs = 4;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -192,7 +199,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true,
+			true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -220,9 +227,13 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true,
 			true,
 			true,
+			true,
 			{false, false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
+			true, // --model-checker-verify-agreement
+			true, // --model-checker-persistent-solvers
+			"/tmp/smt-cache",
 		};
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
@@ -266,6 +277,27 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(jobs_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.jobs == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=8", "contract.sol"}).output.jobs == 8);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--jobs=0", "contract.sol"}), CommandLineValidationError);
+}
+
+BOOST_AUTO_TEST_CASE(empty_cache_directories)
+{
+	for (std::string cacheDirOption: {"--cache-dir", "--model-checker-cache-dir"})
+	{
+		std::string expectedMessage = "Empty path given to " + cacheDirOption + ".";
+		auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+		BOOST_CHECK_EXCEPTION(
+			parseCommandLine({"solc", "--standard-json", cacheDirOption + "=", "input.json"}),
+			CommandLineValidationError,
+			hasCorrectMessage
+		);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static std::vector<std::tuple<std::vector<std::string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -380,6 +412,8 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 		"--ignore-missing",
 		"--output-dir=/tmp/out",           // Accepted but has no effect in Standard JSON mode
 		"--overwrite",                     // Accepted but has no effect in Standard JSON mode
+		"--cache-dir=/tmp/cache",
+		"--model-checker-cache-dir=/tmp/smt-cache",
 		"--evm-version=spuriousDragon",    // Ignored in Standard JSON mode
 		"--revert-strings=strip",          // Accepted but has no effect in Standard JSON mode
 		"--pretty-json",
@@ -403,7 +437,9 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.input.ignoreMissingFiles = true;
 	expectedOptions.output.dir = "/tmp/out";
 	expectedOptions.output.overwriteFiles = true;
+	expectedOptions.output.cacheDir = "/tmp/cache";
 	expectedOptions.output.revertStrings = RevertStrings::Strip;
+	expectedOptions.modelChecker.settings.cacheDirectory = "/tmp/smt-cache";
 	expectedOptions.formatting.json = JsonFormat {JsonFormat::Pretty, 1};
 	expectedOptions.formatting.coloredOutput = false;
 	expectedOptions.formatting.withErrorIds = true;
@@ -423,9 +459,15 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--cache-dir=/tmp/cache", {"--assemble", "--yul", "--strict-assembly", "--link"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-show-timings", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-verify-agreement", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-persistent-solvers", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-cache-dir=/tmp/smt-cache", {"--assemble", "--yul", "--strict-assembly", "--link"}},
 		{"--model-checker-show-unproved", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unsupported", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},